@@ -3,5 +3,9 @@
 
 #include "bits/find.h"
 #include "bits/algorithm.h"
+#include "bits/result_algorithm.h"
+#include "bits/lookup.h"
+#include "bits/partition.h"
+#include "bits/sort.h"
 
 #endif
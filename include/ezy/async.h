@@ -0,0 +1,398 @@
+#ifndef EZY_ASYNC_H_INCLUDED
+#define EZY_ASYNC_H_INCLUDED
+
+#include "bits/algorithm.h" // deduce_keeper_t
+#include "bits/bounds_policy.h"
+#include "experimental/keeper.h"
+#include "range.h"
+
+#include <algorithm> // max
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <exception>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+/**
+ * async(range, queue_capacity) -> async_view
+ *
+ * Pipeline stage: the range (the upstream part of the pipeline) is iterated through on a worker thread, and
+ * its elements are handed to the thread iterating the view through a bounded queue. So a slow source (eg.
+ * decoding) and the downstream stages (eg. parsing, aggregation) overlap:
+ *
+ *   ezy::accumulate(ezy::transform(ezy::async(ezy::transform(lines, decode), 1024), parse), stats{}, merge);
+ *
+ * - The worker starts at the first begin() of the view, and stops when the view is destroyed, even if the
+ *   range was not consumed.
+ * - If the queue is full, the worker waits (backpressure), if it is empty, the consumer waits.
+ * - The elements are published in batches (a quarter of the capacity), so the threads touch the shared
+ *   indices rarely. The consumer does not see a batch until it is complete, or the queue is full, or the
+ *   range ended.
+ * - An exception thrown by the range is rethrown on the consumer thread, after the elements before it.
+ * - The elements are copied (or moved, if the range gives rvalues) into the queue. The view is single pass,
+ *   its elements can be moved out.
+ *
+ * The range must not be used by other threads meanwhile.
+ */
+
+namespace ezy
+{
+  namespace detail
+  {
+    // waits for a condition of the other thread: spins a bit, then gives up the time slice, then sleeps (if
+    // the other side is slow, eg. it waits for I/O)
+    template <typename Condition>
+    void wait_until(Condition&& condition)
+    {
+      for (unsigned spins = 0; !condition(); ++spins)
+      {
+        if (spins >= 1024)
+          std::this_thread::sleep_for(std::chrono::microseconds(50));
+        else if (spins >= 64)
+          std::this_thread::yield();
+      }
+    }
+
+    /**
+     * spsc_ring: lock-free single producer, single consumer queue of a fixed capacity (rounded up to a power
+     * of two). Both sides work on their private indices, and publish them (to the shared atomic ones) once
+     * per batch.
+     */
+    template <typename T>
+    class spsc_ring
+    {
+      public:
+        explicit spsc_ring(std::size_t capacity)
+          : mask(round_up_to_power_of_two(capacity) - 1)
+          , batch(std::max<std::size_t>(1, (mask + 1) / 4))
+          , slots(std::make_unique<slot[]>(mask + 1))
+        {}
+
+        spsc_ring(const spsc_ring&) = delete;
+        spsc_ring& operator=(const spsc_ring&) = delete;
+
+        ~spsc_ring()
+        {
+          for (std::size_t i = consumer.index; i != producer.index; ++i)
+            element(i)->~T();
+        }
+
+        std::size_t capacity() const noexcept
+        {
+          return mask + 1;
+        }
+
+        // producer: constructs the element, if the queue is not full
+        template <typename U>
+        bool try_push(U&& value)
+        {
+          if (producer.index - producer.cached_other == capacity())
+          {
+            producer.cached_other = read_index.load(std::memory_order_acquire);
+            if (producer.index - producer.cached_other == capacity())
+              return false;
+          }
+
+          ::new (static_cast<void*>(element(producer.index))) T(std::forward<U>(value));
+          ++producer.index;
+          if (producer.index - producer.published == batch)
+            publish();
+          return true;
+        }
+
+        // producer: true if no element can be pushed
+        bool full() noexcept
+        {
+          producer.cached_other = read_index.load(std::memory_order_acquire);
+          return producer.index - producer.cached_other == capacity();
+        }
+
+        // producer: makes the pushed elements visible to the consumer
+        void publish() noexcept
+        {
+          producer.published = producer.index;
+          write_index.store(producer.index, std::memory_order_release);
+        }
+
+        // consumer: the first element, or nullptr if there is no published element
+        T* front() noexcept
+        {
+          if (consumer.index == consumer.cached_other)
+          {
+            release();
+            consumer.cached_other = write_index.load(std::memory_order_acquire);
+            if (consumer.index == consumer.cached_other)
+              return nullptr;
+          }
+          return element(consumer.index);
+        }
+
+        // consumer: destroys the first element, expects: front() != nullptr
+        void pop() noexcept
+        {
+          element(consumer.index)->~T();
+          ++consumer.index;
+          if (consumer.index - consumer.published == batch)
+            release();
+        }
+
+      private:
+        using slot = std::aligned_storage_t<sizeof(T), alignof(T)>;
+
+        // consumer: gives the popped slots back to the producer
+        void release() noexcept
+        {
+          consumer.published = consumer.index;
+          read_index.store(consumer.index, std::memory_order_release);
+        }
+
+        T* element(std::size_t index) noexcept
+        {
+          return std::launder(reinterpret_cast<T*>(&slots[index & mask]));
+        }
+
+        static std::size_t round_up_to_power_of_two(std::size_t n) noexcept
+        {
+          std::size_t result = 1;
+          while (result < n)
+            result *= 2;
+          return result;
+        }
+
+        // the private indices of a side, and the last seen index of the other side
+        struct alignas(64) side
+        {
+          std::size_t index{0};
+          std::size_t published{0};
+          std::size_t cached_other{0};
+        };
+
+        const std::size_t mask;
+        const std::size_t batch;
+        std::unique_ptr<slot[]> slots;
+
+        side producer;
+        side consumer;
+        alignas(64) std::atomic<std::size_t> write_index{0};
+        alignas(64) std::atomic<std::size_t> read_index{0};
+    };
+
+    template <typename Keeper>
+    class async_state
+    {
+      public:
+        using Range = ezy::experimental::keeper_value_type_t<Keeper>;
+        using value_type = value_type_of_reference_t<decltype(*std::begin(std::declval<Range&>()))>;
+
+        async_state(Keeper&& keeper, std::size_t capacity)
+          : keeper(std::move(keeper))
+          , queue(capacity)
+        {}
+
+        async_state(const async_state&) = delete;
+        async_state& operator=(const async_state&) = delete;
+
+        ~async_state()
+        {
+          stopped.store(true, std::memory_order_relaxed);
+          if (worker.joinable())
+            worker.join();
+        }
+
+        void start()
+        {
+          if (started)
+            return;
+
+          started = true;
+          worker = std::thread([this] { produce(); });
+          wait_for_next();
+        }
+
+        // consumer: waits until there is an element or the range ended
+        void wait_for_next()
+        {
+          wait_until([this]
+              {
+                if (queue.front() != nullptr)
+                  return true;
+
+                if (!finished.load(std::memory_order_acquire))
+                  return false;
+
+                // the last elements were published before finished was set
+                exhausted = (queue.front() == nullptr);
+                return true;
+              });
+
+          if (exhausted && error)
+            std::rethrow_exception(std::exchange(error, nullptr));
+        }
+
+        value_type& front() noexcept
+        {
+          return *queue.front();
+        }
+
+        void pop()
+        {
+          queue.pop();
+          wait_for_next();
+        }
+
+        bool at_end() const noexcept
+        {
+          return exhausted;
+        }
+
+      private:
+        void produce()
+        {
+#if defined(__cpp_exceptions) || defined(__EXCEPTIONS)
+          try
+          {
+            push_all();
+          }
+          catch (...)
+          {
+            error = std::current_exception();
+          }
+#else
+          push_all();
+#endif
+          queue.publish();
+          finished.store(true, std::memory_order_release);
+        }
+
+        void push_all()
+        {
+          for (auto&& element : keeper.get())
+          {
+            while (!queue.try_push(std::forward<decltype(element)>(element)))
+            {
+              queue.publish();
+              wait_until([this] { return stopped.load(std::memory_order_relaxed) || !queue.full(); });
+              if (stopped.load(std::memory_order_relaxed))
+                return;
+            }
+
+            if (stopped.load(std::memory_order_relaxed))
+              return;
+          }
+        }
+
+        Keeper keeper;
+        spsc_ring<value_type> queue;
+        std::atomic<bool> finished{false};
+        std::atomic<bool> stopped{false};
+        std::exception_ptr error; // written by the worker before finished
+        bool started{false};
+        bool exhausted{false};
+        std::thread worker;
+    };
+
+    template <typename State>
+    class async_iterator
+    {
+      public:
+        using difference_type = std::ptrdiff_t;
+        using value_type = typename State::value_type;
+        using reference = value_type&;
+        using pointer = value_type*;
+        using iterator_category = single_pass_iterator_tag;
+
+        async_iterator() = default;
+
+        explicit async_iterator(State* state) noexcept
+          : state(state)
+        {}
+
+        async_iterator& operator++()
+        {
+          state->pop();
+          return *this;
+        }
+
+        reference operator*() const noexcept
+        {
+          return state->front();
+        }
+
+        pointer operator->() const noexcept
+        {
+          return &state->front();
+        }
+
+        // every iterator is at the same position, they only differ in being at the end or not
+        bool operator==(const async_iterator& rhs) const noexcept
+        {
+          return at_end() == rhs.at_end();
+        }
+
+        bool operator!=(const async_iterator& rhs) const noexcept
+        {
+          return !(*this == rhs);
+        }
+
+      private:
+        bool at_end() const noexcept
+        {
+          return state == nullptr || state->at_end();
+        }
+
+        State* state{nullptr};
+    };
+
+    template <typename Keeper>
+    class async_view
+    {
+      public:
+        using State = async_state<Keeper>;
+        using iterator = async_iterator<State>;
+        using const_iterator = iterator;
+        using value_type = typename State::value_type;
+        using size_type = std::size_t;
+
+        async_view(Keeper&& keeper, std::size_t queue_capacity)
+          : state(std::make_unique<State>(std::move(keeper), queue_capacity))
+        {}
+
+        // starts the worker on the first call, then returns the current position
+        iterator begin() const
+        {
+          if (!state)
+            return end();
+
+          state->start();
+          return iterator{state.get()};
+        }
+
+        iterator end() const noexcept
+        {
+          return iterator{};
+        }
+
+      private:
+        // on the heap, so the view can be moved while the worker refers to the state
+        std::unique_ptr<State> state;
+    };
+  }
+
+  template <typename Range, typename BoundsPolicy = bounds::default_t>
+  auto async(Range&& range, std::size_t queue_capacity, BoundsPolicy policy = {})
+  {
+    using ResultRange = detail::async_view<detail::deduce_keeper_t<Range>>;
+    return detail::make_bounded_view(policy, queue_capacity > 0, bounds_error::zero_capacity, "async: zero capacity",
+        [&](bool valid)
+        {
+          return ResultRange(ezy::experimental::make_keeper(std::forward<Range>(range)), valid ? queue_capacity : 1);
+        });
+  }
+}
+
+#endif
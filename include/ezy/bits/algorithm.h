@@ -4,28 +4,62 @@
 #include <ezy/experimental/keeper.h>
 #include <ezy/range.h>
 
+#include "bounds_policy.h"
 #include "empty_size.h"
+#include "simd_find.h"
 
 #include <numeric> // accumulate
 #include <algorithm>
+#include <array>
 
 namespace ezy
 {
   namespace detail
   {
+    // the same as the keeper made by make_keeper, so keepers can be used as ranges
     template <typename Range>
-    using deduce_keeper_t = ezy::experimental::keeper<
-      ezy::experimental::detail::ownership_category_t<Range>,
-      std::remove_reference_t<Range>
-    >;
+    using deduce_keeper_t = ezy::experimental::detail::infer_keeper_t<Range>;
+
+    // polyfills of <algorithm>, those are constexpr only from c++20
+    template <typename ItFirst, typename ItLast, typename UnaryFunction>
+    constexpr UnaryFunction for_each(ItFirst first, ItLast last, UnaryFunction fn)
+    {
+      for (; first != last; ++first)
+      {
+        fn(*first);
+      }
+      return fn;
+    }
+
+    template <typename ItFirst, typename ItLast, typename Predicate>
+    constexpr ItFirst find_if(ItFirst first, ItLast last, Predicate pred)
+    {
+      for (; first != last; ++first)
+      {
+        if (pred(*first))
+          break;
+      }
+      return first;
+    }
+
+    template <typename ItFirst, typename ItLast, typename T>
+    constexpr ItFirst find(ItFirst first, ItLast last, const T& value)
+    {
+      for (; first != last; ++first)
+      {
+        if (*first == value)
+          break;
+      }
+      return first;
+    }
   }
 
   template <typename Range, typename UnaryFunction>
-  /*constexpr?*/ decltype(auto) for_each(Range&& range, UnaryFunction&& fn)
+  constexpr decltype(auto) for_each(Range&& range, UnaryFunction&& fn)
   {
     using std::begin;
     using std::end;
-    return std::for_each(begin(range), end(range), std::forward<UnaryFunction>(fn));
+    return detail::for_each(begin(range), end(range), std::forward<UnaryFunction>(fn));
   }
 
   template <typename Range, typename UnaryFunction>
@@ -39,7 +73,7 @@ namespace ezy
   }
 
   template <typename Range, typename Predicate>
-  /*constexpr*/ auto filter(Range&& range, Predicate&& pred)
+  constexpr auto filter(Range&& range, Predicate&& pred)
   {
     using result_range_type = detail::range_view_filter<detail::deduce_keeper_t<Range>, Predicate>;
     return result_range_type{
@@ -49,7 +83,7 @@ namespace ezy
   }
 
   template <typename Range1, typename Range2>
-  /*constexpr*/ auto concatenate(Range1&& range1, Range2&& range2)
+  constexpr auto concatenate(Range1&& range1, Range2&& range2)
   {
 
     using ResultRangeType = detail::concatenated_range_view<
@@ -85,19 +119,34 @@ namespace ezy
 
   inline constexpr forward_as_tuple_fn forward_as_tuple{};
 
+  /**
+   * capture_as_tuple: lvalues are referred, while rvalues are moved into the tuple (unlike forward_as_tuple,
+   * which would refer to them), so it is safe to use with ranges which produce temporaries (eg. transform).
+   */
+  struct capture_as_tuple_fn
+  {
+    template <typename... Args>
+    constexpr auto operator()(Args&&... args) const
+    {
+      return std::tuple<Args...>(std::forward<Args>(args)...);
+    }
+  };
+
+  inline constexpr capture_as_tuple_fn capture_as_tuple{};
+
 
   template <typename... Ranges>
   constexpr auto zip(Ranges&&... ranges)
   {
-    using ResultRangeType = detail::zip_range_view<make_tuple_fn, detail::deduce_keeper_t<Ranges>... >;
+    using ResultRangeType = detail::zip_range_view<capture_as_tuple_fn, detail::deduce_keeper_t<Ranges>... >;
     return ResultRangeType{
-      make_tuple,
+      capture_as_tuple,
       ezy::experimental::make_keeper(std::forward<Ranges>(ranges))...
     };
   }
 
   template <typename Zipper, typename... Ranges>
-  /*constexpr*/ auto zip_with(Zipper&& zipper, Ranges&&... ranges)
+  constexpr auto zip_with(Zipper&& zipper, Ranges&&... ranges)
   {
     using ResultRangeType = detail::zip_range_view<Zipper, typename detail::deduce_keeper_t<Ranges>... >;
     return ResultRangeType{
@@ -106,15 +155,19 @@ namespace ezy
     };
   }
 
-  template <typename Range>
-  /*constexpr*/ auto slice(Range&& range, unsigned int from, unsigned int until) // TODO check size_type
+  template <typename Range, typename BoundsPolicy = bounds::default_t>
+  constexpr auto slice(Range&& range, unsigned int from, unsigned int until, BoundsPolicy policy = {}) // TODO check size_type
   {
     using ResultRangeType = detail::range_view_slice<detail::deduce_keeper_t<Range>>;
-    return ResultRangeType{
-      ezy::experimental::make_keeper(std::forward<Range>(range)),
-      from,
-      until
-    };
+    return detail::make_bounded_view(policy, from <= until, bounds_error::reversed_interval, "slice: from > until",
+        [&](bool valid)
+        {
+          return ResultRangeType{
+            ezy::experimental::make_keeper(std::forward<Range>(range)),
+            from,
+            valid ? until : from
+          };
+        });
   }
 
   template <typename Range>
@@ -128,7 +181,7 @@ namespace ezy
   }
 
   template <typename Range, typename Predicate>
-  /*constexpr*/ auto take_while(Range&& range, Predicate&& pred)
+  constexpr auto take_while(Range&& range, Predicate&& pred)
   {
     using ResultRangeType = detail::take_while_range_view<detail::deduce_keeper_t<Range>, ezy::remove_cvref_t<Predicate>>;
     return ResultRangeType{
@@ -146,17 +199,21 @@ namespace ezy
     };
   }
 
-  template <typename Range>
-  constexpr auto step_by(Range&& range, detail::size_type_t<Range> n)
+  template <typename Range, typename BoundsPolicy = bounds::default_t>
+  constexpr auto step_by(Range&& range, detail::size_type_t<Range> n, BoundsPolicy policy = {})
   {
     using ResultRange = detail::step_by_range_view<detail::deduce_keeper_t<Range>>;
-    return ResultRange{
-      ezy::experimental::make_keeper(std::forward<Range>(range)), n
-    };
+    return detail::make_bounded_view(policy, n > 0, bounds_error::zero_step, "step_by: zero step",
+        [&](bool valid)
+        {
+          return ResultRange{
+            ezy::experimental::make_keeper(std::forward<Range>(range)), valid ? n : 1
+          };
+        });
   }
 
   template <typename Range>
-  /*constexpr*/ auto flatten(Range&& range)
+  constexpr auto flatten(Range&& range)
   {
     using ResultRangeType = detail::flattened_range_view<detail::deduce_keeper_t<Range>>;
     return ResultRangeType{
@@ -167,19 +224,28 @@ namespace ezy
   template <typename Range, typename Predicate>
   constexpr bool all_of(Range&& range, Predicate&& predicate)
   {
-    return std::all_of(std::begin(range), std::end(range), std::forward<Predicate>(predicate));
+    using std::begin;
+    using std::end;
+    const auto last = end(range);
+    return detail::find_if(begin(range), last, [&predicate](auto&& e) { return !ezy::invoke(predicate, e); }) == last;
   }
 
   template <typename Range, typename Predicate>
   constexpr bool any_of(Range&& range, Predicate&& predicate)
   {
-    return std::any_of(std::begin(range), std::end(range), std::forward<Predicate>(predicate));
+    using std::begin;
+    using std::end;
+    const auto last = end(range);
+    return detail::find_if(begin(range), last, [&predicate](auto&& e) { return ezy::invoke(predicate, e); }) != last;
   }
 
   template <typename Range, typename Predicate>
   constexpr bool none_of(Range&& range, Predicate&& predicate)
   {
-    return std::none_of(std::begin(range), std::end(range), std::forward<Predicate>(predicate));
+    using std::begin;
+    using std::end;
+    const auto last = end(range);
+    return detail::find_if(begin(range), last, [&predicate](auto&& e) { return ezy::invoke(predicate, e); }) == last;
   }
 
   namespace detail
@@ -189,12 +255,23 @@ namespace ezy
     {
       using std::begin;
       using std::end;
-      return std::find(begin(range), end(range), std::forward<Needle>(needle));
+#ifdef EZY_HAS_IS_CONSTANT_EVALUATED
+      if constexpr (simd::is_vectorizable<Range, Needle>())
+      {
+        if (!__builtin_is_constant_evaluated())
+          return simd::find_any_in(range, needle);
+      }
+#endif
+      return detail::find(begin(range), end(range), needle);
     }
 
+    // only if find gives back an iterator (eg. not for std::string, whose find gives back an index)
     template <typename Range, typename Needle>
     constexpr auto find_element_impl(Range&& range, Needle&& needle, priority_tag<1>)
-      -> decltype(range.find(std::forward<Needle>(needle)))
+      -> std::enable_if_t<
+          std::is_convertible<decltype(range.find(std::forward<Needle>(needle))), decltype(std::end(range))>::value,
+          decltype(range.find(std::forward<Needle>(needle)))
+        >
     {
       return range.find(std::forward<Needle>(needle));
     }
@@ -211,8 +288,34 @@ namespace ezy
     return detail::find_element_impl(std::forward<Range>(range), std::forward<Needle>(needle), detail::priority_tag<1>{});
   }
 
+  /**
+   * find_any_of(range, needles...) -> iterator to the first element which is equal to any of the needles
+   *
+   * Contiguous ranges of integral types are searched by vectorized comparisons (see bits/simd_find.h).
+   */
+  template <typename Range, typename... Needles>
+  constexpr auto find_any_of(Range&& range, const Needles&... needles)
+  {
+    static_assert(sizeof...(Needles) > 0, "At least one needle is needed");
+    static_assert(std::is_same_v<
+        ezy::experimental::detail::ownership_category_t<Range>,
+        ezy::experimental::reference_category_tag
+        >, "Range must be a reference! Cannot form an iterator to a temporary!");
+
+    using std::begin;
+    using std::end;
+#ifdef EZY_HAS_IS_CONSTANT_EVALUATED
+    if constexpr (detail::simd::is_vectorizable<Range, Needles...>())
+    {
+      if (!__builtin_is_constant_evaluated())
+        return detail::simd::find_any_in(range, needles...);
+    }
+#endif
+    return detail::find_if(begin(range), end(range), [&needles...](const auto& e) { return (... || (e == needles)); });
+  }
+
   template <typename Range, typename Predicate>
-  /*constexpr*/ auto find_element_if(Range&& range, Predicate&& pred)
+  constexpr auto find_element_if(Range&& range, Predicate&& pred)
   {
     static_assert(std::is_same_v<
         ezy::experimental::detail::ownership_category_t<Range>,
@@ -221,7 +324,7 @@ namespace ezy
 
     using std::begin;
     using std::end;
-    return std::find_if(begin(range), end(range), std::forward<Predicate>(pred));
+    return detail::find_if(begin(range), end(range), std::forward<Predicate>(pred));
   }
 
   template <typename Range, typename Needle>
@@ -230,23 +333,159 @@ namespace ezy
     return find_element(range, needle) != end(range);
   }
 
+  namespace detail
+  {
+    template <typename T>
+    struct is_std_array : std::false_type {};
+
+    template <typename T, std::size_t N>
+    struct is_std_array<std::array<T, N>> : std::true_type {};
+
+    // true if the allocator of Container can be made from Allocator (eg. a memory resource for pmr containers)
+    template <typename Container, typename Allocator, typename = void>
+    struct is_allocator_for : std::false_type {};
+
+    template <typename Container, typename Allocator>
+    struct is_allocator_for<Container, Allocator, void_t<typename Container::allocator_type>>
+      : std::is_constructible<typename Container::allocator_type, const Allocator&> {};
+
+    template <typename Container, typename Allocator>
+    constexpr Container make_with_allocator(const Allocator& allocator)
+    {
+      return Container(typename Container::allocator_type(allocator));
+    }
+
+    template <typename Container, typename Value>
+    constexpr void insert_back(Container& container, Value&& value)
+    {
+      container.insert(container.end(), std::forward<Value>(value));
+    }
+
+    // copies the first elements of [first, last) into array, gives back the number of them
+    template <typename Array, typename Iterator, typename Sentinel>
+    constexpr std::size_t copy_prefix(Array& array, Iterator& first, const Sentinel& last)
+    {
+      std::size_t i = 0;
+      for (; i < array.size() && first != last; ++i, ++first)
+      {
+        array[i] = *first;
+      }
+      return i;
+    }
+
+    struct forward_fn
+    {
+      template <typename T>
+      constexpr T&& operator()(T&& t) const noexcept
+      {
+        return std::forward<T>(t);
+      }
+    };
+  }
+
+  /**
+   * collect_prefix<std::array<T, N>>(range) -> std::array<T, N>
+   *
+   * Fills the array with the first (at most N) elements of the range, the rest of it is value initialized.
+   * The range can be longer (or infinite), the remaining elements are not evaluated.
+   */
   template <typename Result, typename Range>
-  constexpr auto collect(Range&& range)
+  constexpr Result collect_prefix(Range&& range)
   {
-    using std::cbegin;
-    using std::cend;
-    return Result(cbegin(range), cend(range));
+    static_assert(detail::is_std_array<Result>::value, "collect_prefix: Result must be a std::array");
+    using std::begin;
+    using std::end;
+    Result result{};
+    auto first = begin(range);
+    detail::copy_prefix(result, first, end(range));
+    return result;
+  }
+
+  /**
+   * collect<Result>(range) -> Result
+   * collect<Result>(range, bounds policy) -> Result (or ezy::result<Result, bounds_error> with bounds::checked)
+   *
+   * Result is constructed from the iterators of the range, except for std::array (fixed capacity), which must
+   * get exactly as many elements as its size: otherwise it is a bounds error (bounds_error::size_mismatch), and
+   * the policy decides (throwing by default, which is a compile error in constant expressions). Clamping gives
+   * the array of collect_prefix. It can be used to make tables in constant expressions. See collect_prefix to
+   * take the first elements of a range of any size.
+   */
+  template <typename Result, typename Range, typename BoundsPolicy = bounds::default_t,
+           typename = std::enable_if_t<detail::is_bounds_policy<BoundsPolicy>::value>>
+  constexpr auto collect(Range&& range, BoundsPolicy policy = {})
+  {
+    if constexpr (detail::is_std_array<Result>::value)
+    {
+      using std::begin;
+      using std::end;
+      Result result{};
+      auto first = begin(range);
+      const auto last = end(range);
+      const bool valid = detail::copy_prefix(result, first, last) == result.size() && !(first != last);
+      return detail::make_bounded_view(policy, valid, bounds_error::size_mismatch,
+          "ezy::collect: the size of the range differs from the size of the std::array",
+          [&](bool) { return result; });
+    }
+    else
+    {
+      static_assert(std::is_same<BoundsPolicy, bounds::default_t>::value,
+          "collect: bounds policies apply to std::array only");
+      (void)policy;
+      using std::cbegin;
+      using std::cend;
+      return Result(cbegin(range), cend(range));
+    }
   }
 
   template <template <typename, typename ...> class ResultWrapper, typename Range>
   constexpr auto collect(Range&& range)
   {
     using std::begin;
-    using ElementType = ezy::remove_cvref_t<decltype(*begin(range))>;
+    using ElementType = detail::value_type_of_reference_t<decltype(*begin(range))>;
     return collect<ResultWrapper<ElementType>>(std::forward<Range>(range));
   }
 
-  template <typename Range, typename OutputIter>
+  /**
+   * collect<Result>(range, allocator) -> Result
+   *
+   * The same as collect, but the container uses the given allocator (or anything its allocator_type can be
+   * made of, eg. a std::pmr::memory_resource*), so the elements can be placed into an arena.
+   */
+  template <typename Result, typename Range, typename Allocator,
+           typename = std::enable_if_t<detail::is_allocator_for<Result, Allocator>::value>>
+  auto collect(Range&& range, const Allocator& allocator)
+  {
+    using std::cbegin;
+    using std::cend;
+    using allocator_type = typename Result::allocator_type;
+    if constexpr (std::is_constructible<Result,
+        decltype(cbegin(range)), decltype(cend(range)), const allocator_type&>::value)
+    {
+      return Result(cbegin(range), cend(range), allocator_type(allocator));
+    }
+    else
+    {
+      auto result = detail::make_with_allocator<Result>(allocator);
+      for (auto&& e : range)
+      {
+        detail::insert_back(result, std::forward<decltype(e)>(e));
+      }
+      return result;
+    }
+  }
+
+  template <template <typename, typename ...> class ResultWrapper, typename Range, typename Allocator,
+           typename = std::enable_if_t<detail::is_allocator_for<
+             ResultWrapper<detail::value_type_of_reference_t<decltype(*std::begin(std::declval<Range&>()))>>, Allocator
+           >::value>>
+  auto collect(Range&& range, const Allocator& allocator)
+  {
+    return collect<ResultWrapper<detail::value_type_t<Range>>>(std::forward<Range>(range), allocator);
+  }
+
+  template <typename Range, typename OutputIter,
+           typename = std::enable_if_t<!detail::is_bounds_policy<OutputIter>::value>>
   OutputIter collect(Range&& range, OutputIter out)
   {
     for (auto&& e : range)
@@ -290,6 +529,36 @@ namespace ezy
     return join<ValueType>(std::forward<Range>(range), std::forward<Separator>(separator));
   }
 
+  /**
+   * join<ReturnType>(range, separator, allocator) -> ReturnType
+   *
+   * The result is made with the given allocator (or anything its allocator_type can be made of).
+   */
+  template <typename ReturnType, typename Range, typename Separator, typename Allocator,
+           typename = std::enable_if_t<detail::is_allocator_for<ReturnType, Allocator>::value>>
+  ReturnType join(Range&& range, Separator&& separator, const Allocator& allocator)
+  {
+    auto result = detail::make_with_allocator<ReturnType>(allocator);
+    bool first = true;
+    for (const auto& e : range)
+    {
+      if (!first)
+        result += separator;
+
+      result += e;
+      first = false;
+    }
+    return result;
+  }
+
+  template <typename Range, typename Separator, typename Allocator,
+           typename = std::enable_if_t<detail::is_allocator_for<detail::value_type_t<Range>, Allocator>::value>>
+  auto join(Range&& range, Separator&& separator, const Allocator& allocator)
+  {
+    using ValueType = detail::value_type_t<Range>;
+    return join<ValueType>(std::forward<Range>(range), std::forward<Separator>(separator), allocator);
+  }
+
   template <typename T, typename Fn>
   constexpr auto iterate(T&& t, Fn&& fn)
   {
@@ -361,22 +630,26 @@ namespace ezy
   }
 
   template <typename Range, typename Init>
-  constexpr Init accumulate(Range&& range, Init&& init)
+  constexpr ezy::remove_cvref_t<Init> accumulate(Range&& range, Init&& init)
   {
     return detail::accumulate(std::begin(range), std::end(range), std::forward<Init>(init));
   }
 
   template <typename Range, typename Init, typename BinaryOp>
-  constexpr Init accumulate(Range&& range, Init&& init, BinaryOp&& op)
+  constexpr ezy::remove_cvref_t<Init> accumulate(Range&& range, Init&& init, BinaryOp&& op)
   {
     return detail::accumulate(std::begin(range), std::end(range), std::forward<Init>(init), std::forward<BinaryOp>(op));
   }
 
-  template <typename Range>
-  constexpr auto chunk(Range&& range, size_t chunk_size)
+  template <typename Range, typename BoundsPolicy = bounds::default_t>
+  constexpr auto chunk(Range&& range, size_t chunk_size, BoundsPolicy policy = {})
   {
     using ResultRange = detail::chunk_range_view<detail::deduce_keeper_t<Range>>;
-    return ResultRange{ezy::experimental::make_keeper(std::forward<Range>(range)), chunk_size};
+    return detail::make_bounded_view(policy, chunk_size > 0, bounds_error::zero_step, "chunk: zero size",
+        [&](bool valid)
+        {
+          return ResultRange{ezy::experimental::make_keeper(std::forward<Range>(range)), valid ? chunk_size : 1};
+        });
   }
 
   template <typename T>
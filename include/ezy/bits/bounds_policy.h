@@ -0,0 +1,116 @@
+#ifndef EZY_BITS_BOUNDS_POLICY_H_INCLUDED
+#define EZY_BITS_BOUNDS_POLICY_H_INCLUDED
+
+#include "empty_size.h" // always_false
+
+#include <cassert>
+#include <cstdlib> // abort
+#include <stdexcept> // logic_error
+#include <type_traits>
+
+namespace ezy
+{
+  enum class bounds_error
+  {
+    reversed_interval, // eg. slice(range, 4, 2)
+    zero_step, // eg. step_by(range, 0), chunk(range, 0)
+    size_mismatch, // eg. collect<std::array<int, 3>>(range of two elements)
+    zero_capacity, // eg. async(range, 0)
+    key_out_of_range // eg. bucketize(range, 2, [](int) { return 2; })
+  };
+
+  /**
+   * bounds policies: decide what a view factory does with invalid arguments.
+   *
+   * throwing: throws std::logic_error (aborts if exceptions are disabled)
+   * asserting: assert()s, then works as clamping (eg. if NDEBUG is defined)
+   * clamping: uses the nearest valid argument, slices become empty, steps become one
+   * checked: gives back ezy::result<View, bounds_error>, <ezy/result> must be included to use it (the views do
+   *   not depend on ezy::result, bits/checked_bounds.h defines the result for them)
+   *
+   * The default is throwing if exceptions are enabled, asserting otherwise.
+   */
+  namespace bounds
+  {
+    struct throwing_t {};
+    struct asserting_t {};
+    struct clamping_t {};
+    struct checked_t {};
+
+    inline constexpr throwing_t throwing{};
+    inline constexpr asserting_t asserting{};
+    inline constexpr clamping_t clamping{};
+    inline constexpr checked_t checked{};
+
+#if defined(__cpp_exceptions) || defined(__EXCEPTIONS)
+    using default_t = throwing_t;
+#else
+    using default_t = asserting_t;
+#endif
+  }
+
+  namespace detail
+  {
+    template <typename T>
+    struct is_bounds_policy : std::false_type {};
+
+    template <> struct is_bounds_policy<bounds::throwing_t> : std::true_type {};
+    template <> struct is_bounds_policy<bounds::asserting_t> : std::true_type {};
+    template <> struct is_bounds_policy<bounds::clamping_t> : std::true_type {};
+    template <> struct is_bounds_policy<bounds::checked_t> : std::true_type {};
+  }
+
+  namespace detail
+  {
+    [[noreturn]] inline void throw_bounds_error(const char* message)
+    {
+#if defined(__cpp_exceptions) || defined(__EXCEPTIONS)
+      throw std::logic_error(message); // programming error
+#else
+      (void)message;
+      std::abort();
+#endif
+    }
+
+    /**
+     * make_bounded_view: makes the view by `make(valid)`, where make must clamp the arguments if valid is false.
+     */
+    template <typename Make>
+    constexpr auto make_bounded_view(bounds::throwing_t, bool valid, bounds_error, const char* message, Make&& make)
+    {
+      if (!valid)
+        throw_bounds_error(message);
+
+      return make(true);
+    }
+
+    template <typename Make>
+    constexpr auto make_bounded_view(bounds::asserting_t, bool valid, bounds_error, const char* message, Make&& make)
+    {
+      assert(valid && message);
+      (void)message;
+      return make(valid);
+    }
+
+    template <typename Make>
+    constexpr auto make_bounded_view(bounds::clamping_t, bool valid, bounds_error, const char*, Make&& make)
+    {
+      return make(valid);
+    }
+
+    // specialized in checked_bounds.h (included by <ezy/result>), so the views do not depend on ezy::result
+    template <typename View, typename = void>
+    struct checked_bounds
+    {
+      static_assert(always_false<View>, "bounds::checked gives back an ezy::result, include <ezy/result>!");
+    };
+
+    template <typename Make>
+    constexpr auto make_bounded_view(bounds::checked_t, bool valid, bounds_error error, const char*, Make&& make)
+    {
+      return checked_bounds<decltype(make(true))>::make(valid, error, make);
+    }
+  }
+}
+
+#endif
@@ -0,0 +1,30 @@
+#ifndef EZY_BITS_CHECKED_BOUNDS_H_INCLUDED
+#define EZY_BITS_CHECKED_BOUNDS_H_INCLUDED
+
+#include "bounds_policy.h"
+#include "../result"
+#include "../type_traits.h" // void_t
+
+namespace ezy
+{
+  namespace detail
+  {
+    // the view of bounds::checked
+    template <typename View>
+    struct checked_bounds<View, ezy::void_t<ezy::result<View, bounds_error>>>
+    {
+      using result_type = ezy::result<View, bounds_error>;
+
+      template <typename Make>
+      static constexpr result_type make(bool valid, bounds_error error, Make& make)
+      {
+        if (valid)
+          return result_type::make_success(make(true));
+        else
+          return result_type::make_error(error);
+      }
+    };
+  }
+}
+
+#endif
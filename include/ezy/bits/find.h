@@ -2,10 +2,15 @@
 #define EZY_BITS_FIND_H_INCLUDED
 
 #include "algorithm.h" // find_element*
+#include "lookup.h" // indexed, sorted_view
 
 #include <ezy/optional>
 #include <ezy/pointer.h>
 
+#include <memory> // addressof
+#include <type_traits>
+#include <vector>
+
 namespace ezy
 {
   namespace detail
@@ -70,6 +75,155 @@ namespace ezy
   };
 
   static constexpr find_if_fn find_if{};
+
+  namespace detail
+  {
+    template <typename T>
+    struct is_sorted_view : std::false_type {};
+
+    template <typename Keeper, typename Compare>
+    struct is_sorted_view<sorted_view<Keeper, Compare>> : std::true_type {};
+
+    // the same condition as find_element uses for the find member
+    template <typename Range, typename Needle, typename = void>
+    struct has_find_member : std::false_type {};
+
+    template <typename Range, typename Needle>
+    struct has_find_member<Range, Needle, void_t<decltype(std::declval<Range&>().find(std::declval<const Needle&>()))>>
+      : std::is_convertible<
+          decltype(std::declval<Range&>().find(std::declval<const Needle&>())),
+          decltype(std::end(std::declval<Range&>()))
+        >
+    {};
+
+    // a found element: its address, or its copy if the range gives prvalues (eg. a transform)
+    template <typename Reference>
+    using found_element_t = ezy::conditional_t<
+      std::is_lvalue_reference<Reference>::value,
+      std::remove_reference_t<Reference>*,
+      ezy::optional<ezy::remove_cvref_t<Reference>>
+    >;
+
+    template <typename Found, typename Reference>
+    Found make_found(Reference&& element)
+    {
+      if constexpr (std::is_pointer<Found>::value)
+        return std::addressof(element);
+      else
+        return Found(std::forward<Reference>(element));
+    }
+
+    template <typename Found>
+    bool is_found(const Found& found)
+    {
+      if constexpr (std::is_pointer<Found>::value)
+        return found != nullptr;
+      else
+        return found.has_value();
+    }
+
+    template <typename Range, typename Keys, typename Found>
+    void find_all_keys_impl(Range& range, const Keys& keys, std::vector<Found>& found)
+    {
+      using std::begin;
+      using std::end;
+      using Key = ezy::remove_cvref_t<decltype(*begin(keys))>;
+
+      if constexpr (is_sorted_view<std::remove_const_t<Range>>::value && is_sorted_view<Keys>::value)
+      {
+        // both are sorted: the search of the next key continues from the position of the previous one
+        auto it = begin(range);
+        const auto last = end(range);
+        std::size_t i = 0;
+        for (const auto& key : keys)
+        {
+          it = sorted_lower_bound(it, last, key, range.compare);
+          if (it != last && !range.compare(key, *it))
+            found[i] = make_found<Found>(*it);
+          ++i;
+        }
+      }
+      else if constexpr (has_find_member<Range, Key>::value)
+      {
+        // the range has its own (fast) lookup
+        std::size_t i = 0;
+        for (const auto& key : keys)
+        {
+          const auto it = find_element(range, key);
+          if (it != end(range))
+            found[i] = make_found<Found>(*it);
+          ++i;
+        }
+      }
+      else
+      {
+        // one pass over the range, each element is looked up in a hash index of the keys
+        const auto index = ezy::indexed(keys);
+        const auto first_key = begin(index);
+        const auto position_of = [&](const auto& needle) { return find_element(index, needle) - first_key; };
+
+        std::size_t distinct = 0;
+        for (std::size_t i = 0; i < found.size(); ++i)
+          distinct += position_of(first_key[i]) == static_cast<std::ptrdiff_t>(i);
+
+        std::size_t found_distinct = 0;
+        for (auto it = begin(range), last = end(range); it != last && found_distinct < distinct; ++it)
+        {
+          const auto key_it = find_element(index, *it);
+          if (key_it != end(index) && !is_found(found[key_it - first_key]))
+          {
+            found[key_it - first_key] = make_found<Found>(*it);
+            ++found_distinct;
+          }
+        }
+
+        // repeated keys get the result of their first occurrence
+        for (std::size_t i = 0; i < found.size(); ++i)
+          found[i] = found[position_of(first_key[i])];
+      }
+    }
+  }
+
+  /**
+   * find_all_keys(range, keys) -> std::vector<ezy::pointer<element>>
+   *
+   * Looks up every key in the range, gives back the (first) found element for each key, in the order of the
+   * keys (or an empty pointer if the key is not found). If the range gives prvalues (eg. a transform), there is
+   * nothing to point to, so it gives back a std::vector<ezy::optional<element>> of the copies. Instead of a
+   * search for each key:
+   *  - if both are sorted (see assume_sorted), the keys are searched in one sweep over the range,
+   *  - if the range has a find member (eg. indexed, sorted ranges, sets), it is used for each key,
+   *  - otherwise the keys are put into a hash index, and the range is iterated through once (the keys must
+   *    be a random access range of hashable elements).
+   */
+  template <typename Range, typename Keys>
+  auto find_all_keys(Range&& range, const Keys& keys)
+  {
+    static_assert(std::is_same_v<
+        ezy::experimental::detail::ownership_category_t<Range>,
+        ezy::experimental::reference_category_tag
+        >, "Range must be a reference! Cannot refer to the elements of a temporary!");
+
+    using std::begin;
+    using Found = detail::found_element_t<decltype(*begin(range))>;
+
+    std::vector<Found> found(static_cast<std::size_t>(ezy::size(keys)));
+    detail::find_all_keys_impl(range, keys, found);
+
+    if constexpr (std::is_pointer<Found>::value)
+    {
+      std::vector<ezy::pointer<std::remove_pointer_t<Found>>> result;
+      result.reserve(found.size());
+      for (Found element : found)
+        result.emplace_back(element);
+
+      return result;
+    }
+    else
+    {
+      return found;
+    }
+  }
 }
 
 #endif
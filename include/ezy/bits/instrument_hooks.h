@@ -0,0 +1,80 @@
+#ifndef EZY_BITS_INSTRUMENT_HOOKS_H_INCLUDED
+#define EZY_BITS_INSTRUMENT_HOOKS_H_INCLUDED
+
+/**
+ * Hooks of the instrumentation mode (see <ezy/instrument.h>).
+ *
+ * If EZY_INSTRUMENT is not defined, the hooks are empty: instrumented<T> is an empty base (so it takes no
+ * space) and record<T>() does nothing, the code is the same as without them.
+ */
+
+namespace ezy
+{
+  namespace instrument
+  {
+    enum class event
+    {
+      construction, // constructions other than copy and move
+      copy, // copy construction or assignment
+      move, // move construction or assignment
+      invocation, // call of a predicate or other function object
+      allocation
+    };
+  }
+}
+
+#ifdef EZY_INSTRUMENT
+#include <ezy/instrument.h> // registry, needs the events above
+#endif
+
+namespace ezy
+{
+  namespace detail
+  {
+#ifdef EZY_INSTRUMENT
+    template <typename T>
+    void record(instrument::event e) noexcept
+    {
+      instrument::registry::instance().record(typeid(T), e);
+    }
+
+    /**
+     * instrumented<T>: base of the instrumented types, counts the constructions, copies and moves of T
+     */
+    template <typename T>
+    struct instrumented
+    {
+      instrumented() noexcept
+      { record<T>(instrument::event::construction); }
+
+      instrumented(const instrumented&) noexcept
+      { record<T>(instrument::event::copy); }
+
+      instrumented(instrumented&&) noexcept
+      { record<T>(instrument::event::move); }
+
+      instrumented& operator=(const instrumented&) noexcept
+      {
+        record<T>(instrument::event::copy);
+        return *this;
+      }
+
+      instrumented& operator=(instrumented&&) noexcept
+      {
+        record<T>(instrument::event::move);
+        return *this;
+      }
+    };
+#else
+    template <typename T>
+    constexpr void record(instrument::event) noexcept
+    {}
+
+    template <typename T>
+    struct instrumented
+    {};
+#endif
+  }
+}
+
+#endif
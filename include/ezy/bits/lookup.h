@@ -0,0 +1,232 @@
+#ifndef EZY_BITS_LOOKUP_H_INCLUDED
+#define EZY_BITS_LOOKUP_H_INCLUDED
+
+#include "algorithm.h" // forward_fn
+
+#include <ezy/invoke.h>
+#include <ezy/range.h>
+
+#include <algorithm> // lower_bound
+#include <cstdint>
+#include <functional> // less, hash
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/**
+ * Lookup strategies
+ *
+ * find_element (and so find, contains and custom_find) uses the `find` member of the range if it has one.
+ * The views below provide it:
+ *
+ * assume_sorted(range, compare = std::less<>{}) -> sorted_view: binary search, the range must be sorted by
+ * compare
+ *
+ * indexed(range, key_fn = identity) -> indexed_view: builds a hash index of the keys of the elements once,
+ * then every find is (amortized) O(1). Finds the (first) element whose key equals to the needle.
+ */
+
+namespace ezy
+{
+  namespace detail
+  {
+    /**
+     * lower_bound without a data dependent branch: the result of the comparison only selects the next half
+     * (which compiles to conditional moves), so the search does not suffer from branch mispredictions.
+     */
+    template <typename RandomIt, typename T, typename Compare>
+    constexpr RandomIt branchless_lower_bound(RandomIt first, RandomIt last, const T& value, Compare& compare)
+    {
+      auto length = last - first;
+      while (length > 0)
+      {
+        const auto half = length / 2;
+        const bool less = compare(first[half], value);
+        first += less ? half + 1 : 0;
+        length = less ? length - half - 1 : half;
+      }
+      return first;
+    }
+
+    template <typename Iterator>
+    using is_random_access_iterator = std::is_base_of<
+        std::random_access_iterator_tag,
+        typename std::iterator_traits<Iterator>::iterator_category
+      >;
+
+    template <typename Iterator, typename T, typename Compare>
+    constexpr Iterator sorted_lower_bound(Iterator first, Iterator last, const T& value, Compare& compare)
+    {
+      if constexpr (is_random_access_iterator<Iterator>::value)
+        return branchless_lower_bound(first, last, value, compare);
+      else
+        return std::lower_bound(first, last, value, compare);
+    }
+
+    template <typename Keeper, typename Compare>
+    struct sorted_view
+    {
+      using Range = ezy::experimental::keeper_value_type_t<Keeper>;
+      using iterator = iterator_type_t<Range>;
+      using const_iterator = const_iterator_type_t<Range>;
+      using size_type = size_type_t<Range>;
+
+      constexpr auto begin()
+      { return std::begin(range.get()); }
+
+      constexpr auto end()
+      { return std::end(range.get()); }
+
+      constexpr auto begin() const
+      { return std::cbegin(range.get()); }
+
+      constexpr auto end() const
+      { return std::cend(range.get()); }
+
+      template <typename Needle>
+      constexpr auto find(const Needle& needle)
+      { return find_impl(begin(), end(), needle, compare); }
+
+      template <typename Needle>
+      constexpr auto find(const Needle& needle) const
+      { return find_impl(begin(), end(), needle, compare); }
+
+      Keeper range;
+      Compare compare;
+
+    private:
+      template <typename Iterator, typename Needle, typename Cmp>
+      static constexpr Iterator find_impl(Iterator first, Iterator last, const Needle& needle, Cmp& cmp)
+      {
+        const Iterator found = sorted_lower_bound(first, last, needle, cmp);
+        return (found != last && !cmp(needle, *found)) ? found : last;
+      }
+    };
+
+    /**
+     * indexed_view: open addressing (linear probing) hash table of the positions of the elements, in a flat
+     * array. Positions are stored instead of iterators, so the view can be moved together with its range.
+     */
+    template <typename Keeper, typename KeyFn>
+    class indexed_view
+    {
+      public:
+        using Range = ezy::experimental::keeper_value_type_t<Keeper>;
+        using iterator = iterator_type_t<Range>;
+        using const_iterator = const_iterator_type_t<Range>;
+        using size_type = size_type_t<Range>;
+        using key_type = ezy::remove_cvref_t<decltype(
+            ezy::invoke(std::declval<const KeyFn&>(), *std::declval<const_iterator>())
+          )>;
+
+        static_assert(is_random_access_iterator<const_iterator>::value, "indexed needs a random access range");
+
+        indexed_view(Keeper&& keeper, KeyFn key_fn)
+          : range(std::move(keeper))
+          , key_fn(std::move(key_fn))
+        {
+          build();
+        }
+
+        auto begin()
+        { return std::begin(range.get()); }
+
+        auto end()
+        { return std::end(range.get()); }
+
+        auto begin() const
+        { return std::cbegin(range.get()); }
+
+        auto end() const
+        { return std::cend(range.get()); }
+
+        template <typename Needle>
+        auto find(const Needle& needle)
+        { return find_impl(begin(), end(), needle); }
+
+        template <typename Needle>
+        auto find(const Needle& needle) const
+        { return find_impl(begin(), end(), needle); }
+
+      private:
+        // positions are stored plus one, zero marks an empty slot
+        static constexpr std::size_t empty_slot = 0;
+
+        std::size_t slot_of(const key_type& key) const
+        {
+          // fibonacci hashing: the upper bits of the product are well mixed, even for identity hashes
+          const std::uint64_t hash = static_cast<std::uint64_t>(std::hash<key_type>{}(key));
+          return static_cast<std::size_t>((hash * 0x9E3779B97F4A7C15ull) >> shift);
+        }
+
+        void build()
+        {
+          const auto first = std::cbegin(range.get());
+          const auto count = static_cast<std::size_t>(std::cend(range.get()) - first);
+
+          unsigned bits = 1;
+          while ((std::size_t{1} << bits) < count * 2)
+            ++bits;
+
+          shift = 64 - bits;
+          mask = (std::size_t{1} << bits) - 1;
+          slots.assign(mask + 1, empty_slot);
+
+          for (std::size_t position = 0; position < count; ++position)
+          {
+            const key_type& key = ezy::invoke(key_fn, first[position]);
+            std::size_t slot = slot_of(key);
+            for (; slots[slot] != empty_slot; slot = (slot + 1) & mask)
+            {
+              if (ezy::invoke(key_fn, first[slots[slot] - 1]) == key)
+                break; // the first one is kept, like a linear find would find it
+            }
+
+            if (slots[slot] == empty_slot)
+              slots[slot] = position + 1;
+          }
+        }
+
+        template <typename Iterator, typename Needle>
+        Iterator find_impl(Iterator first, Iterator last, const Needle& needle) const
+        {
+          for (std::size_t slot = slot_of(needle); slots[slot] != empty_slot; slot = (slot + 1) & mask)
+          {
+            const auto candidate = first + static_cast<std::ptrdiff_t>(slots[slot] - 1);
+            if (ezy::invoke(key_fn, *candidate) == needle)
+              return candidate;
+          }
+          return last;
+        }
+
+        Keeper range;
+        KeyFn key_fn;
+        std::vector<std::size_t> slots;
+        std::size_t mask{0};
+        unsigned shift{63};
+    };
+  }
+
+  template <typename Range, typename Compare = std::less<>>
+  constexpr auto assume_sorted(Range&& range, Compare compare = Compare{})
+  {
+    using ResultRangeType = detail::sorted_view<detail::deduce_keeper_t<Range>, Compare>;
+    return ResultRangeType{
+      ezy::experimental::make_keeper(std::forward<Range>(range)),
+      std::move(compare)
+    };
+  }
+
+  template <typename Range, typename KeyFn = detail::forward_fn>
+  auto indexed(Range&& range, KeyFn key_fn = KeyFn{})
+  {
+    using ResultRangeType = detail::indexed_view<detail::deduce_keeper_t<Range>, KeyFn>;
+    return ResultRangeType(
+      ezy::experimental::make_keeper(std::forward<Range>(range)),
+      std::move(key_fn)
+    );
+  }
+}
+
+#endif
@@ -0,0 +1,181 @@
+#ifndef EZY_BITS_PARTITION_H_INCLUDED
+#define EZY_BITS_PARTITION_H_INCLUDED
+
+#include "algorithm.h"
+#include "bounds_policy.h" // make_bounded_view
+#include "policy_dispatch.h"
+#include "result_algorithm.h" // forward_element, has_reserve
+
+#include <ezy/invoke.h>
+#include <ezy/type_traits.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/**
+ * Eager partitioning: the elements of a range are collected into containers (buckets) in a single pass.
+ *
+ * partition_into<Result = std::vector>(range, predicate) -> std::pair<Result, Result>: the elements for which
+ *   the predicate is true, and the others
+ * bucketize<Result = std::vector>(range, bucket_count, key_fn, bounds policy = default) -> std::vector<Result>:
+ *   each element goes to the bucket of the index key_fn gives. A key out of [0, bucket_count) is a bounds
+ *   error (bounds_error::key_out_of_range), the policy decides (see bounds_policy.h): clamping (and asserting
+ *   without assert) skips those elements, checked gives back ezy::result<std::vector<Result>, bounds_error>
+ *
+ * The buckets keep the order of the elements, the predicate and key_fn are called once for each element.
+ * If the elements are in memory (random access range of lvalues), the keys are stored and counted first, so
+ * each bucket is allocated once. The elements of an rvalue container are moved.
+ */
+
+namespace ezy
+{
+  namespace detail
+  {
+    template <typename Result, typename Range>
+    using bucket_t = ezy::conditional_t<std::is_void<Result>::value,
+          std::vector<value_type_of_reference_t<decltype(*std::begin(std::declval<Range&>()))>>,
+          Result
+        >;
+
+    // the elements of keys out of range are skipped, the bounds policy is applied at the end
+    inline bool is_valid_bucket(std::size_t key, std::size_t bucket_count) noexcept
+    {
+      return key < bucket_count;
+    }
+
+    // true if iterating through the range again is cheap: its elements are in memory
+    template <typename Range>
+    using is_recountable = std::conjunction<
+        std::is_base_of<std::random_access_iterator_tag,
+          typename std::iterator_traits<decltype(std::begin(std::declval<Range&>()))>::iterator_category>,
+        std::is_lvalue_reference<decltype(*std::begin(std::declval<Range&>()))>
+      >;
+
+    template <typename Key, typename Range, typename Bucket, typename KeyOf>
+    bool distribute_counted(Range&& range, std::vector<Bucket>& buckets, KeyOf& key_of)
+    {
+      const std::size_t bucket_count = buckets.size();
+      // bucket_count stands for the skipped elements (Key can represent it, see distribute)
+      std::vector<Key> keys(static_cast<std::size_t>(ezy::size(range)));
+      std::vector<std::size_t> counts(bucket_count);
+      bool valid = true;
+
+      std::size_t i = 0;
+      for (auto&& element : range)
+      {
+        std::size_t key = static_cast<std::size_t>(key_of(element));
+        if (is_valid_bucket(key, bucket_count))
+          ++counts[key];
+        else
+        {
+          valid = false;
+          key = bucket_count;
+        }
+        keys[i++] = static_cast<Key>(key);
+      }
+
+      for (std::size_t b = 0; b < bucket_count; ++b)
+        buckets[b].reserve(buckets[b].size() + counts[b]);
+
+      i = 0;
+      for (auto&& element : range)
+      {
+        const std::size_t key = keys[i++];
+        if (key != bucket_count)
+          insert_back(buckets[key], forward_element<Range>(element));
+      }
+      return valid;
+    }
+
+    /**
+     * distribute(range, buckets, key_of) -> bool: appends each element to buckets[key_of(element)], gives back
+     * false if there were keys out of range (those elements are skipped)
+     */
+    template <typename Range, typename Bucket, typename KeyOf>
+    bool distribute(Range&& range, std::vector<Bucket>& buckets, KeyOf& key_of)
+    {
+      if constexpr (has_reserve<Bucket>::value && is_recountable<Range>::value)
+      {
+        if (buckets.size() < 256)
+          return distribute_counted<std::uint8_t>(std::forward<Range>(range), buckets, key_of);
+        else
+          return distribute_counted<std::size_t>(std::forward<Range>(range), buckets, key_of);
+      }
+      else
+      {
+        bool valid = true;
+        for (auto&& element : range)
+        {
+          const std::size_t key = static_cast<std::size_t>(key_of(element));
+          if (is_valid_bucket(key, buckets.size()))
+            insert_back(buckets[key], forward_element<Range>(element));
+          else
+            valid = false;
+        }
+        return valid;
+      }
+    }
+
+    template <typename Bucket, typename BoundsPolicy>
+    auto make_bucketized(BoundsPolicy policy, bool valid, std::vector<Bucket>& buckets)
+    {
+      return make_bounded_view(policy, valid, bounds_error::key_out_of_range, "bucketize: key out of range",
+          [&](bool) { return std::move(buckets); });
+    }
+
+    template <typename Predicate>
+    auto make_partition_key(Predicate& predicate)
+    {
+      return [&predicate](auto& element) -> std::size_t { return ezy::invoke(predicate, element) ? 0 : 1; };
+    }
+
+    template <typename KeyFn>
+    auto make_bucket_key(KeyFn& key_fn)
+    {
+      return [&key_fn](auto& element) { return ezy::invoke(key_fn, element); };
+    }
+  }
+
+  template <typename Result = void, typename Range, typename Predicate>
+  std::pair<detail::bucket_t<Result, Range>, detail::bucket_t<Result, Range>> partition_into(Range&& range, Predicate&& predicate)
+  {
+    std::vector<detail::bucket_t<Result, Range>> buckets(2);
+    auto key_of = detail::make_partition_key(predicate);
+    detail::distribute(std::forward<Range>(range), buckets, key_of);
+    return {std::move(buckets[0]), std::move(buckets[1])};
+  }
+
+  template <typename Result = void, typename Range, typename KeyFn, typename BoundsPolicy = bounds::default_t,
+           typename = std::enable_if_t<detail::is_bounds_policy<BoundsPolicy>::value>>
+  auto bucketize(Range&& range, std::size_t bucket_count, KeyFn&& key_fn, BoundsPolicy policy = {})
+  {
+    std::vector<detail::bucket_t<Result, Range>> buckets(bucket_count);
+    auto key_of = detail::make_bucket_key(key_fn);
+    const bool valid = detail::distribute(std::forward<Range>(range), buckets, key_of);
+    return detail::make_bucketized(policy, valid, buckets);
+  }
+
+  namespace detail
+  {
+    // for call_with_policy
+    template <typename Result>
+    struct partition_into_t
+    {
+      template <typename... Args>
+      auto operator()(Args&&... args) const { return partition_into<Result>(std::forward<Args>(args)...); }
+    };
+
+    template <typename Result>
+    struct bucketize_t
+    {
+      template <typename... Args>
+      auto operator()(Args&&... args) const { return bucketize<Result>(std::forward<Args>(args)...); }
+    };
+  }
+}
+
+#endif
@@ -0,0 +1,40 @@
+#ifndef EZY_BITS_POLICY_DISPATCH_H_INCLUDED
+#define EZY_BITS_POLICY_DISPATCH_H_INCLUDED
+
+#include <ezy/type_traits.h>
+
+#include <type_traits>
+#include <utility>
+
+namespace ezy
+{
+  struct par_unseq_dynamic_t; // parallel.h
+
+  namespace detail
+  {
+    template <typename T>
+    using is_parallel_policy = std::is_same<ezy::remove_cvref_t<T>, par_unseq_dynamic_t>;
+
+    /**
+     * call_with_policy(algorithm, range, args...): for the members of the features, which take (args...) or
+     * (policy, args...); calls algorithm(range, args...) or algorithm(policy, range, args...).
+     *
+     * The algorithm is a function object calling the free function unqualified, so the parallel overloads
+     * (parallel.h) are found by the policy, even if parallel.h is included later.
+     */
+    template <typename Algorithm, typename Range, typename... Args>
+    auto call_with_policy(Algorithm algorithm, Range&& range, Args&&... args)
+    {
+      return algorithm(std::forward<Range>(range), std::forward<Args>(args)...);
+    }
+
+    template <typename Algorithm, typename Range, typename Policy, typename... Args,
+             typename = std::enable_if_t<is_parallel_policy<Policy>::value>>
+    auto call_with_policy(Algorithm algorithm, Range&& range, Policy&& policy, Args&&... args)
+    {
+      return algorithm(policy, std::forward<Range>(range), std::forward<Args>(args)...);
+    }
+  }
+}
+
+#endif
@@ -0,0 +1,227 @@
+#ifndef EZY_BITS_RESULT_ALGORITHM_H_INCLUDED
+#define EZY_BITS_RESULT_ALGORITHM_H_INCLUDED
+
+#include "algorithm.h"
+
+#include <ezy/invoke.h>
+#include <ezy/strong_type_traits.h>
+
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace ezy
+{
+  namespace detail
+  {
+    template <typename Result>
+    using result_trait_t = typename Result::template result_interface_adapter_t<typename Result::type>;
+
+    /**
+     * owns_elements: the range is a temporary which owns its elements: not a view, and if it is a keeper, it is
+     * an owning one
+     */
+    template <typename Range>
+    constexpr bool owns_elements_v = std::is_same<
+        ezy::experimental::detail::keeper_category_t<Range>,
+        ezy::experimental::owner_category_tag
+      >::value && !is_view<ezy::remove_cvref_t<Range>>::value;
+
+    /**
+     * elements are moved out if they are rvalues, or if the range owns them (see owns_elements_v)
+     */
+    template <typename Range, typename Element>
+    constexpr decltype(auto) forward_element(Element&& element)
+    {
+      if constexpr (owns_elements_v<Range>)
+        return std::move(element);
+      else
+        return std::forward<Element>(element);
+    }
+
+    template <typename Container, typename = void>
+    struct has_reserve : std::false_type {};
+
+    template <typename Container>
+    struct has_reserve<Container, void_t<decltype(std::declval<Container&>().reserve(std::size_t{}))>>
+      : std::true_type {};
+
+    // reserves only if the size of the range is known without iterating through it
+    template <typename Container, typename Range>
+    constexpr void reserve_for(Container& container, const Range& range)
+    {
+      using std::begin;
+      using iterator_category = typename std::iterator_traits<decltype(begin(range))>::iterator_category;
+      if constexpr (has_reserve<Container>::value
+          && std::is_base_of<std::random_access_iterator_tag, iterator_category>::value)
+        container.reserve(static_cast<std::size_t>(ezy::size(range)));
+    }
+
+    template <typename Range, typename Projection, typename Container>
+    constexpr auto collect_results_impl(Range&& range, Projection&& projection, Container container)
+    {
+      using std::begin;
+      using projected_type = ezy::remove_cvref_t<decltype(
+          ezy::invoke(projection, detail::forward_element<Range>(*begin(range)))
+        )>;
+      using trait = result_trait_t<projected_type>;
+      using result_type = rebind_strong_type_t<projected_type, typename trait::template rebind_success_t<Container>>;
+      using result_trait = result_trait_t<result_type>;
+
+      reserve_for(container, range);
+      for (auto&& element : range)
+      {
+        decltype(auto) projected = ezy::invoke(projection, detail::forward_element<Range>(element));
+        if (!trait::is_success(projected.get()))
+          return result_type(result_trait::make_underlying_error(
+                trait::get_error(std::forward<decltype(projected)>(projected).get())
+              ));
+
+        insert_back(container, trait::get_success(std::forward<decltype(projected)>(projected).get()));
+      }
+      return result_type(result_trait::make_underlying_success(std::move(container)));
+    }
+
+    template <typename Range, typename Projection = forward_fn>
+    using projected_result_t = ezy::remove_cvref_t<decltype(
+        ezy::invoke(std::declval<Projection&>(), *std::begin(std::declval<Range&>()))
+      )>;
+
+    template <typename Range, typename Projection = forward_fn>
+    using projected_success_t = typename result_trait_t<projected_result_t<Range, Projection>>::success_type;
+
+    template <typename Range, typename Projection = forward_fn>
+    using projected_error_t = typename result_trait_t<projected_result_t<Range, Projection>>::error_type;
+  }
+
+  /**
+   * collect_results<Container>(range of results) -> result of Container
+   *
+   * Stops at the first error and gives it back, otherwise the success values are collected into Container.
+   * Elements of temporary containers are moved.
+   */
+  template <typename Container, typename Range>
+  constexpr auto collect_results(Range&& range)
+  {
+    return detail::collect_results_impl(std::forward<Range>(range), detail::forward_fn{}, Container{});
+  }
+
+  template <template <typename, typename...> class ContainerWrapper, typename Range>
+  constexpr auto collect_results(Range&& range)
+  {
+    using Container = ContainerWrapper<detail::projected_success_t<Range>>;
+    return collect_results<Container>(std::forward<Range>(range));
+  }
+
+  /**
+   * collect_results<Container>(range of results, allocator) -> result of Container
+   *
+   * The container of the success values uses the given allocator (or a memory resource for pmr containers).
+   */
+  template <typename Container, typename Range, typename Allocator,
+           typename = std::enable_if_t<detail::is_allocator_for<Container, Allocator>::value>>
+  auto collect_results(Range&& range, const Allocator& allocator)
+  {
+    return detail::collect_results_impl(std::forward<Range>(range), detail::forward_fn{},
+        detail::make_with_allocator<Container>(allocator));
+  }
+
+  template <template <typename, typename...> class ContainerWrapper, typename Range, typename Allocator>
+  auto collect_results(Range&& range, const Allocator& allocator)
+  {
+    using Container = ContainerWrapper<detail::projected_success_t<Range>>;
+    return collect_results<Container>(std::forward<Range>(range), allocator);
+  }
+
+  /**
+   * sequence(range of results) -> result of std::vector
+   */
+  template <typename Range>
+  constexpr auto sequence(Range&& range)
+  {
+    return collect_results<std::vector>(std::forward<Range>(range));
+  }
+
+  /**
+   * traverse(range, Fn: element -> result) -> result of Container
+   *
+   * The same as `collect_results(transform(range, fn))`, but fn is not called after the first error.
+   */
+  template <template <typename, typename...> class ContainerWrapper = std::vector, typename Range, typename Fn>
+  constexpr auto traverse(Range&& range, Fn&& fn)
+  {
+    using Container = ContainerWrapper<detail::projected_success_t<Range, Fn>>;
+    return detail::collect_results_impl(std::forward<Range>(range), std::forward<Fn>(fn), Container{});
+  }
+
+  template <template <typename, typename...> class ContainerWrapper = std::vector, typename Range, typename Fn,
+           typename Allocator>
+  auto traverse(Range&& range, Fn&& fn, const Allocator& allocator)
+  {
+    using Container = ContainerWrapper<detail::projected_success_t<Range, Fn>>;
+    return detail::collect_results_impl(std::forward<Range>(range), std::forward<Fn>(fn),
+        detail::make_with_allocator<Container>(allocator));
+  }
+
+  /**
+   * partition_results(range of results, successes, errors)
+   *
+   * Inserts the success values to the end of successes and the errors to the end of errors, in one pass.
+   * The containers are not cleared, so they can be reserved (or reused) by the caller.
+   */
+  template <typename Range, typename SuccessContainer, typename ErrorContainer>
+  constexpr void partition_results(Range&& range, SuccessContainer& successes, ErrorContainer& errors)
+  {
+    using trait = detail::result_trait_t<detail::projected_result_t<Range>>;
+
+    for (auto&& element : range)
+    {
+      decltype(auto) result = detail::forward_element<Range>(element);
+      if (trait::is_success(result.get()))
+        detail::insert_back(successes, trait::get_success(std::forward<decltype(result)>(result).get()));
+      else
+        detail::insert_back(errors, trait::get_error(std::forward<decltype(result)>(result).get()));
+    }
+  }
+
+  /**
+   * partition_results<ContainerWrapper>(range of results) -> std::pair<successes, errors>
+   *
+   * The successes are reserved for the size of the range if it is known without iterating.
+   */
+  template <template <typename, typename...> class ContainerWrapper = std::vector, typename Range>
+  constexpr auto partition_results(Range&& range)
+  {
+    std::pair<
+      ContainerWrapper<detail::projected_success_t<Range>>,
+      ContainerWrapper<detail::projected_error_t<Range>>
+    > partitions;
+
+    detail::reserve_for(partitions.first, range);
+    partition_results(std::forward<Range>(range), partitions.first, partitions.second);
+    return partitions;
+  }
+
+  /**
+   * partition_results<ContainerWrapper>(range of results, allocator) -> std::pair<successes, errors>
+   *
+   * Both containers use the given allocator (or a memory resource for pmr containers).
+   */
+  template <template <typename, typename...> class ContainerWrapper = std::vector, typename Range, typename Allocator>
+  auto partition_results(Range&& range, const Allocator& allocator)
+  {
+    using SuccessContainer = ContainerWrapper<detail::projected_success_t<Range>>;
+    using ErrorContainer = ContainerWrapper<detail::projected_error_t<Range>>;
+    std::pair<SuccessContainer, ErrorContainer> partitions(
+        detail::make_with_allocator<SuccessContainer>(allocator),
+        detail::make_with_allocator<ErrorContainer>(allocator)
+      );
+
+    detail::reserve_for(partitions.first, range);
+    partition_results(std::forward<Range>(range), partitions.first, partitions.second);
+    return partitions;
+  }
+}
+
+#endif
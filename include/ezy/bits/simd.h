@@ -0,0 +1,121 @@
+#ifndef EZY_BITS_SIMD_H_INCLUDED
+#define EZY_BITS_SIMD_H_INCLUDED
+
+/**
+ * Vectors of 32 bytes and runtime dispatch of kernels using them.
+ *
+ * With gcc or clang the kernels compute on vector types (the vector extension of the compiler), which are
+ * lowered to the instructions of the target. On x86 a kernel is compiled both for the baseline target (two
+ * SSE2 registers per vector) and for AVX2 (one register), and the AVX2 one runs if the cpu supports it
+ * (checked at run time, once). Other compilers get the scalar loops of the kernels.
+ *
+ * Define EZY_NO_SIMD to disable it.
+ */
+
+#include <cstddef>
+#include <cstring> // memcpy
+#include <type_traits>
+
+#if !defined(EZY_NO_SIMD) && (defined(__GNUC__) || defined(__clang__))
+#define EZY_SIMD_VECTORS 1
+#endif
+
+#if defined(EZY_SIMD_VECTORS) && defined(__SSE2__) && (defined(__x86_64__) || defined(__i386__))
+#define EZY_SIMD_X86 1
+#endif
+
+// the kernels must be inlined into the target specific functions, so they are compiled for that target
+#if defined(__GNUC__) || defined(__clang__)
+#define EZY_SIMD_INLINE __attribute__((always_inline)) inline
+#else
+#define EZY_SIMD_INLINE inline
+#endif
+
+namespace ezy
+{
+namespace detail
+{
+namespace simd
+{
+  template <typename T>
+  using is_vector_element = std::integral_constant<bool,
+      std::is_arithmetic<T>::value && !std::is_same<T, bool>::value && sizeof(T) <= 8 && 32 % sizeof(T) == 0
+    >;
+
+  // number of elements in a vector
+  template <typename T>
+  constexpr std::size_t lanes = 32 / sizeof(T);
+
+#ifdef EZY_SIMD_VECTORS
+  // the operators of vectors work lane by lane, expects: is_vector_element<T>
+  template <typename T>
+  struct vector_of
+  {
+    typedef T type __attribute__((vector_size(32)));
+  };
+
+  template <typename T>
+  using vector_t = typename vector_of<T>::type;
+
+  // vectors are not passed by value, their calling convention depends on the target
+  template <typename T>
+  EZY_SIMD_INLINE void load(vector_t<T>& vector, const T* p) noexcept
+  {
+    std::memcpy(&vector, p, sizeof(vector));
+  }
+
+  template <typename T>
+  EZY_SIMD_INLINE void store(T* p, const vector_t<T>& vector) noexcept
+  {
+    std::memcpy(p, &vector, sizeof(vector));
+  }
+#endif
+
+#ifdef EZY_SIMD_VECTORS
+  // out of line like the AVX2 one: once inlined, gcc checks the vector accesses of the loops against the size of
+  // the caller's array, even if the loop is not reached for that size (-Warray-bounds)
+  template <typename Kernel, typename... Args>
+  __attribute__((noinline)) auto run_baseline(Kernel kernel, Args... args)
+  {
+    return kernel(args...);
+  }
+#endif
+
+#ifdef EZY_SIMD_X86
+  inline bool has_avx2() noexcept
+  {
+    static const bool supported = __builtin_cpu_supports("avx2");
+    return supported;
+  }
+
+  template <typename Kernel, typename... Args>
+  __attribute__((target("avx2"))) auto run_avx2(Kernel kernel, Args... args)
+  {
+    return kernel(args...);
+  }
+#endif
+
+  /**
+   * dispatch(kernel, args...) -> kernel(args...)
+   *
+   * The call operator of the kernel must be EZY_SIMD_INLINE, its vectors (and loops) are compiled for the
+   * target it is inlined into.
+   */
+  template <typename Kernel, typename... Args>
+  auto dispatch(Kernel kernel, Args... args)
+  {
+#ifdef EZY_SIMD_X86
+    if (has_avx2())
+      return run_avx2(kernel, args...);
+#endif
+#ifdef EZY_SIMD_VECTORS
+    return run_baseline(kernel, args...);
+#else
+    return kernel(args...);
+#endif
+  }
+}
+}
+}
+
+#endif
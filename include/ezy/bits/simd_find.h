@@ -0,0 +1,294 @@
+#ifndef EZY_BITS_SIMD_FIND_H_INCLUDED
+#define EZY_BITS_SIMD_FIND_H_INCLUDED
+
+#include <ezy/type_traits.h>
+
+#include <array>
+#include <cstddef>
+#include <cstring> // memcpy
+#include <iterator>
+#include <limits>
+#include <type_traits>
+#include <utility>
+
+/**
+ * Vectorized search in contiguous ranges of integral (and character) types.
+ *
+ * On x86 (with gcc or clang) the search compares 16 (SSE2) or 32 (AVX2, if the cpu supports it, checked at
+ * run time) bytes at once, elsewhere it falls back to a scalar loop. The vectorized search is not used in
+ * constant expressions (if the compiler cannot tell that, it is not used at all), so find_element stays
+ * constexpr.
+ *
+ * Define EZY_NO_SIMD to disable it.
+ */
+
+#include "simd.h" // EZY_SIMD_X86, has_avx2
+
+#ifdef EZY_SIMD_X86
+#include <immintrin.h>
+#endif
+
+#if defined(__has_builtin)
+#if __has_builtin(__builtin_is_constant_evaluated)
+#define EZY_HAS_IS_CONSTANT_EVALUATED 1
+#endif
+#elif defined(__GNUC__) && __GNUC__ >= 9
+#define EZY_HAS_IS_CONSTANT_EVALUATED 1
+#endif
+
+namespace ezy
+{
+namespace detail
+{
+namespace simd
+{
+  template <typename T>
+  using is_searchable_element = std::integral_constant<bool,
+      std::is_integral<T>::value && !std::is_same<T, bool>::value
+      && (sizeof(T) == 1 || sizeof(T) == 2 || sizeof(T) == 4 || sizeof(T) == 8)
+    >;
+
+  template <typename T, std::size_t K>
+  const T* find_any_scalar(const T* first, const T* last, const std::array<T, K>& values)
+  {
+    for (; first != last; ++first)
+    {
+      for (const T& value : values)
+        if (*first == value)
+          return first;
+    }
+    return last;
+  }
+
+#ifdef EZY_SIMD_X86
+  // signed integer of the same width, for the set1 intrinsics
+  template <typename T>
+  auto as_signed(T t)
+  {
+    using Signed = std::conditional_t<sizeof(T) == 1, char,
+          std::conditional_t<sizeof(T) == 2, short,
+          std::conditional_t<sizeof(T) == 4, int, long long>>>;
+    Signed s;
+    std::memcpy(&s, &t, sizeof(T));
+    return s;
+  }
+
+  template <typename T>
+  inline __m128i broadcast_sse2(T value)
+  {
+    if constexpr (sizeof(T) == 1)
+      return _mm_set1_epi8(as_signed(value));
+    else if constexpr (sizeof(T) == 2)
+      return _mm_set1_epi16(as_signed(value));
+    else if constexpr (sizeof(T) == 4)
+      return _mm_set1_epi32(as_signed(value));
+    else
+      return _mm_set1_epi64x(as_signed(value));
+  }
+
+  template <typename T>
+  inline __m128i equal_sse2(__m128i lhs, __m128i rhs)
+  {
+    if constexpr (sizeof(T) == 1)
+      return _mm_cmpeq_epi8(lhs, rhs);
+    else if constexpr (sizeof(T) == 2)
+      return _mm_cmpeq_epi16(lhs, rhs);
+    else if constexpr (sizeof(T) == 4)
+      return _mm_cmpeq_epi32(lhs, rhs);
+    else
+    {
+      // no 64 bit comparison in sse2: both 32 bit halves must be equal
+      const __m128i halves = _mm_cmpeq_epi32(lhs, rhs);
+      return _mm_and_si128(halves, _mm_shuffle_epi32(halves, _MM_SHUFFLE(2, 3, 0, 1)));
+    }
+  }
+
+  template <typename T, std::size_t K>
+  const T* find_any_sse2(const T* first, const T* last, const std::array<T, K>& values)
+  {
+    constexpr std::ptrdiff_t lanes = 16 / sizeof(T);
+
+    __m128i needles[K];
+    for (std::size_t i = 0; i < K; ++i)
+      needles[i] = broadcast_sse2(values[i]);
+
+    for (; last - first >= lanes; first += lanes)
+    {
+      const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(first));
+      __m128i matches = equal_sse2<T>(block, needles[0]);
+      for (std::size_t i = 1; i < K; ++i)
+        matches = _mm_or_si128(matches, equal_sse2<T>(block, needles[i]));
+
+      const int mask = _mm_movemask_epi8(matches);
+      if (mask != 0)
+        return first + __builtin_ctz(static_cast<unsigned>(mask)) / sizeof(T);
+    }
+    return find_any_scalar(first, last, values);
+  }
+
+  template <typename T>
+  __attribute__((target("avx2"))) inline __m256i broadcast_avx2(T value)
+  {
+    if constexpr (sizeof(T) == 1)
+      return _mm256_set1_epi8(as_signed(value));
+    else if constexpr (sizeof(T) == 2)
+      return _mm256_set1_epi16(as_signed(value));
+    else if constexpr (sizeof(T) == 4)
+      return _mm256_set1_epi32(as_signed(value));
+    else
+      return _mm256_set1_epi64x(as_signed(value));
+  }
+
+  template <typename T>
+  __attribute__((target("avx2"))) inline __m256i equal_avx2(__m256i lhs, __m256i rhs)
+  {
+    if constexpr (sizeof(T) == 1)
+      return _mm256_cmpeq_epi8(lhs, rhs);
+    else if constexpr (sizeof(T) == 2)
+      return _mm256_cmpeq_epi16(lhs, rhs);
+    else if constexpr (sizeof(T) == 4)
+      return _mm256_cmpeq_epi32(lhs, rhs);
+    else
+      return _mm256_cmpeq_epi64(lhs, rhs);
+  }
+
+  template <typename T, std::size_t K>
+  __attribute__((target("avx2"))) const T* find_any_avx2(const T* first, const T* last, const std::array<T, K>& values)
+  {
+    constexpr std::ptrdiff_t lanes = 32 / sizeof(T);
+
+    __m256i needles[K];
+    for (std::size_t i = 0; i < K; ++i)
+      needles[i] = broadcast_avx2(values[i]);
+
+    for (; last - first >= lanes; first += lanes)
+    {
+      const __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(first));
+      __m256i matches = equal_avx2<T>(block, needles[0]);
+      for (std::size_t i = 1; i < K; ++i)
+        matches = _mm256_or_si256(matches, equal_avx2<T>(block, needles[i]));
+
+      const int mask = _mm256_movemask_epi8(matches);
+      if (mask != 0)
+        return first + __builtin_ctz(static_cast<unsigned>(mask)) / sizeof(T);
+    }
+    return find_any_sse2(first, last, values);
+  }
+#endif
+
+  /**
+   * find_any(first, last, values) -> pointer to the first element which is equal to any of the values, or last
+   */
+  template <typename T, std::size_t K>
+  const T* find_any(const T* first, const T* last, const std::array<T, K>& values)
+  {
+#ifdef EZY_SIMD_X86
+    if (has_avx2())
+      return find_any_avx2(first, last, values);
+    else
+      return find_any_sse2(first, last, values);
+#else
+    return find_any_scalar(first, last, values);
+#endif
+  }
+
+  /**
+   * Converts the needle to the element type T, so comparing the elements to it gives the same as `element ==
+   * needle` would give (with the usual arithmetic conversions).
+   *
+   * Returns: false if no element can be equal to the needle (it is out of the range of T)
+   */
+  template <typename T, typename Needle>
+  bool convert_needle(const Needle& needle, T& converted)
+  {
+    using Common = std::common_type_t<T, Needle>;
+    if constexpr (sizeof(Common) > sizeof(T))
+    {
+      const Common value = static_cast<Common>(needle);
+      const Common min = static_cast<Common>(std::numeric_limits<T>::min());
+      const Common max = static_cast<Common>(std::numeric_limits<T>::max());
+
+      // if T is signed and Common is unsigned, the negative elements are converted modulo 2^n, to the top of
+      // the range of Common, otherwise the elements keep their values
+      const bool representable = (std::is_signed<T>::value && std::is_unsigned<Common>::value)
+        ? (value <= max || value >= min)
+        : (min <= value && value <= max);
+
+      if (!representable)
+        return false;
+    }
+
+    // otherwise the comparison is done in T (or in a type of the same width), modulo 2^n
+    converted = static_cast<T>(needle);
+    return true;
+  }
+
+  template <typename Range, typename = void>
+  struct contiguous_element : std::false_type {};
+
+  template <typename T, std::size_t N>
+  struct contiguous_element<T[N]> : std::true_type
+  {
+    using type = std::remove_cv_t<T>;
+  };
+
+  template <typename Range>
+  struct contiguous_element<Range, void_t<decltype(std::declval<Range&>().data() + std::declval<Range&>().size())>>
+    : std::is_pointer<decltype(std::declval<Range&>().data())>
+  {
+    using type = std::remove_cv_t<std::remove_pointer_t<decltype(std::declval<Range&>().data())>>;
+  };
+
+  template <typename Needle>
+  using is_searchable_needle = std::integral_constant<bool,
+      std::is_integral<ezy::remove_cvref_t<Needle>>::value && !std::is_same<ezy::remove_cvref_t<Needle>, bool>::value
+    >;
+
+  /**
+   * true if Range stores its elements contiguously (it is an array, or it has data() and size()), and both the
+   * elements and the needles are integral types the vectorized search can compare.
+   */
+  template <typename Range, typename... Needles>
+  constexpr bool is_vectorizable()
+  {
+    using Container = std::remove_reference_t<Range>;
+    if constexpr (contiguous_element<Container>::value)
+      return is_searchable_element<typename contiguous_element<Container>::type>::value
+        && (... && is_searchable_needle<Needles>::value);
+    else
+      return false;
+  }
+
+  /**
+   * find_any_in(range, needles...) -> iterator of the range
+   *
+   * The vectorized search of the needles in a range, expects: is_vectorizable<Range, Needles...>()
+   */
+  template <typename Range, typename... Needles>
+  auto find_any_in(Range& range, const Needles&... needles)
+  {
+    using std::begin;
+    using std::end;
+    using T = typename contiguous_element<std::remove_reference_t<Range>>::type;
+
+    const T* const first = std::data(range);
+    const T* const last = first + std::size(range);
+
+    std::array<T, sizeof...(Needles)> values{};
+    std::size_t count = 0;
+    (..., (convert_needle(needles, values[count]) ? ++count : count));
+    if (count == 0)
+      return end(range);
+
+    // the needles which cannot be equal to any element are replaced by one which can
+    for (std::size_t i = count; i < values.size(); ++i)
+      values[i] = values[0];
+
+    const T* const found = find_any(first, last, values);
+    return begin(range) + (found - first);
+  }
+}
+}
+}
+
+#endif
@@ -0,0 +1,262 @@
+#ifndef EZY_BITS_SORT_H_INCLUDED
+#define EZY_BITS_SORT_H_INCLUDED
+
+#include "algorithm.h" // collect
+#include "policy_dispatch.h"
+
+#include <ezy/invoke.h>
+#include <ezy/strong_type_traits.h>
+#include <ezy/type_traits.h>
+
+#include <algorithm> // sort, stable_sort
+#include <array>
+#include <cstddef>
+#include <functional> // less
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/**
+ * Sorting terminals: collect the elements of a range into a std::vector and sort it.
+ *
+ * sorted(range, compare = std::less<>{}) -> std::vector
+ * stable_sorted(range, compare = std::less<>{}) -> std::vector
+ * sorted_by(range, key_fn, compare = std::less<>{}) -> std::vector: stable, ordered by the keys, key_fn is
+ *   called once for each element (the keys are computed in advance)
+ *
+ * If the range is a std::vector rvalue, it is sorted in place, no element is copied.
+ *
+ * Integral (and enum) keys, and strong types of them, are sorted by radix sort if the order is the default
+ * one (std::less), the order of a strong type is the order of its underlying value then.
+ */
+
+namespace ezy
+{
+  namespace detail
+  {
+    /**
+     * radix_key<Key>: maps integral keys (and enums, strong types of them) to unsigned integers of the same
+     * order. It is false_type for the other keys.
+     */
+    template <typename Key, typename = void>
+    struct radix_key : std::false_type
+    {};
+
+    template <typename Key>
+    struct radix_key<Key, std::enable_if_t<
+        (std::is_integral<Key>::value && !std::is_same<Key, bool>::value) || std::is_enum<Key>::value
+      >> : std::true_type
+    {
+      using underlying = typename ezy::conditional_t<std::is_enum<Key>::value,
+            std::underlying_type<Key>,
+            type_identity<Key>
+          >::type;
+      using type = std::make_unsigned_t<underlying>;
+
+      static constexpr type get(Key key) noexcept
+      {
+        type bits = static_cast<type>(static_cast<underlying>(key));
+        if constexpr (std::is_signed<underlying>::value)
+          bits ^= type{1} << (sizeof(type) * 8 - 1); // negative values come first
+        return bits;
+      }
+    };
+
+    template <typename Key>
+    struct radix_key<Key, std::enable_if_t<is_strong_type_v<Key>>> : radix_key<plain_type_t<Key>>
+    {
+      static constexpr auto get(const Key& key) noexcept
+      {
+        return radix_key<plain_type_t<Key>>::get(key.get());
+      }
+    };
+
+    template <typename Compare>
+    using is_default_order = std::disjunction<
+        std::is_same<Compare, std::less<>>,
+        std::is_same<Compare, std::less<void>>
+      >;
+
+    // below this size std::sort is faster than the passes of radix sort
+    constexpr std::size_t radix_sort_threshold = 256;
+
+    /**
+     * radix_sort(items, key_of): stable LSD radix sort by 8 bit digits, key_of must give an unsigned integer.
+     * The digits are counted in a single pass, and the passes where every key has the same digit are
+     * skipped (eg. the upper bytes of small keys).
+     */
+    template <typename Item, typename KeyOf>
+    void radix_sort(std::vector<Item>& items, KeyOf key_of)
+    {
+      using Key = decltype(key_of(items.front()));
+      constexpr std::size_t digits = sizeof(Key);
+
+      if (items.size() < 2)
+        return;
+
+      std::array<std::array<std::size_t, 256>, digits> counts{};
+      for (const Item& item : items)
+      {
+        const Key key = key_of(item);
+        for (std::size_t d = 0; d < digits; ++d)
+          ++counts[d][(key >> (8 * d)) & 0xff];
+      }
+
+      std::vector<Item> buffer(items.size());
+      for (std::size_t d = 0; d < digits; ++d)
+      {
+        const Key first_key = key_of(items.front());
+        if (counts[d][(first_key >> (8 * d)) & 0xff] == items.size())
+          continue;
+
+        std::array<std::size_t, 256> offsets;
+        std::size_t offset = 0;
+        for (std::size_t digit = 0; digit < 256; ++digit)
+        {
+          offsets[digit] = offset;
+          offset += counts[d][digit];
+        }
+
+        for (Item& item : items)
+          buffer[offsets[(key_of(item) >> (8 * d)) & 0xff]++] = std::move(item);
+
+        items.swap(buffer);
+      }
+    }
+
+    template <typename Range>
+    using sorted_element_t = value_type_of_reference_t<decltype(*std::begin(std::declval<Range&>()))>;
+
+    // the elements of the range in a vector, the vector itself if it is an rvalue
+    template <typename Range>
+    std::vector<sorted_element_t<Range>> collect_for_sort(Range&& range)
+    {
+      using Vector = std::vector<sorted_element_t<Range>>;
+      if constexpr (!std::is_lvalue_reference<Range>::value && std::is_same<ezy::remove_cvref_t<Range>, Vector>::value)
+        return Vector(std::move(range));
+      else
+        return ezy::collect<Vector>(range);
+    }
+
+    template <typename T, typename Compare>
+    void sort_elements(std::vector<T>& elements, Compare& compare, bool stable)
+    {
+      if constexpr (is_default_order<Compare>::value && radix_key<T>::value)
+      {
+        // the order of equal integers cannot be told, radix sort is stable anyway
+        if (elements.size() >= radix_sort_threshold)
+          return radix_sort(elements, [](const T& t) { return radix_key<T>::get(t); });
+      }
+
+      if (stable)
+        std::stable_sort(elements.begin(), elements.end(), compare);
+      else
+        std::sort(elements.begin(), elements.end(), compare);
+    }
+
+    // keys of the elements, with their positions; sorted, they give the order of the elements
+    template <typename Key>
+    using keyed_positions_t = std::vector<std::pair<
+        typename ezy::conditional_t<radix_key<Key>::value, radix_key<Key>, type_identity<Key>>::type,
+        std::size_t
+      >>;
+
+    template <typename Key, typename T, typename KeyFn>
+    auto make_key(const T& element, KeyFn& key_fn)
+    {
+      if constexpr (radix_key<Key>::value)
+        return radix_key<Key>::get(ezy::invoke(key_fn, element));
+      else
+        return Key(ezy::invoke(key_fn, element));
+    }
+
+    template <typename Key, typename Keyed, typename Compare>
+    void sort_keyed(Keyed& keyed, Compare& compare)
+    {
+      if constexpr (is_default_order<Compare>::value && radix_key<Key>::value)
+      {
+        if (keyed.size() >= radix_sort_threshold)
+          return radix_sort(keyed, [](const auto& k) { return k.first; });
+
+        std::stable_sort(keyed.begin(), keyed.end(),
+            [](const auto& lhs, const auto& rhs) { return lhs.first < rhs.first; });
+      }
+      else
+      {
+        std::stable_sort(keyed.begin(), keyed.end(),
+            [&compare](const auto& lhs, const auto& rhs) { return compare(lhs.first, rhs.first); });
+      }
+    }
+
+    template <typename T, typename Keyed>
+    std::vector<T> permute(std::vector<T>& elements, const Keyed& keyed)
+    {
+      std::vector<T> result;
+      result.reserve(elements.size());
+      for (const auto& k : keyed)
+        result.push_back(std::move(elements[k.second]));
+      return result;
+    }
+
+    template <typename Range, typename KeyFn>
+    using sort_key_t = ezy::remove_cvref_t<decltype(
+        ezy::invoke(std::declval<KeyFn&>(), std::declval<const sorted_element_t<Range>&>())
+      )>;
+  }
+
+  template <typename Range, typename Compare = std::less<>>
+  std::vector<detail::sorted_element_t<Range>> sorted(Range&& range, Compare compare = Compare{})
+  {
+    auto elements = detail::collect_for_sort(std::forward<Range>(range));
+    detail::sort_elements(elements, compare, false);
+    return elements;
+  }
+
+  template <typename Range, typename Compare = std::less<>>
+  std::vector<detail::sorted_element_t<Range>> stable_sorted(Range&& range, Compare compare = Compare{})
+  {
+    auto elements = detail::collect_for_sort(std::forward<Range>(range));
+    detail::sort_elements(elements, compare, true);
+    return elements;
+  }
+
+  template <typename Range, typename KeyFn, typename Compare = std::less<>>
+  std::vector<detail::sorted_element_t<Range>> sorted_by(Range&& range, KeyFn key_fn, Compare compare = Compare{})
+  {
+    using Key = detail::sort_key_t<Range, KeyFn>;
+    auto elements = detail::collect_for_sort(std::forward<Range>(range));
+
+    detail::keyed_positions_t<Key> keyed;
+    keyed.reserve(elements.size());
+    for (std::size_t i = 0; i < elements.size(); ++i)
+      keyed.emplace_back(detail::make_key<Key>(elements[i], key_fn), i);
+
+    detail::sort_keyed<Key>(keyed, compare);
+    return detail::permute(elements, keyed);
+  }
+
+  namespace detail
+  {
+    // for call_with_policy
+    struct sorted_t
+    {
+      template <typename... Args>
+      auto operator()(Args&&... args) const { return sorted(std::forward<Args>(args)...); }
+    };
+
+    struct stable_sorted_t
+    {
+      template <typename... Args>
+      auto operator()(Args&&... args) const { return stable_sorted(std::forward<Args>(args)...); }
+    };
+
+    struct sorted_by_t
+    {
+      template <typename... Args>
+      auto operator()(Args&&... args) const { return sorted_by(std::forward<Args>(args)...); }
+    };
+  }
+}
+
+#endif
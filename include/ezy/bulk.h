@@ -0,0 +1,304 @@
+#ifndef EZY_BULK_H_INCLUDED
+#define EZY_BULK_H_INCLUDED
+
+#include "strong_type_traits.h"
+#include "range.h" // subrange_view
+#include "experimental/keeper.h"
+#include "features/arithmetic.h" // forward_plain_type
+#include "bits/simd.h"
+
+#include <type_traits>
+#include <iterator> // std::data, std::size
+#include <cstddef>
+#include <cassert>
+#include <cstring> // memcpy
+
+namespace ezy
+{
+  /**
+   * has_underlying_layout
+   *
+   * True if the strong type has the same object representation as its underlying type, so a contiguous
+   * sequence of `ST` can be accessed as a sequence of the underlying type.
+   */
+  template <typename ST, typename = void>
+  struct has_underlying_layout : std::false_type {};
+
+  template <typename ST>
+  struct has_underlying_layout<ST, std::enable_if_t<is_strong_type_v<ST>>> :
+    std::integral_constant<bool,
+      !std::is_reference<extract_underlying_type_t<ST>>::value &&
+      std::is_standard_layout<ST>::value &&
+      std::is_trivially_copyable<ST>::value &&
+      sizeof(ST) == sizeof(extract_underlying_type_t<ST>) &&
+      alignof(ST) == alignof(extract_underlying_type_t<ST>)
+    >
+  {};
+
+  template <typename ST>
+  constexpr bool has_underlying_layout_v = has_underlying_layout<ST>::value;
+
+  namespace detail
+  {
+    template <typename Element, typename = void>
+    struct bulk_element
+    {
+      static_assert(std::is_arithmetic<Element>::value,
+          "Element type must be arithmetic or a strong type with the layout of its underlying type!");
+      using type = Element;
+    };
+
+    template <typename Element>
+    struct bulk_element<Element, std::enable_if_t<is_strong_type_v<std::remove_const_t<Element>>>>
+    {
+      static_assert(has_underlying_layout_v<std::remove_const_t<Element>>,
+          "Strong type must have the same layout as its underlying type!");
+
+      using underlying_type = extract_underlying_type_t<std::remove_const_t<Element>>;
+      using type = ezy::conditional_t<std::is_const<Element>::value, const underlying_type, underlying_type>;
+    };
+
+    template <typename Range>
+    using range_element_t = std::remove_pointer_t<decltype(std::data(std::declval<Range&>()))>;
+
+    template <typename Range>
+    using bulk_element_t = typename bulk_element<range_element_t<Range>>::type;
+
+    template <typename Range>
+    auto bulk_data(Range& range) noexcept
+    {
+      return reinterpret_cast<bulk_element_t<Range>*>(std::data(range));
+    }
+  }
+
+  /**
+   * underlying_span(Range) -> range of underlying values
+   *
+   * Gives a view to a contiguous range (vector, array, ...) of strong types as a range of their underlying
+   * values, without copying them.
+   */
+  template <typename Range>
+  auto underlying_span(Range&& range) noexcept
+  {
+    static_assert(std::is_same_v<
+        ezy::experimental::detail::ownership_category_t<Range>,
+        ezy::experimental::reference_category_tag
+        >, "Range must be a reference! Cannot form a view to a temporary!");
+
+    static_assert(is_strong_type_v<std::remove_const_t<detail::range_element_t<Range>>>,
+        "Range elements must be strong types!");
+
+    const auto first = detail::bulk_data(range);
+    return detail::subrange_view<decltype(first)>{first, first + std::size(range)};
+  }
+
+  /**
+   * Bulk operations on contiguous ranges of arithmetic values or strong types.
+   *
+   * The strong type operators are used only to check the types (eg. tags), the computation runs on the
+   * underlying values, in vectors of 32 bytes. On x86 the loops are compiled for AVX2 as well, which is used if
+   * the cpu supports it (see bits/simd.h).
+   *
+   * Expects: ranges have the same size
+   */
+  namespace bulk
+  {
+    namespace detail
+    {
+      template <typename T>
+      using element_t = std::remove_const_t<ezy::detail::range_element_t<T>>;
+
+      namespace simd = ezy::detail::simd;
+
+      // the vector loops run for elements of the same arithmetic type, the scalar loops compute the rest
+      struct add_kernel
+      {
+        template <typename O, typename L, typename R>
+        EZY_SIMD_INLINE void operator()(O* o, const L* l, const R* r, size_t n) const
+        {
+          size_t i = 0;
+#ifdef EZY_SIMD_VECTORS
+          if constexpr (simd::is_vector_element<O>::value && std::is_same<O, L>::value && std::is_same<O, R>::value)
+          {
+            simd::vector_t<O> lv, rv;
+            for (const size_t end = n - n % simd::lanes<O>; i < end; i += simd::lanes<O>)
+            {
+              simd::load(lv, l + i);
+              simd::load(rv, r + i);
+              lv += rv;
+              simd::store(o + i, lv);
+            }
+          }
+#endif
+          for (; i < n; ++i)
+            o[i] = l[i] + r[i];
+        }
+      };
+
+      struct scale_kernel
+      {
+        template <typename T, typename F>
+        EZY_SIMD_INLINE void operator()(T* p, F f, size_t n) const
+        {
+          size_t i = 0;
+#ifdef EZY_SIMD_VECTORS
+          // converting the factor to T first must not change the result
+          if constexpr (simd::is_vector_element<T>::value && std::is_same<std::common_type_t<T, F>, T>::value)
+          {
+            simd::vector_t<T> v;
+            for (const size_t end = n - n % simd::lanes<T>; i < end; i += simd::lanes<T>)
+            {
+              simd::load(v, p + i);
+              v *= static_cast<T>(f);
+              simd::store(p + i, v);
+            }
+          }
+#endif
+          for (; i < n; ++i)
+            p[i] *= f;
+        }
+      };
+
+      struct axpy_kernel
+      {
+        template <typename F, typename X, typename Y>
+        EZY_SIMD_INLINE void operator()(F factor, const X* xs, Y* ys, size_t n) const
+        {
+          size_t i = 0;
+#ifdef EZY_SIMD_VECTORS
+          if constexpr (simd::is_vector_element<Y>::value && std::is_same<X, Y>::value &&
+              std::is_same<std::common_type_t<Y, F>, Y>::value)
+          {
+            simd::vector_t<Y> xv, yv;
+            for (const size_t end = n - n % simd::lanes<Y>; i < end; i += simd::lanes<Y>)
+            {
+              simd::load(xv, xs + i);
+              simd::load(yv, ys + i);
+              yv = xv * static_cast<Y>(factor) + yv;
+              simd::store(ys + i, yv);
+            }
+          }
+#endif
+          for (; i < n; ++i)
+            ys[i] = xs[i] * factor + ys[i];
+        }
+      };
+
+      // number of accumulators of sum: one per element of 32 bytes (the lanes of a vector)
+      template <typename T>
+      constexpr size_t block_size = sizeof(T) < 32 ? 32 / sizeof(T) : 1;
+
+      // the accumulators are added pairwise at the end
+      template <typename Underlying>
+      struct sum_kernel
+      {
+        EZY_SIMD_INLINE Underlying operator()(const Underlying* p, size_t n) const
+        {
+          constexpr size_t block = block_size<Underlying>;
+          Underlying acc[block] = {};
+          size_t i = 0;
+#ifdef EZY_SIMD_VECTORS
+          if constexpr (simd::is_vector_element<Underlying>::value)
+          {
+            simd::vector_t<Underlying> sums = {}, values;
+            for (const size_t end = n - n % block; i < end; i += block)
+            {
+              simd::load(values, p + i);
+              sums += values;
+            }
+            std::memcpy(acc, &sums, sizeof(sums));
+          }
+#endif
+          for (const size_t end = n - n % block; i < end; i += block)
+          {
+            for (size_t j = 0; j < block; ++j)
+              acc[j] += p[i + j];
+          }
+
+          for (; i < n; ++i)
+            acc[0] += p[i];
+
+          for (size_t width = block / 2; width > 0; width /= 2)
+          {
+            for (size_t j = 0; j < width; ++j)
+              acc[j] += acc[j + width];
+          }
+          return acc[0];
+        }
+      };
+    }
+
+    /**
+     * add(Out, Lhs, Rhs): out[i] = lhs[i] + rhs[i]
+     */
+    template <typename Out, typename Lhs, typename Rhs>
+    void add(Out&& out, const Lhs& lhs, const Rhs& rhs)
+    {
+      using Result = decltype(std::declval<const detail::element_t<Lhs>&>() + std::declval<const detail::element_t<Rhs>&>());
+      static_assert(std::is_same<Result, detail::element_t<Out>>::value, "Type of the sum must match the output!");
+
+      const auto n = std::size(out);
+      assert(std::size(lhs) == n && std::size(rhs) == n);
+
+      ezy::detail::simd::dispatch(detail::add_kernel{},
+          ezy::detail::bulk_data(out), ezy::detail::bulk_data(lhs), ezy::detail::bulk_data(rhs), n);
+    }
+
+    /**
+     * scale(Range, Factor): range[i] *= factor
+     */
+    template <typename Range, typename Factor>
+    void scale(Range&& range, const Factor& factor)
+    {
+      using Element = detail::element_t<Range>;
+      static_assert(std::is_same<decltype(std::declval<Element&>() *= factor), Element&>::value,
+          "Elements must be multipliable by the factor!");
+
+      ezy::detail::simd::dispatch(detail::scale_kernel{},
+          ezy::detail::bulk_data(range), features::detail::forward_plain_type(factor), std::size(range));
+    }
+
+    /**
+     * axpy(A, X, Y): y[i] = x[i] * a + y[i]
+     */
+    template <typename A, typename X, typename Y>
+    void axpy(const A& a, const X& x, Y&& y)
+    {
+      using Element = detail::element_t<Y>;
+      using Product = decltype(std::declval<const detail::element_t<X>&>() * a);
+      static_assert(std::is_same<Product, Element>::value, "Type of the product must match the output!");
+      static_assert(std::is_same<decltype(std::declval<Product>() + std::declval<const Element&>()), Element>::value,
+          "Output must be addable!");
+
+      const auto n = std::size(y);
+      assert(std::size(x) == n);
+
+      ezy::detail::simd::dispatch(detail::axpy_kernel{},
+          features::detail::forward_plain_type(a), ezy::detail::bulk_data(x), ezy::detail::bulk_data(y), n);
+    }
+
+    /**
+     * sum(Range) -> element type
+     *
+     * The sum is accumulated in the underlying type of the elements (so small integers wrap around like in
+     * `Element + Element` converted back to Element).
+     *
+     * Note: it uses multiple accumulators (one per 32 bytes of elements), so the order of the floating point
+     * additions differs from a sequential sum. The order is the same whether AVX2 is used or not.
+     */
+    template <typename Range>
+    auto sum(const Range& range)
+    {
+      using Element = detail::element_t<Range>;
+      static_assert(std::is_constructible<Element,
+          decltype(std::declval<const Element&>() + std::declval<const Element&>())>::value,
+          "Elements must be addable!");
+
+      using Underlying = std::remove_const_t<ezy::detail::bulk_element_t<const Range>>;
+      return Element(ezy::detail::simd::dispatch(detail::sum_kernel<Underlying>{},
+          ezy::detail::bulk_data(range), std::size(range)));
+    }
+  }
+}
+
+#endif
@@ -3,6 +3,8 @@
 
 #include "invoke.h"
 
+#include <tuple>
+
 namespace ezy
 {
   /**
@@ -46,13 +48,20 @@ namespace ezy
       return call_helper_pack(std::forward<T>(t), std::get<Is>(tup)...);
     }
 
-    template <typename...Fns, typename T>
-    constexpr static decltype(auto) call_helper(std::tuple<Fns...> tup, T&& t)
+    template <typename Tuple, typename T>
+    constexpr static decltype(auto) call_helper(Tuple& tup, T&& t)
     {
       return call_helper_tuple(
           std::forward<T>(t),
-          std::forward<decltype(tup)>(tup),
-          std::make_index_sequence<sizeof...(Fns)>());
+          tup,
+          std::make_index_sequence<sizeof...(Fs)>());
+    }
+
+    // non-const, so mutable function objects can be composed
+    template <typename T>
+    constexpr decltype(auto) operator()(T&& t)
+    {
+      return call_helper(fs, std::forward<T>(t));
     }
 
     template <typename T>
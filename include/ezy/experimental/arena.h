@@ -0,0 +1,120 @@
+#ifndef EZY_EXPERIMENTAL_ARENA_H_INCLUDED
+#define EZY_EXPERIMENTAL_ARENA_H_INCLUDED
+
+#include "keeper.h" // in_arena
+#include "../bits/instrument_hooks.h"
+
+#include <memory_resource>
+#include <new> // placement new
+#include <type_traits>
+#include <utility> // forward
+
+namespace ezy
+{
+namespace experimental
+{
+  /**
+   * arena: creates objects in the memory of a caller supplied memory resource (typically a
+   * std::pmr::monotonic_buffer_resource). The objects live as long as the arena: when the arena is destroyed, their
+   * destructors are run (except of trivially destructible ones) and their memory is deallocated, in reverse order
+   * of creation.
+   *
+   * The arena does not own the memory resource: it must outlive the arena.
+   */
+  class arena
+  {
+    struct cleanup_node
+    {
+      cleanup_node* next;
+      void (*destroy)(cleanup_node*, std::pmr::memory_resource&) noexcept;
+    };
+
+    template <typename T>
+    struct object_node
+    {
+      cleanup_node header;
+      alignas(T) unsigned char storage[sizeof(T)];
+
+      T* object() noexcept
+      { return std::launder(reinterpret_cast<T*>(storage)); }
+
+      static void destroy(cleanup_node* node, std::pmr::memory_resource& resource) noexcept
+      {
+        auto* self = reinterpret_cast<object_node*>(node);
+        if constexpr (!std::is_trivially_destructible<T>::value)
+          self->object()->~T();
+        resource.deallocate(self, sizeof(object_node), alignof(object_node));
+      }
+    };
+
+    // releases the memory if the construction of the object fails
+    struct allocation_guard
+    {
+      std::pmr::memory_resource& resource;
+      void* memory;
+      std::size_t size;
+      std::size_t alignment;
+
+      ~allocation_guard()
+      {
+        if (memory)
+          resource.deallocate(memory, size, alignment);
+      }
+    };
+
+    public:
+      explicit arena(std::pmr::memory_resource& resource = *std::pmr::get_default_resource()) noexcept
+        : resource(&resource)
+      {}
+
+      arena(const arena&) = delete;
+      arena& operator=(const arena&) = delete;
+
+      ~arena()
+      {
+        while (cleanups)
+        {
+          cleanup_node* next = cleanups->next;
+          cleanups->destroy(cleanups, *resource);
+          cleanups = next;
+        }
+      }
+
+      template <typename T, typename... Args>
+      T& create(Args&&... args)
+      {
+        using node_type = object_node<T>;
+        allocation_guard guard{
+          *resource, resource->allocate(sizeof(node_type), alignof(node_type)), sizeof(node_type), alignof(node_type)
+        };
+        auto* node = ::new (guard.memory) node_type;
+        ::new (static_cast<void*>(node->storage)) T(std::forward<Args>(args)...);
+        guard.memory = nullptr;
+
+        node->header = cleanup_node{cleanups, &node_type::destroy};
+        cleanups = &node->header;
+        return *node->object();
+      }
+
+      std::pmr::memory_resource& memory_resource() const noexcept
+      { return *resource; }
+
+    private:
+      std::pmr::memory_resource* resource;
+      cleanup_node* cleanups{nullptr};
+  };
+
+  /**
+   * moves (or copies) `t` into the arena
+   */
+  template <typename T>
+  [[nodiscard]] in_arena<ezy::remove_cvref_t<T>> make_arena_keeper(arena& a, T&& t)
+  {
+    using Value = ezy::remove_cvref_t<T>;
+    ezy::detail::record<in_arena<Value>>(ezy::instrument::event::allocation);
+    return in_arena<Value>(&a.create<Value>(std::forward<T>(t)));
+  }
+}
+}
+
+#endif
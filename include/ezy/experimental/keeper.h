@@ -1,15 +1,19 @@
 #ifndef EZY_EXPERIMENTAL_KEEPER_H_INCLUDED
 #define EZY_EXPERIMENTAL_KEEPER_H_INCLUDED
 
+#include <memory> // shared_ptr
 #include <type_traits>
 #include <utility> // forward
 #include "../invoke.h"
 #include "../type_traits.h"
+#include "../bits/instrument_hooks.h"
 
 namespace ezy
 {
 namespace experimental
 {
+  class arena; // see arena.h, it also defines make_arena_keeper
+
   namespace detail
   {
     struct disable_implicit_copy
@@ -27,6 +31,21 @@ namespace experimental
    */
   struct owner_category_tag {};
   struct reference_category_tag {};
+  struct shared_category_tag {};
+  struct arena_category_tag {};
+
+  /**
+   * Keepers of these categories are cheap to copy, so they are copied (rather than referred) when a keeper is
+   * made from them.
+   */
+  template <typename CategoryTag>
+  struct is_shareable_category : std::false_type {};
+
+  template <>
+  struct is_shareable_category<shared_category_tag> : std::true_type {};
+
+  template <>
+  struct is_shareable_category<arena_category_tag> : std::true_type {};
 
   /**
    * keeper: a type which can either own or refer to an object. It helps to be explicit and catches errors
@@ -45,7 +64,9 @@ namespace experimental
    * Note: there is not protection against use-after move
    */
   template <typename T>
-  struct keeper<owner_category_tag, T> : detail::disable_implicit_copy
+  struct keeper<owner_category_tag, T>
+    : detail::disable_implicit_copy
+    , private ezy::detail::instrumented<keeper<owner_category_tag, T>>
   {
     static_assert(!std::is_reference<T>::value, "T must not be a reference. Rather set the category!");
 
@@ -172,6 +193,137 @@ namespace experimental
     }
   };
 
+  /**
+   * Shares the ownership of an object, which is created with a single allocation. Copying the keeper only
+   * increments the reference count, so it can be used where a copyable owner is needed, eg. views which are
+   * copied or handed over to other threads. (Use `const T` to share immutable objects between threads.)
+   * - use `.copy()` to copy the object itself
+   */
+  template <typename T>
+  struct keeper<shared_category_tag, T> : private ezy::detail::instrumented<keeper<shared_category_tag, T>>
+  {
+    static_assert(!std::is_reference<T>::value, "T must not be a reference. Rather set the category!");
+
+    using category_tag = shared_category_tag;
+
+    using value_type = std::remove_reference_t<T>;
+    using reference = value_type&;
+    using const_reference = const value_type&;
+
+    std::shared_ptr<T> t;
+
+    keeper(T&& u)
+      : t(std::make_shared<std::remove_const_t<T>>(std::move(u)))
+    {
+      ezy::detail::record<keeper>(ezy::instrument::event::allocation);
+    }
+
+    explicit keeper(std::shared_ptr<T> ptr) noexcept
+      : t(std::move(ptr))
+    {}
+
+    reference get() &
+    {
+      return *t;
+    }
+
+    const_reference get() const &
+    {
+      return *t;
+    }
+
+    keeper<reference_category_tag, T> ref() &
+    {
+      return keeper<reference_category_tag, T>(get());
+    }
+
+    keeper<reference_category_tag, const T> ref() const &
+    {
+      return keeper<reference_category_tag, const T>(get());
+    }
+
+    keeper<owner_category_tag, T> copy() const &
+    {
+      return keeper<owner_category_tag, T>(T{get()});
+    }
+
+    keeper<owner_category_tag, std::remove_const_t<T>> mutable_copy() const &
+    {
+      using MutableT = std::remove_const_t<T>;
+      return keeper<owner_category_tag, MutableT>(MutableT{get()});
+    }
+
+    operator keeper<shared_category_tag, const T>() const
+    {
+      return keeper<shared_category_tag, const T>{std::shared_ptr<const T>(t)};
+    }
+
+    long use_count() const noexcept
+    {
+      return t.use_count();
+    }
+
+    template <typename Fn>
+    decltype(auto) apply(Fn&& fn)
+    {
+      return ezy::invoke(std::forward<Fn>(fn), *t);
+    }
+  };
+
+  /**
+   * Refers to an object which lives in an arena. Like a reference, it is trivially copyable, but the object is
+   * owned by the arena: the keeper (and every copy of it) must not outlive the arena.
+   */
+  template <typename T>
+  struct keeper<arena_category_tag, T>
+  {
+    static_assert(!std::is_reference<T>::value, "T must not be a reference. Rather set the category!");
+
+    using category_tag = arena_category_tag;
+
+    using value_type = std::remove_reference_t<T>;
+    using reference = value_type&;
+    using const_reference = value_type&;
+
+    value_type* t;
+
+    constexpr explicit keeper(value_type* ptr) noexcept
+      : t(ptr)
+    {}
+
+    constexpr reference get()
+    {
+      return *t;
+    }
+
+    constexpr const_reference get() const
+    {
+      return *t;
+    }
+
+    constexpr keeper<reference_category_tag, T> ref() const
+    {
+      return keeper<reference_category_tag, T>(get());
+    }
+
+    constexpr keeper<owner_category_tag, std::remove_const_t<T>> mutable_copy() const &
+    {
+      using MutableT = std::remove_const_t<T>;
+      return keeper<owner_category_tag, MutableT>(MutableT{get()});
+    }
+
+    constexpr operator keeper<arena_category_tag, const T>() const
+    {
+      return keeper<arena_category_tag, const T>{t};
+    }
+
+    template <typename Fn>
+    constexpr decltype(auto) apply(Fn&& fn) const
+    {
+      return ezy::invoke(std::forward<Fn>(fn), *t);
+    }
+  };
+
   // maybe reference should work only with lvalue-refs and should not support moving at all
   // but it might not play well in generic code
 
@@ -181,6 +333,12 @@ namespace experimental
   template <typename T>
   using reference_to = keeper<reference_category_tag, T>;
 
+  template <typename T>
+  using shared = keeper<shared_category_tag, T>;
+
+  template <typename T>
+  using in_arena = keeper<arena_category_tag, T>;
+
   template <typename T>
   struct is_keeper : std::false_type {};
 
@@ -211,6 +369,10 @@ namespace experimental
     using type = Value;
   };
 
+  template <typename Category, typename Value>
+  struct keeper_value_type<const keeper<Category, Value>> : keeper_value_type<keeper<Category, Value>>
+  {};
+
   template <typename T>
   using keeper_value_type_t = typename keeper_value_type<T>::type;
 
@@ -264,6 +426,19 @@ namespace experimental
       using type = Category;
     };
 
+    /**
+     * shareable keepers are copied, even if they are referred
+     */
+    template <typename Category, typename Value>
+    struct keeper_category<keeper<Category, Value>&>
+    {
+      using type = ezy::conditional_t<is_shareable_category<Category>::value, Category, reference_category_tag>;
+    };
+
+    template <typename Category, typename Value>
+    struct keeper_category<const keeper<Category, Value>&> : keeper_category<keeper<Category, Value>&>
+    {};
+
     template <typename T>
     using keeper_category_t = typename keeper_category<T>::type;
 
@@ -285,7 +460,18 @@ namespace experimental
     static_assert(is_same_v<keeper_category_t<keeper<reference_category_tag, int>&>, reference_category_tag>, "");
     static_assert(is_same_v<keeper_category_t<keeper<reference_category_tag, int>&&>, reference_category_tag>, "");
 
-    // from keeper
+    static_assert(is_same_v<keeper_category_t<keeper<shared_category_tag, int>&>, shared_category_tag>, "");
+    static_assert(is_same_v<keeper_category_t<const keeper<arena_category_tag, int>&>, arena_category_tag>, "");
+
+    template <typename T>
+    struct is_unwrapped_keeper : std::false_type {};
+
+    template <typename Category, typename Value>
+    struct is_unwrapped_keeper<keeper<Category, Value>>
+      : std::integral_constant<bool, !is_shareable_category<Category>::value>
+    {};
+
+    // from keeper (shareable keepers are forwarded as they are)
     template <typename T>
     constexpr decltype(auto) get_keeper_value_impl(std::true_type, T&& t) noexcept
     {
@@ -302,7 +488,7 @@ namespace experimental
     template <typename T>
     constexpr decltype(auto) get_keeper_value(T&& t) noexcept
     {
-      return get_keeper_value_impl(is_keeper<std::remove_reference_t<T>>{}, std::forward<T>(t));
+      return get_keeper_value_impl(is_unwrapped_keeper<ezy::remove_cvref_t<T>>{}, std::forward<T>(t));
     }
 
     template <typename T>
@@ -324,6 +510,14 @@ namespace experimental
     return detail::infer_keeper_t<T>{detail::get_keeper_value(std::forward<T>(t))};
   }
 
+  template <typename T>
+  [[nodiscard]] shared<ezy::remove_cvref_t<T>> make_shared_keeper(T&& t)
+  {
+    using Value = ezy::remove_cvref_t<T>;
+    ezy::detail::record<shared<Value>>(ezy::instrument::event::allocation);
+    return shared<Value>(std::make_shared<Value>(std::forward<T>(t)));
+  }
+
   // make owner -> copies from reference
   // make reference -> refers
   //
@@ -0,0 +1,33 @@
+#ifndef EZY_FEATURES_ALGO_ASYNC_H_INCLUDED
+#define EZY_FEATURES_ALGO_ASYNC_H_INCLUDED
+
+#include <ezy/async.h>
+#include <ezy/features/algo_iterable.h> // make_extended_from
+
+namespace ezy::features
+{
+  struct algo_async
+  {
+    template <typename T>
+    struct impl
+    {
+      // the pipeline so far runs on a worker thread (see ezy::async)
+      auto async(std::size_t queue_capacity) const &
+      {
+        return detail::make_extended_from<T>(ezy::async(static_cast<const T&>(*this).get(), queue_capacity));
+      }
+
+      auto async(std::size_t queue_capacity) &
+      {
+        return detail::make_extended_from<T>(ezy::async(static_cast<T&>(*this).get(), queue_capacity));
+      }
+
+      auto async(std::size_t queue_capacity) &&
+      {
+        return detail::make_extended_from<T>(ezy::async(static_cast<T&&>(*this).get(), queue_capacity));
+      }
+    };
+  };
+}
+
+#endif
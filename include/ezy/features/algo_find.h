@@ -21,6 +21,12 @@ namespace ezy::features
       {
         return ezy::find_if(static_cast<const T&>(*this).get(), std::forward<Predicate>(predicate));
       }
+
+      template <typename Keys>
+      auto find_all_keys(const Keys& keys) const
+      {
+        return ezy::find_all_keys(static_cast<const T&>(*this).get(), keys);
+      }
     };
   };
 }
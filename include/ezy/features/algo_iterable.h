@@ -3,6 +3,8 @@
 
 #include <ezy/strong_type_traits.h>
 #include <ezy/bits/algorithm.h>
+#include <ezy/bits/partition.h>
+#include <ezy/bits/sort.h>
 
 namespace ezy
 {
@@ -190,6 +192,36 @@ namespace features {
       template <typename Predicate>
       auto partition(Predicate&& predicate) && = delete;
 
+      /**
+       * partition_into<Result = std::vector>(predicate) -> std::pair<Result, Result>
+       * bucketize<Result = std::vector>(bucket_count, key_fn) -> std::vector<Result>
+       * eager, single pass versions of partition; with an ezy::par_unseq_dynamic first argument, they run
+       * in parallel (see parallel.h)
+       */
+      template <typename Result = void, typename... Args>
+      auto partition_into(Args&&... args) const &
+      {
+        return ezy::detail::call_with_policy(ezy::detail::partition_into_t<Result>{}, static_cast<const T&>(*this).get(), std::forward<Args>(args)...);
+      }
+
+      template <typename Result = void, typename... Args>
+      auto partition_into(Args&&... args) &&
+      {
+        return ezy::detail::call_with_policy(ezy::detail::partition_into_t<Result>{}, static_cast<T&&>(*this).get(), std::forward<Args>(args)...);
+      }
+
+      template <typename Result = void, typename... Args>
+      auto bucketize(Args&&... args) const &
+      {
+        return ezy::detail::call_with_policy(ezy::detail::bucketize_t<Result>{}, static_cast<const T&>(*this).get(), std::forward<Args>(args)...);
+      }
+
+      template <typename Result = void, typename... Args>
+      auto bucketize(Args&&... args) &&
+      {
+        return ezy::detail::call_with_policy(ezy::detail::bucketize_t<Result>{}, static_cast<T&&>(*this).get(), std::forward<Args>(args)...);
+      }
+
       auto slice(const unsigned from, const unsigned until) const &
       {
         return detail::make_extended_from<T>(
@@ -363,6 +395,70 @@ namespace features {
         return ezy::collect<ResultWrapper>(static_cast<const T&>(*this).get());
       }
 
+      template <typename ResultContainer, typename Allocator>
+      ResultContainer to(const Allocator& allocator) const &
+      {
+        return ezy::collect<ResultContainer>(static_cast<const T&>(*this).get(), allocator);
+      }
+
+      template <typename ResultContainer, typename Allocator>
+      ResultContainer to(const Allocator& allocator) &&
+      {
+        return ezy::collect<ResultContainer>(static_cast<T&&>(*this).get(), allocator);
+      }
+
+      template <template <typename, typename...> class ResultWrapper, typename Allocator>
+      auto to(const Allocator& allocator) &&
+      {
+        return ezy::collect<ResultWrapper>(static_cast<T&&>(*this).get(), allocator);
+      }
+
+      template <template <typename, typename...> class ResultWrapper, typename Allocator>
+      auto to(const Allocator& allocator) const &
+      {
+        return ezy::collect<ResultWrapper>(static_cast<const T&>(*this).get(), allocator);
+      }
+
+      /**
+       * sorted(compare = std::less<>{}), stable_sorted(compare), sorted_by(key_fn, compare) -> std::vector
+       * with an ezy::par_unseq_dynamic first argument, they sort in parallel (see parallel.h)
+       */
+      template <typename... Args>
+      auto sorted(Args&&... args) const &
+      {
+        return ezy::detail::call_with_policy(ezy::detail::sorted_t{}, static_cast<const T&>(*this).get(), std::forward<Args>(args)...);
+      }
+
+      template <typename... Args>
+      auto sorted(Args&&... args) &&
+      {
+        return ezy::detail::call_with_policy(ezy::detail::sorted_t{}, static_cast<T&&>(*this).get(), std::forward<Args>(args)...);
+      }
+
+      template <typename... Args>
+      auto stable_sorted(Args&&... args) const &
+      {
+        return ezy::detail::call_with_policy(ezy::detail::stable_sorted_t{}, static_cast<const T&>(*this).get(), std::forward<Args>(args)...);
+      }
+
+      template <typename... Args>
+      auto stable_sorted(Args&&... args) &&
+      {
+        return ezy::detail::call_with_policy(ezy::detail::stable_sorted_t{}, static_cast<T&&>(*this).get(), std::forward<Args>(args)...);
+      }
+
+      template <typename... Args>
+      auto sorted_by(Args&&... args) const &
+      {
+        return ezy::detail::call_with_policy(ezy::detail::sorted_by_t{}, static_cast<const T&>(*this).get(), std::forward<Args>(args)...);
+      }
+
+      template <typename... Args>
+      auto sorted_by(Args&&... args) &&
+      {
+        return ezy::detail::call_with_policy(ezy::detail::sorted_by_t{}, static_cast<T&&>(*this).get(), std::forward<Args>(args)...);
+      }
+
       template <typename ResultContainer>
       constexpr auto to_iterable() const
       {
@@ -377,6 +473,12 @@ namespace features {
         return ezy::join(static_cast<const T&>(*this).get(), std::forward<Separator>(separator));
       }
 
+      template <typename Separator, typename Allocator>
+      auto join(Separator&& separator, const Allocator& allocator) const
+      {
+        return ezy::join(static_cast<const T&>(*this).get(), std::forward<Separator>(separator), allocator);
+      }
+
       constexpr auto enumerate() const &
       {
         return detail::make_extended_from<T>(
@@ -14,9 +14,10 @@ namespace features
     template <typename T>
     struct impl
     {
-      friend T operator+(T const& lhs, T const& rhs) { return T(lhs.get() + rhs.get()); }
+      friend constexpr T operator+(T const& lhs, T const& rhs) noexcept(noexcept(T(lhs.get() + rhs.get())))
+      { return T(lhs.get() + rhs.get()); }
 
-      friend T& operator+=(T& lhs, T const& rhs)
+      friend constexpr T& operator+=(T& lhs, T const& rhs) noexcept(noexcept(lhs.get() += rhs.get()))
       {
         lhs.get() += rhs.get();
         return lhs;
@@ -29,9 +30,10 @@ namespace features
     template <typename T>
     struct impl
     {
-      friend T operator-(T const& lhs, T const& rhs) { return T(lhs.get() - rhs.get()); }
+      friend constexpr T operator-(T const& lhs, T const& rhs) noexcept(noexcept(T(lhs.get() - rhs.get())))
+      { return T(lhs.get() - rhs.get()); }
 
-      friend T& operator-=(T& lhs, T const& rhs)
+      friend constexpr T& operator-=(T& lhs, T const& rhs) noexcept(noexcept(lhs.get() -= rhs.get()))
       {
         lhs.get() -= rhs.get();
         return lhs;
@@ -49,14 +51,15 @@ namespace features
   {
     // synthetize from ==
     template <typename T>
-    constexpr bool not_equal(const T& lhs, const T& rhs, ezy::detail::priority_tag<0>)
+    constexpr bool not_equal(const T& lhs, const T& rhs, ezy::detail::priority_tag<0>) noexcept(noexcept(lhs == rhs))
     {
       return !(lhs == rhs);
     }
 
     // !=
     template <typename T>
-    constexpr auto not_equal(const T& lhs, const T& rhs, ezy::detail::priority_tag<1>) -> decltype(lhs != rhs)
+    constexpr auto not_equal(const T& lhs, const T& rhs, ezy::detail::priority_tag<1>) noexcept(noexcept(lhs != rhs))
+      -> decltype(lhs != rhs)
     {
       return lhs != rhs;
     }
@@ -68,12 +71,13 @@ namespace features
     template <typename T>
     struct impl
     {
-      friend constexpr bool operator==(const T& lhs, const T& rhs)
+      friend constexpr bool operator==(const T& lhs, const T& rhs) noexcept(noexcept(lhs.get() == rhs.get()))
       {
         return lhs.get() == rhs.get();
       }
 
       friend constexpr bool operator!=(const T& lhs, const T& rhs)
+        noexcept(noexcept(detail::not_equal(lhs.get(), rhs.get(), ezy::detail::priority_tag<1>{})))
       {
         return detail::not_equal(
             lhs.get(),
@@ -89,7 +93,7 @@ namespace features
     template <typename T>
     struct impl
     {
-      friend bool operator>(const T& lhs, const T& rhs)
+      friend constexpr bool operator>(const T& lhs, const T& rhs) noexcept(noexcept(lhs.get() > rhs.get()))
       {
         return lhs.get() > rhs.get();
       }
@@ -101,9 +105,9 @@ namespace features
     template <typename T>
     struct impl
     {
-      friend bool operator>=(const T& lhs, const T& rhs)
+      friend constexpr bool operator>=(const T& lhs, const T& rhs) noexcept(noexcept(lhs.get() >= rhs.get()))
       {
-        return rhs.get() >= rhs.get();
+        return lhs.get() >= rhs.get();
       }
     };
   };
@@ -113,7 +117,7 @@ namespace features
     template <typename T>
     struct impl
     {
-      friend bool operator<(const T& lhs, const T& rhs)
+      friend constexpr bool operator<(const T& lhs, const T& rhs) noexcept(noexcept(lhs.get() < rhs.get()))
       {
         return lhs.get() < rhs.get();
       }
@@ -125,7 +129,7 @@ namespace features
     template <typename T>
     struct impl
     {
-      friend bool operator<=(const T& lhs, const T& rhs)
+      friend constexpr bool operator<=(const T& lhs, const T& rhs) noexcept(noexcept(lhs.get() <= rhs.get()))
       {
         return lhs.get() <= rhs.get();
       }
@@ -135,25 +139,25 @@ namespace features
   namespace detail
   {
     template <typename T>
-    decltype(auto) to_plain_type(T&& t)
+    constexpr decltype(auto) to_plain_type(T&& t) noexcept
     {
       return static_cast<ezy::plain_type_t<std::remove_reference_t<T>>>(t); // forwarding?
     }
 
     template <typename T>
-    decltype(auto) forward_plain_type_helper(T&& t, std::true_type)
+    constexpr decltype(auto) forward_plain_type_helper(T&& t, std::true_type) noexcept
     {
       return static_cast<T&&>(t).get();
     }
 
     template <typename T>
-    decltype(auto) forward_plain_type_helper(T&& t, std::false_type)
+    constexpr decltype(auto) forward_plain_type_helper(T&& t, std::false_type) noexcept
     {
       return static_cast<T&&>(t);
     }
 
     template <typename T>
-    decltype(auto) forward_plain_type(T&& t)
+    constexpr decltype(auto) forward_plain_type(T&& t) noexcept
     {
       return forward_plain_type_helper(static_cast<T&&>(t), ezy::is_strong_type<ezy::remove_cvref_t<T>>{});
     }
@@ -166,13 +170,18 @@ namespace features
     template <typename T>
     struct impl
     {
-      friend Result operator*(const T& lhs, const Multiplier& rhs) { return Result(lhs.get() * detail::forward_plain_type(rhs)); }
+      friend constexpr Result operator*(const T& lhs, const Multiplier& rhs)
+        noexcept(noexcept(Result(lhs.get() * detail::forward_plain_type(rhs))))
+      { return Result(lhs.get() * detail::forward_plain_type(rhs)); }
 
       template <typename B = bool, typename = std::enable_if_t<!std::is_same<T, Multiplier>::value, B>>
-      friend Result operator*(const Multiplier& lhs, const T& rhs) { return Result(detail::forward_plain_type(lhs) * rhs.get()); }
+      friend constexpr Result operator*(const Multiplier& lhs, const T& rhs)
+        noexcept(noexcept(Result(detail::forward_plain_type(lhs) * rhs.get())))
+      { return Result(detail::forward_plain_type(lhs) * rhs.get()); }
 
       // TODO conditionally constrain
-      friend T& operator*=(T& lhs, const Multiplier& rhs)
+      friend constexpr T& operator*=(T& lhs, const Multiplier& rhs)
+        noexcept(noexcept(lhs.get() *= detail::forward_plain_type(rhs)))
       {
         lhs.get() *= detail::forward_plain_type(rhs);
         return lhs;
@@ -186,12 +195,17 @@ namespace features
     template <typename T>
     struct impl
     {
-      friend T operator*(const T& lhs, const N& rhs) { return T(lhs.get() * detail::forward_plain_type(rhs)); }
+      friend constexpr T operator*(const T& lhs, const N& rhs)
+        noexcept(noexcept(T(lhs.get() * detail::forward_plain_type(rhs))))
+      { return T(lhs.get() * detail::forward_plain_type(rhs)); }
 
       template <typename B = bool, typename = std::enable_if_t<!std::is_same<T, N>::value, B>>
-      friend T operator*(const N& lhs, const T& rhs) { return T(detail::forward_plain_type(lhs) * rhs.get()); }
+      friend constexpr T operator*(const N& lhs, const T& rhs)
+        noexcept(noexcept(T(detail::forward_plain_type(lhs) * rhs.get())))
+      { return T(detail::forward_plain_type(lhs) * rhs.get()); }
 
-      friend T& operator*=(T& lhs, const N& rhs)
+      friend constexpr T& operator*=(T& lhs, const N& rhs)
+        noexcept(noexcept(lhs.get() *= detail::forward_plain_type(rhs)))
       {
         lhs.get() *= detail::forward_plain_type(rhs);
         return lhs;
@@ -227,9 +241,10 @@ namespace features
     template <typename T>
     struct self_divisible
     {
-      friend T& operator/=(T& lhs, const Divisor& rhs)
+      friend constexpr T& operator/=(T& lhs, const Divisor& rhs)
+        noexcept(noexcept(lhs.get() /= ezy::features::detail::forward_plain_type(rhs)))
       {
-        lhs.get() /= rhs;
+        lhs.get() /= ezy::features::detail::forward_plain_type(rhs);
         return lhs;
       }
     };
@@ -246,7 +261,8 @@ namespace features
     template <typename T>
     struct impl : helper_selector<T>
     {
-      friend Result operator/(const T& lhs, const Divisor& other)
+      friend constexpr Result operator/(const T& lhs, const Divisor& other)
+        noexcept(noexcept(Result(lhs.get() / ezy::features::detail::forward_plain_type(other))))
       { return Result(lhs.get() / ezy::features::detail::forward_plain_type(other)); }
     };
   };
@@ -259,12 +275,14 @@ namespace features
     {
       using Result = T;
 
-      friend Result operator/(const T& lhs, const Divisor& other)
+      friend constexpr Result operator/(const T& lhs, const Divisor& other)
+        noexcept(noexcept(Result(lhs.get() / ezy::features::detail::forward_plain_type(other))))
       {
         return Result(lhs.get() / ezy::features::detail::forward_plain_type(other));
       }
 
-      friend T& operator/=(T& lhs, const Divisor& rhs)
+      friend constexpr T& operator/=(T& lhs, const Divisor& rhs)
+        noexcept(noexcept(lhs.get() /= detail::forward_plain_type(rhs)))
       {
         lhs.get() /= detail::forward_plain_type(rhs);
         return lhs;
@@ -318,7 +336,7 @@ namespace features
     template <typename T>
     struct impl
     {
-      friend T operator-(const T& t)
+      friend constexpr T operator-(const T& t) noexcept(noexcept(T{-t.get()}))
       {
         return T{-t.get()};
       }
@@ -0,0 +1,168 @@
+#ifndef EZY_FEATURES_DIMENSIONAL_H_INCLUDED
+#define EZY_FEATURES_DIMENSIONAL_H_INCLUDED
+
+#include "arithmetic.h"
+#include "../strong_type_traits.h"
+
+#include <type_traits>
+#include <cstddef>
+
+namespace ezy
+{
+  /**
+   * dimension<Exponents...>
+   *
+   * Compile time vector of exponents of base units, eg. with (length, time) base:
+   * velocity = dimension<1, -1>, acceleration = dimension<1, -2>
+   */
+  template <int... Exponents>
+  struct dimension
+  {
+    static constexpr size_t size = sizeof...(Exponents);
+  };
+
+  template <typename D>
+  struct is_dimension : std::false_type {};
+
+  template <int... Exponents>
+  struct is_dimension<dimension<Exponents...>> : std::true_type {};
+
+  template <typename D>
+  constexpr bool is_dimension_v = is_dimension<D>::value;
+
+  /**
+   * dimension_product<D1, D2>: adds the exponents
+   */
+  template <typename D1, typename D2>
+  struct dimension_product {};
+
+  template <int... E1, int... E2>
+  struct dimension_product<dimension<E1...>, dimension<E2...>>
+  {
+    static_assert(sizeof...(E1) == sizeof...(E2), "Dimensions must have the same base!");
+    using type = dimension<(E1 + E2)...>;
+  };
+
+  template <typename D1, typename D2>
+  using dimension_product_t = typename dimension_product<D1, D2>::type;
+
+  /**
+   * dimension_quotient<D1, D2>: subtracts the exponents
+   */
+  template <typename D1, typename D2>
+  struct dimension_quotient {};
+
+  template <int... E1, int... E2>
+  struct dimension_quotient<dimension<E1...>, dimension<E2...>>
+  {
+    static_assert(sizeof...(E1) == sizeof...(E2), "Dimensions must have the same base!");
+    using type = dimension<(E1 - E2)...>;
+  };
+
+  template <typename D1, typename D2>
+  using dimension_quotient_t = typename dimension_quotient<D1, D2>::type;
+
+  /**
+   * dimension_inverse<D>: negates the exponents
+   */
+  template <typename D>
+  struct dimension_inverse {};
+
+  template <int... Exponents>
+  struct dimension_inverse<dimension<Exponents...>>
+  {
+    using type = dimension<(-Exponents)...>;
+  };
+
+  template <typename D>
+  using dimension_inverse_t = typename dimension_inverse<D>::type;
+
+  template <typename D>
+  struct is_dimensionless : std::false_type {};
+
+  template <int... Exponents>
+  struct is_dimensionless<dimension<Exponents...>> : std::integral_constant<bool, ((Exponents == 0) && ...)> {};
+
+  template <typename D>
+  constexpr bool is_dimensionless_v = is_dimensionless<D>::value;
+
+namespace features
+{
+  namespace detail
+  {
+    template <typename ST, typename Underlying, typename = void>
+    struct is_dimensional_with : std::false_type {};
+
+    template <typename ST, typename Underlying>
+    struct is_dimensional_with<ST, Underlying, std::void_t<ezy::extract_tag_t<ST>>> :
+      std::integral_constant<bool,
+        ezy::is_dimension_v<ezy::extract_tag_t<ST>> &&
+        std::is_same<ezy::extract_underlying_type_t<ST>, Underlying>::value
+      >
+    {};
+
+    /**
+     * the result of quantity arithmetic: the same strong type with the new dimension as tag, or the underlying
+     * type if the dimensions cancel out
+     */
+    template <typename ST, typename Dimension>
+    struct rebind_dimension
+    {
+      using type = ezy::conditional_t<ezy::is_dimensionless_v<Dimension>,
+            ezy::extract_underlying_type_t<ST>,
+            ezy::rebind_tag_t<ST, Dimension>
+          >;
+    };
+
+    template <typename ST, typename Dimension>
+    using rebind_dimension_t = typename rebind_dimension<ST, Dimension>::type;
+  }
+
+  /**
+   * dimensional
+   *
+   * For strong types tagged with a `dimension`. Values of the same dimension can be added, compared and
+   * scaled by the underlying type. Multiplication and division of two quantities results in the quantity
+   * of the product/quotient dimension (or in the underlying type if it is dimensionless).
+   */
+  struct dimensional
+  {
+    template <typename T>
+    struct impl :
+      additive::impl<T>,
+      negatable::impl<T>,
+      equal_comparable::impl<T>,
+      less::impl<T>,
+      less_equal::impl<T>,
+      greater::impl<T>,
+      greater_equal::impl<T>,
+      closed_multipliable_by<ezy::extract_underlying_type_t<T>>::template impl<T>,
+      closed_divisible_by<ezy::extract_underlying_type_t<T>>::template impl<T>
+    {
+      static_assert(ezy::is_dimension_v<ezy::extract_tag_t<T>>, "Tag of a dimensional strong type must be a dimension!");
+
+      template <typename Other, typename = std::enable_if_t<detail::is_dimensional_with<Other, ezy::extract_underlying_type_t<T>>::value>>
+      friend constexpr auto operator*(const T& lhs, const Other& rhs) noexcept(noexcept(lhs.get() * rhs.get()))
+      {
+        using Result = detail::rebind_dimension_t<T, ezy::dimension_product_t<ezy::extract_tag_t<T>, ezy::extract_tag_t<Other>>>;
+        return Result(lhs.get() * rhs.get());
+      }
+
+      template <typename Other, typename = std::enable_if_t<detail::is_dimensional_with<Other, ezy::extract_underlying_type_t<T>>::value>>
+      friend constexpr auto operator/(const T& lhs, const Other& rhs) noexcept(noexcept(lhs.get() / rhs.get()))
+      {
+        using Result = detail::rebind_dimension_t<T, ezy::dimension_quotient_t<ezy::extract_tag_t<T>, ezy::extract_tag_t<Other>>>;
+        return Result(lhs.get() / rhs.get());
+      }
+
+      friend constexpr auto operator/(const ezy::extract_underlying_type_t<T>& lhs, const T& rhs) noexcept(noexcept(lhs / rhs.get()))
+      {
+        using Result = ezy::rebind_tag_t<T, ezy::dimension_inverse_t<ezy::extract_tag_t<T>>>;
+        return Result(lhs / rhs.get());
+      }
+    };
+  };
+}
+}
+
+#endif
@@ -0,0 +1,257 @@
+#ifndef EZY_FEATURES_NICHE_OPTIONAL_H_INCLUDED
+#define EZY_FEATURES_NICHE_OPTIONAL_H_INCLUDED
+
+#include "../type_traits.h"
+#include "result_interface.h"
+
+#include <cstddef>
+#include <functional> // equal_to
+#include <optional> // nullopt, in_place, bad_optional_access
+#include <type_traits>
+#include <utility>
+
+namespace ezy
+{
+  /**
+   * niche_traits<T>: customization point to store an optional T in the size of T.
+   *
+   * Requirements for a specialization:
+   * static null_value() -> T
+   *   Returns: a value of T which is never used as a real value
+   *
+   * static is_null(const T&) -> bool
+   *   Returns: true if the value represents null
+   *
+   * Specialized for pointers (nullptr).
+   */
+  template <typename T>
+  struct niche_traits;
+
+  template <typename T>
+  struct niche_traits<T*>
+  {
+    static constexpr T* null_value() noexcept
+    { return nullptr; }
+
+    static constexpr bool is_null(T* const& t) noexcept
+    { return t == nullptr; }
+  };
+
+  template <typename T, typename = void>
+  struct has_niche : std::false_type {};
+
+  template <typename T>
+  struct has_niche<T, void_t<decltype(niche_traits<T>::null_value())>> : std::true_type {};
+
+  template <typename T>
+  constexpr bool has_niche_v = has_niche<T>::value;
+
+  /**
+   * niche: the niche is given by stateless function objects, in the same way as features::nullable_as.
+   * NoneProvider: returns the value representing null
+   * NoneChecker: binary predicate which returns true if the value represents null compared with the null value
+   */
+  template <typename NoneProvider, typename NoneChecker = std::equal_to<>>
+  struct niche
+  {
+    static_assert(std::is_empty<NoneProvider>::value,
+        "NoneProvider must not have internal state!");
+
+    static_assert(std::is_empty<NoneChecker>::value,
+        "NoneChecker must not have internal state!");
+
+    static constexpr auto null_value()
+    { return NoneProvider{}(); }
+
+    template <typename T>
+    static constexpr bool is_null(const T& t)
+    { return NoneChecker{}(t, NoneProvider{}()); }
+  };
+
+  /**
+   * basic_niche_optional: an optional-like type which has no space overhead, the null state is represented by
+   * the niche value. Setting the niche value as a value results in an empty optional.
+   */
+  template <typename T, typename Niche = niche_traits<T>>
+  class basic_niche_optional
+  {
+    public:
+      using value_type = T;
+      using niche_type = Niche;
+
+      constexpr basic_niche_optional() noexcept(noexcept(T(Niche::null_value())))
+        : _value(Niche::null_value())
+      {}
+
+      constexpr basic_niche_optional(std::nullopt_t) noexcept(noexcept(T(Niche::null_value())))
+        : _value(Niche::null_value())
+      {}
+
+      template <typename... Args>
+      constexpr explicit basic_niche_optional(std::in_place_t, Args&&... args)
+        noexcept(std::is_nothrow_constructible<T, Args...>::value)
+        : _value(std::forward<Args>(args)...)
+      {}
+
+      template <typename U = T,
+               typename = std::enable_if_t<
+                 std::is_constructible<T, U>::value
+                 && !std::is_same<ezy::remove_cvref_t<U>, basic_niche_optional>::value
+                 && !std::is_same<ezy::remove_cvref_t<U>, std::nullopt_t>::value
+                 && !std::is_same<ezy::remove_cvref_t<U>, std::in_place_t>::value
+               >
+              >
+      constexpr basic_niche_optional(U&& u) noexcept(std::is_nothrow_constructible<T, U>::value)
+        : _value(std::forward<U>(u))
+      {}
+
+      constexpr bool has_value() const noexcept
+      { return !Niche::is_null(_value); }
+
+      constexpr explicit operator bool() const noexcept
+      { return has_value(); }
+
+      constexpr T& value() &
+      { check(); return _value; }
+
+      constexpr const T& value() const &
+      { check(); return _value; }
+
+      constexpr T&& value() &&
+      { check(); return std::move(_value); }
+
+      constexpr const T&& value() const &&
+      { check(); return std::move(_value); }
+
+      template <typename U>
+      constexpr T value_or(U&& default_value) const &
+      { return has_value() ? _value : static_cast<T>(std::forward<U>(default_value)); }
+
+      template <typename U>
+      constexpr T value_or(U&& default_value) &&
+      { return has_value() ? std::move(_value) : static_cast<T>(std::forward<U>(default_value)); }
+
+      constexpr T& operator*() & noexcept
+      { return _value; }
+
+      constexpr const T& operator*() const & noexcept
+      { return _value; }
+
+      constexpr T&& operator*() && noexcept
+      { return std::move(_value); }
+
+      constexpr const T&& operator*() const && noexcept
+      { return std::move(_value); }
+
+      constexpr T* operator->() noexcept
+      { return &_value; }
+
+      constexpr const T* operator->() const noexcept
+      { return &_value; }
+
+      constexpr void reset() noexcept(noexcept(std::declval<T&>() = Niche::null_value()))
+      { _value = Niche::null_value(); }
+
+      friend constexpr bool operator==(const basic_niche_optional& lhs, const basic_niche_optional& rhs)
+      {
+        if (lhs.has_value() != rhs.has_value())
+          return false;
+
+        return !lhs.has_value() || *lhs == *rhs;
+      }
+
+      friend constexpr bool operator!=(const basic_niche_optional& lhs, const basic_niche_optional& rhs)
+      { return !(lhs == rhs); }
+
+    private:
+      constexpr void check() const
+      {
+        if (!has_value())
+          throw std::bad_optional_access{};
+      }
+
+      T _value;
+  };
+
+  /**
+   * compact_optional_storage: basic_niche_optional if T has niche_traits, std::optional otherwise
+   */
+  template <typename T>
+  struct compact_optional_storage
+  {
+    using type = ezy::conditional_t<has_niche_v<T>, basic_niche_optional<T>, std::optional<T>>;
+  };
+
+  template <typename T>
+  using compact_optional_storage_t = typename compact_optional_storage<T>::type;
+}
+
+namespace ezy::features
+{
+  /**
+   * adapter for features::result_inferface, works with std::optional and basic_niche_optional.
+   *
+   * Rebinding to another success type picks the compact storage of the new type, rebinding to the same type
+   * keeps the niche.
+   */
+  template <typename Optional>
+  struct compact_optional_adapter
+  {
+    using type = Optional;
+    using success_type = typename Optional::value_type;
+    using error_type = std::nullopt_t;
+    inline static constexpr auto error_value = std::nullopt;
+
+    template <typename T>
+    static constexpr bool is_success(T&& t) noexcept
+    {
+      return t.has_value();
+    }
+
+    template <typename T>
+    static constexpr decltype(auto) get_success(T&& t) noexcept
+    {
+      return *std::forward<T>(t);
+    }
+
+    template <typename T>
+    static constexpr decltype(auto) get_error(T&&) noexcept
+    {
+      return error_value;
+    }
+
+    template <typename... Ts>
+    static constexpr decltype(auto) make_underlying_success(Ts&&... ts)
+    {
+      return type{std::in_place_t{}, std::forward<Ts>(ts)...};
+    }
+
+    template <typename... Ts>
+    static constexpr decltype(auto) make_underlying_error(Ts&&...)
+    {
+      return type{error_value};
+    }
+
+    template <typename NewValue>
+    struct rebind_success
+    {
+      using type = ezy::conditional_t<
+        std::is_same<NewValue, success_type>::value,
+        Optional,
+        compact_optional_storage_t<NewValue>
+      >;
+    };
+    template <typename NewValue>
+    using rebind_success_t = typename rebind_success<NewValue>::type;
+
+    template <typename NewValue>
+    struct rebind_error
+    {
+      using type = Optional;
+    };
+    template <typename NewValue>
+    using rebind_error_t = typename rebind_error<NewValue>::type;
+  };
+}
+
+#endif
@@ -0,0 +1,225 @@
+#ifndef EZY_FEATURES_NICHE_RESULT_H_INCLUDED
+#define EZY_FEATURES_NICHE_RESULT_H_INCLUDED
+
+#include "../type_traits.h"
+#include "std_variant.h"
+#include "niche_optional.h" // niche_traits
+
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+#include <variant> // in_place_index
+
+namespace ezy
+{
+  namespace detail
+  {
+    // Value can tell apart the alternatives by its niche value, if the other alternative has no state
+    template <typename Value, typename Other>
+    constexpr bool can_hold_niche_result_v = has_niche_v<Value> &&
+      std::is_empty<Other>::value && std::is_default_constructible<Other>::value;
+  }
+
+  /**
+   * has_niche_result<Success, Error>: true if a result of them can be stored in the size of one of them, see
+   * basic_niche_result.
+   */
+  template <typename Success, typename Error>
+  constexpr bool has_niche_result_v = detail::can_hold_niche_result_v<Success, Error> ||
+    detail::can_hold_niche_result_v<Error, Success>;
+
+  /**
+   * basic_niche_result: holds either a Success or an Error in the size of one of them, without a separate
+   * discriminant. One of them must have niche_traits, and the other one must be an empty type (eg. a tag like
+   * `struct not_found {};`): only the first one is stored, and its niche value means the other alternative.
+   *
+   * Like basic_niche_optional, the niche value given as the stored alternative results in the other one.
+   */
+  template <typename Success, typename Error>
+  class basic_niche_result
+  {
+    static_assert(has_niche_result_v<Success, Error>,
+        "One of Success and Error must have niche_traits and the other one must be an empty type!");
+
+    static constexpr bool holds_success = detail::can_hold_niche_result_v<Success, Error>;
+    using value_type = ezy::conditional_t<holds_success, Success, Error>;
+    using niche_type = niche_traits<value_type>;
+
+    struct value_tag {};
+    struct niche_tag {};
+
+    public:
+      using success_type = Success;
+      using error_type = Error;
+
+      inline static constexpr size_t success = 0;
+      inline static constexpr size_t error = 1;
+
+      template <typename... Args>
+      constexpr explicit basic_niche_result(std::in_place_index_t<success>, Args&&... args)
+        : basic_niche_result(ezy::conditional_t<holds_success, value_tag, niche_tag>{}, std::forward<Args>(args)...)
+      {}
+
+      template <typename... Args>
+      constexpr explicit basic_niche_result(std::in_place_index_t<error>, Args&&... args)
+        : basic_niche_result(ezy::conditional_t<holds_success, niche_tag, value_tag>{}, std::forward<Args>(args)...)
+      {}
+
+      constexpr size_t index() const noexcept
+      { return is_success() ? success : error; }
+
+      constexpr bool is_success() const noexcept
+      {
+        if constexpr (holds_success)
+          return !niche_type::is_null(_value);
+        else
+          return niche_type::is_null(_value);
+      }
+
+      // Expects: is_success(), the empty alternative is returned by value
+      constexpr decltype(auto) get_success() & noexcept
+      {
+        if constexpr (holds_success)
+          return (_value);
+        else
+          return Success{};
+      }
+
+      constexpr decltype(auto) get_success() const & noexcept
+      {
+        if constexpr (holds_success)
+          return (_value);
+        else
+          return Success{};
+      }
+
+      constexpr decltype(auto) get_success() && noexcept
+      {
+        if constexpr (holds_success)
+          return std::move(_value);
+        else
+          return Success{};
+      }
+
+      // Expects: !is_success(), the empty alternative is returned by value
+      constexpr decltype(auto) get_error() & noexcept
+      {
+        if constexpr (holds_success)
+          return Error{};
+        else
+          return (_value);
+      }
+
+      constexpr decltype(auto) get_error() const & noexcept
+      {
+        if constexpr (holds_success)
+          return Error{};
+        else
+          return (_value);
+      }
+
+      constexpr decltype(auto) get_error() && noexcept
+      {
+        if constexpr (holds_success)
+          return Error{};
+        else
+          return std::move(_value);
+      }
+
+    private:
+      template <typename... Args>
+      constexpr explicit basic_niche_result(value_tag, Args&&... args)
+        : _value(std::forward<Args>(args)...)
+      {}
+
+      template <typename... Args>
+      constexpr explicit basic_niche_result(niche_tag, Args&&...)
+        : _value(niche_type::null_value())
+      {}
+
+      value_type _value;
+  };
+
+  /**
+   * compact_result_storage: basic_niche_result if Success or Error can carry the discriminant in its niche,
+   * std::variant otherwise
+   */
+  template <typename Success, typename Error>
+  struct compact_result_storage
+  {
+    using type = ezy::conditional_t<
+      has_niche_result_v<Success, Error>,
+      basic_niche_result<Success, Error>,
+      std::variant<Success, Error>
+    >;
+  };
+
+  template <typename Success, typename Error>
+  using compact_result_storage_t = typename compact_result_storage<Success, Error>::type;
+}
+
+namespace ezy::features
+{
+  /**
+   * features::result_interface adapter for the compact result storages. Rebinding picks the storage
+   * for the new types.
+   */
+  template <typename Type>
+  struct compact_result_adapter;
+
+  template <typename Success, typename Error>
+  struct compact_result_adapter<std::variant<Success, Error>> : result_adapter<std::variant<Success, Error>>
+  {
+    template <typename NewSuccess>
+    using rebind_success_t = compact_result_storage_t<NewSuccess, Error>;
+
+    template <typename NewError>
+    using rebind_error_t = compact_result_storage_t<Success, NewError>;
+  };
+
+  template <typename Success, typename Error>
+  struct compact_result_adapter<basic_niche_result<Success, Error>>
+  {
+    using type = basic_niche_result<Success, Error>;
+    using success_type = Success;
+    using error_type = Error;
+
+    template <typename T>
+    static constexpr bool is_success(T&& t) noexcept
+    {
+      return t.is_success();
+    }
+
+    template <typename T>
+    static constexpr decltype(auto) get_success(T&& t) noexcept
+    {
+      return std::forward<T>(t).get_success();
+    }
+
+    template <typename T>
+    static constexpr decltype(auto) get_error(T&& t) noexcept
+    {
+      return std::forward<T>(t).get_error();
+    }
+
+    template <typename... Ts>
+    static constexpr decltype(auto) make_underlying_success(Ts&&... ts)
+    {
+      return type{std::in_place_index_t<type::success>{}, std::forward<Ts>(ts)...};
+    }
+
+    template <typename... Ts>
+    static constexpr decltype(auto) make_underlying_error(Ts&&... ts)
+    {
+      return type{std::in_place_index_t<type::error>{}, std::forward<Ts>(ts)...};
+    }
+
+    template <typename NewSuccess>
+    using rebind_success_t = compact_result_storage_t<NewSuccess, Error>;
+
+    template <typename NewError>
+    using rebind_error_t = compact_result_storage_t<Success, NewError>;
+  };
+}
+
+#endif
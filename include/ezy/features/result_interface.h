@@ -3,6 +3,10 @@
 
 #include "../strong_type_traits.h"
 #include "../invoke.h"
+#include "../compose.h"
+
+#include <tuple>
+#include <utility>
 
 namespace ezy
 {
@@ -59,8 +63,215 @@ namespace features
               ezy::invoke(std::forward<FnErr>(fn_err), SourceTrait::get_error(std::forward<ST>(t).get()))
             ));
     }
+
+    template <typename... Fns>
+    struct map_step
+    {
+      ezy::composed<Fns...> fn;
+
+      // consecutive maps are composed into one step, so only the last value is stored into a result
+      template <typename Fn>
+      constexpr map_step<Fns..., std::decay_t<Fn>> then(Fn&& next) &&
+      {
+        return std::apply([&](auto&... fns) {
+            return map_step<Fns..., std::decay_t<Fn>>{
+              ezy::composed<Fns..., std::decay_t<Fn>>(std::move(fns)..., std::forward<Fn>(next))
+            };
+          }, fn.fs);
+      }
+    };
+
+    template <typename Fn>
+    struct and_then_step
+    {
+      Fn fn;
+    };
+
+    template <typename T>
+    constexpr decltype(auto) forward_underlying(T&& t)
+    {
+      if constexpr (is_strong_type_v<ezy::remove_cvref_t<T>>)
+        return std::forward<T>(t).get();
+      else
+        return std::forward<T>(t);
+    }
+
+    template <template <typename...> class Adapter, typename Underlying, typename Value, typename Step>
+    struct chain_step;
+
+    template <template <typename...> class Adapter, typename Underlying, typename Value, typename... Fns>
+    struct chain_step<Adapter, Underlying, Value, map_step<Fns...>>
+    {
+      using value_type = decltype(ezy::invoke(std::declval<ezy::composed<Fns...>&>(), std::declval<Value>()));
+      using underlying_type = typename Adapter<Underlying>::template rebind_success_t<ezy::remove_cvref_t<value_type>>;
+    };
+
+    template <template <typename...> class Adapter, typename Underlying, typename Value, typename Fn>
+    struct chain_step<Adapter, Underlying, Value, and_then_step<Fn>>
+    {
+      using fn_result_type = decltype(ezy::invoke(std::declval<Fn&>(), std::declval<Value>()));
+      using underlying_type = plain_type_t<ezy::remove_cvref_t<fn_result_type>>;
+      using value_type = decltype(Adapter<underlying_type>::get_success(std::declval<underlying_type>()));
+
+      static_assert(
+          std::is_same<typename Adapter<underlying_type>::error_type, typename Adapter<Underlying>::error_type>::value,
+          "error types must be the same"
+      );
+    };
+
+    template <template <typename...> class Adapter, typename Underlying, typename Value, typename... Steps>
+    struct chain_traits
+    {
+      using underlying_type = Underlying;
+    };
+
+    template <template <typename...> class Adapter, typename Underlying, typename Value, typename Step, typename... Steps>
+    struct chain_traits<Adapter, Underlying, Value, Step, Steps...>
+      : chain_traits<
+          Adapter,
+          typename chain_step<Adapter, Underlying, Value, Step>::underlying_type,
+          typename chain_step<Adapter, Underlying, Value, Step>::value_type,
+          Steps...
+        >
+    {};
+
+    template <typename Step>
+    struct is_map_step : std::false_type {};
+
+    template <typename... Fns>
+    struct is_map_step<map_step<Fns...>> : std::true_type {};
+
+    template <typename... Steps>
+    struct ends_with_map_step : std::false_type {};
+
+    template <typename Step, typename... Steps>
+    struct ends_with_map_step<Step, Steps...>
+      : is_map_step<std::tuple_element_t<sizeof...(Steps), std::tuple<Step, Steps...>>> {};
   }
 
+  /**
+   * continuation_chain: lazily collected map and and_then continuations of a result. Nothing is called until
+   * evaluate(): the source is checked once, consecutive maps are composed (with ezy::compose) into one call,
+   * and the final result is constructed once. Only the results of and_then continuations are checked in
+   * between. The success value is moved through the steps if the source is an rvalue.
+   *
+   * Source is either the result type (owned) or a reference to it.
+   */
+  template <template <typename...> class Adapter, typename Source, typename... Steps>
+  class continuation_chain
+  {
+    using source_type = ezy::remove_cvref_t<Source>;
+    using source_trait = Adapter<typename source_type::type>;
+    using source_value_type = decltype(source_trait::get_success(std::declval<Source>().get()));
+
+    public:
+      using result_type = rebind_strong_type_t<
+        source_type,
+        typename detail::chain_traits<Adapter, typename source_type::type, source_value_type, Steps...>::underlying_type
+      >;
+
+      constexpr continuation_chain(Source&& source, std::tuple<Steps...>&& steps)
+        : source(std::forward<Source>(source))
+        , steps(std::move(steps))
+      {}
+
+      /**
+       * map(Fn) -> continuation_chain
+       */
+      template <typename Fn>
+      constexpr auto map(Fn&& fn) &&
+      {
+        if constexpr (detail::ends_with_map_step<Steps...>::value)
+          return std::move(*this).compose_last(std::make_index_sequence<sizeof...(Steps) - 1>{}, std::forward<Fn>(fn));
+        else
+          return std::move(*this).append(detail::map_step<std::decay_t<Fn>>{
+                ezy::composed<std::decay_t<Fn>>(std::forward<Fn>(fn))
+              });
+      }
+
+      /**
+       * and_then(Fn) -> continuation_chain
+       */
+      template <typename Fn>
+      constexpr auto and_then(Fn&& fn) &&
+      {
+        return std::move(*this).append(detail::and_then_step<std::decay_t<Fn>>{std::forward<Fn>(fn)});
+      }
+
+      /**
+       * evaluate() -> result_type
+       */
+      constexpr result_type evaluate() &&
+      {
+        if (source_trait::is_success(source.get()))
+          return run<0>(source_trait::get_success(std::forward<Source>(source).get()));
+        else
+          return make_error(source_trait::get_error(std::forward<Source>(source).get()));
+      }
+
+    private:
+      using result_trait = Adapter<typename result_type::type>;
+
+      template <typename Step>
+      constexpr continuation_chain<Adapter, Source, Steps..., Step> append(Step&& step) &&
+      {
+        return {
+          std::forward<Source>(source),
+          std::tuple_cat(std::move(steps), std::tuple<Step>(std::move(step)))
+        };
+      }
+
+      template <std::size_t... Is, typename Fn>
+      constexpr auto compose_last(std::index_sequence<Is...>, Fn&& fn) &&
+      {
+        using steps_tuple = std::tuple<Steps...>;
+        auto last = std::get<sizeof...(Steps) - 1>(std::move(steps)).then(std::forward<Fn>(fn));
+        return continuation_chain<Adapter, Source, std::tuple_element_t<Is, steps_tuple>..., decltype(last)>{
+          std::forward<Source>(source),
+          std::tuple<std::tuple_element_t<Is, steps_tuple>..., decltype(last)>(
+              std::get<Is>(std::move(steps))..., std::move(last)
+            )
+        };
+      }
+
+      template <typename Error>
+      static constexpr result_type make_error(Error&& error)
+      {
+        return result_type(result_trait::make_underlying_error(std::forward<Error>(error)));
+      }
+
+      template <std::size_t I, typename Value>
+      constexpr result_type run(Value&& value)
+      {
+        if constexpr (I == sizeof...(Steps))
+        {
+          return result_type(result_trait::make_underlying_success(std::forward<Value>(value)));
+        }
+        else
+        {
+          auto& step = std::get<I>(steps);
+          if constexpr (detail::is_map_step<std::tuple_element_t<I, std::tuple<Steps...>>>::value)
+          {
+            return run<I + 1>(ezy::invoke(step.fn, std::forward<Value>(value)));
+          }
+          else
+          {
+            auto&& fn_result = ezy::invoke(step.fn, std::forward<Value>(value));
+            using fn_result_type = decltype(fn_result);
+            using trait = Adapter<plain_type_t<ezy::remove_cvref_t<fn_result_type>>>;
+
+            if (trait::is_success(detail::forward_underlying(fn_result)))
+              return run<I + 1>(trait::get_success(detail::forward_underlying(std::forward<fn_result_type>(fn_result))));
+            else
+              return make_error(trait::get_error(detail::forward_underlying(std::forward<fn_result_type>(fn_result))));
+          }
+        }
+      }
+
+      Source source;
+      std::tuple<Steps...> steps;
+  };
+
   template <template <typename...> class Adapter>
   struct result_interface
   {
@@ -433,6 +644,27 @@ namespace features
         return _impl::and_then(static_cast<T&&>(*this), std::forward<Fn>(fn));
       }
 
+      /**
+       * chain() -> continuation_chain
+       *
+       * eg. `r.chain().map(f).map(g).and_then(h).evaluate()` gives the same result as `r.map(f).map(g).and_then(h)`,
+       * without the intermediate results.
+       */
+      constexpr auto chain() &
+      {
+        return continuation_chain<Adapter, T&>(static_cast<T&>(*this), std::tuple<>{});
+      }
+
+      constexpr auto chain() const &
+      {
+        return continuation_chain<Adapter, const T&>(static_cast<const T&>(*this), std::tuple<>{});
+      }
+
+      constexpr auto chain() &&
+      {
+        return continuation_chain<Adapter, T>(static_cast<T&&>(*this), std::tuple<>{});
+      }
+
       template <typename Fn>
       constexpr decltype(auto) tee(Fn&& fn) const&
       {
@@ -4,6 +4,7 @@
 #include "../strong_type.h"
 #include "result_interface.h"
 #include <variant>
+#include <cstddef>
 
 namespace ezy::features
 {
@@ -0,0 +1,305 @@
+#ifndef EZY_GENERATOR_H_INCLUDED
+#define EZY_GENERATOR_H_INCLUDED
+
+#if __has_include(<coroutine>) && defined(__cpp_impl_coroutine)
+
+#include "bits/instrument_hooks.h"
+#include "range.h" // single_pass_iterator_tag
+
+#include <coroutine>
+#include <cstddef>
+#include <exception> // terminate
+#include <iterator>
+#include <memory> // addressof
+#include <new>
+#include <type_traits>
+#include <utility>
+
+/**
+ * generator<T>: a single pass range of the values a coroutine yields (C++20)
+ *
+ *   ezy::generator<token> tokens(std::string_view input)
+ *   {
+ *     // any state machine, in local variables
+ *     co_yield token{...};
+ *   }
+ *
+ *   ezy::for_each(ezy::take(ezy::filter(tokens(input), is_keyword), 10), print);
+ *
+ * The coroutine runs lazily: it starts at the first begin() and continues to the next co_yield at each
+ * increment. Every begin() returns the current position, so the views (which call begin() for each of their
+ * iterators) work on it, but only single pass algorithms can be used. chunk collects the elements of each
+ * chunk into a vector.
+ *
+ * The coroutine frames are allocated from a thread local pool: the frames of finished generators are reused
+ * by the next ones, so a generator per parsed line does not go to the heap each time.
+ */
+
+namespace ezy
+{
+  namespace detail
+  {
+    /**
+     * frame_pool: per thread free lists of coroutine frames, in size classes of 64 bytes, up to 1 KiB. Larger
+     * frames are allocated with operator new. A frame can be released on any thread.
+     */
+    class frame_pool
+    {
+      public:
+        static constexpr std::size_t granularity = 64;
+        static constexpr std::size_t classes = 16;
+
+        static void* allocate(std::size_t size)
+        {
+          const std::size_t size_class = size_class_of(size);
+          if (size_class >= classes)
+            return ::operator new(size);
+
+          if (!destroyed)
+          {
+            block*& head = local().free_lists[size_class];
+            if (head != nullptr)
+            {
+              block* const reused = head;
+              head = reused->next;
+              return reused;
+            }
+          }
+          // the whole size class, even without a pool: the frame can be released into the pool of another thread
+          return ::operator new((size_class + 1) * granularity);
+        }
+
+        static void deallocate(void* frame, std::size_t size) noexcept
+        {
+          const std::size_t size_class = size_class_of(size);
+          if (size_class < classes && !destroyed)
+          {
+            block*& head = local().free_lists[size_class];
+            head = ::new (frame) block{head};
+          }
+          else
+          {
+            ::operator delete(frame);
+          }
+        }
+
+        frame_pool() = default;
+        frame_pool(const frame_pool&) = delete;
+        frame_pool& operator=(const frame_pool&) = delete;
+
+        ~frame_pool()
+        {
+          for (block* head : free_lists)
+          {
+            while (head != nullptr)
+            {
+              block* const next = head->next;
+              ::operator delete(head);
+              head = next;
+            }
+          }
+          destroyed = true; // frames released after this (at thread exit) go directly to operator delete
+        }
+
+      private:
+        struct block
+        {
+          block* next;
+        };
+
+        static std::size_t size_class_of(std::size_t size) noexcept
+        {
+          return (size - 1) / granularity;
+        }
+
+        static frame_pool& local()
+        {
+          thread_local frame_pool pool;
+          return pool;
+        }
+
+        static inline thread_local bool destroyed = false;
+
+        block* free_lists[classes]{};
+    };
+  }
+
+  template <typename T>
+  class generator
+  {
+    public:
+      using value_type = ezy::remove_cvref_t<T>;
+      using reference = const value_type&;
+      using size_type = std::size_t;
+
+      class promise_type
+      {
+        public:
+          generator get_return_object() noexcept
+          {
+            return generator{handle::from_promise(*this)};
+          }
+
+          std::suspend_always initial_suspend() const noexcept
+          { return {}; }
+
+          std::suspend_always final_suspend() const noexcept
+          { return {}; }
+
+          // the value lives until the coroutine is resumed, as the coroutine is suspended within the
+          // full expression of co_yield
+          std::suspend_always yield_value(const value_type& value) noexcept
+          {
+            current = std::addressof(value);
+            return {};
+          }
+
+          void return_void() const noexcept
+          {}
+
+          void unhandled_exception()
+          {
+#if defined(__cpp_exceptions)
+            throw; // to the caller of the increment, the generator is finished
+#else
+            std::terminate();
+#endif
+          }
+
+          // a generator produces values, it does not wait for anything
+          template <typename U>
+          std::suspend_never await_transform(U&&) = delete;
+
+          static void* operator new(std::size_t size)
+          {
+            detail::record<generator>(instrument::event::allocation);
+            return detail::frame_pool::allocate(size);
+          }
+
+          static void operator delete(void* frame, std::size_t size) noexcept
+          {
+            detail::frame_pool::deallocate(frame, size);
+          }
+
+        private:
+          friend generator;
+
+          const value_type* current{nullptr};
+          bool started{false};
+      };
+
+      using handle = std::coroutine_handle<promise_type>;
+
+      class iterator : private detail::instrumented<iterator>
+      {
+        public:
+          using difference_type = std::ptrdiff_t;
+          using value_type = generator::value_type;
+          using reference = generator::reference;
+          using pointer = const value_type*;
+          using iterator_category = single_pass_iterator_tag;
+
+          iterator() = default;
+
+          explicit iterator(handle coroutine) noexcept
+            : coroutine(coroutine)
+          {}
+
+          iterator& operator++()
+          {
+            coroutine.resume();
+            return *this;
+          }
+
+          void operator++(int)
+          {
+            ++*this;
+          }
+
+          reference operator*() const noexcept
+          {
+            return *coroutine.promise().current;
+          }
+
+          pointer operator->() const noexcept
+          {
+            return coroutine.promise().current;
+          }
+
+          // every iterator is at the same position, they only differ in being at the end or not
+          bool operator==(const iterator& rhs) const noexcept
+          {
+            return done() == rhs.done();
+          }
+
+          bool operator!=(const iterator& rhs) const noexcept
+          {
+            return !(*this == rhs);
+          }
+
+        private:
+          bool done() const noexcept
+          {
+            return !coroutine || coroutine.done();
+          }
+
+          handle coroutine{};
+      };
+
+      using const_iterator = iterator;
+
+      generator() = default;
+
+      generator(generator&& other) noexcept
+        : coroutine(std::exchange(other.coroutine, nullptr))
+      {}
+
+      generator& operator=(generator&& other) noexcept
+      {
+        if (this != &other)
+        {
+          destroy();
+          coroutine = std::exchange(other.coroutine, nullptr);
+        }
+        return *this;
+      }
+
+      ~generator()
+      {
+        destroy();
+      }
+
+      // starts the coroutine on the first call, then returns the current position
+      iterator begin() const
+      {
+        if (coroutine && !coroutine.promise().started)
+        {
+          coroutine.promise().started = true;
+          coroutine.resume();
+        }
+        return iterator{coroutine};
+      }
+
+      iterator end() const noexcept
+      {
+        return iterator{};
+      }
+
+    private:
+      explicit generator(handle coroutine) noexcept
+        : coroutine(coroutine)
+      {}
+
+      void destroy() noexcept
+      {
+        if (coroutine)
+          coroutine.destroy();
+      }
+
+      handle coroutine{};
+  };
+}
+
+#endif
+
+#endif
@@ -0,0 +1,153 @@
+#ifndef EZY_INSTRUMENT_H_INCLUDED
+#define EZY_INSTRUMENT_H_INCLUDED
+
+#include "bits/instrument_hooks.h"
+
+#include <cstddef>
+#include <mutex>
+#include <type_traits>
+#include <typeindex>
+#include <typeinfo>
+#include <unordered_map>
+#include <utility>
+
+/**
+ * Instrumentation mode
+ *
+ * If EZY_INSTRUMENT is defined (in every translation unit of the program), the iterators of the views and
+ * the keepers count their constructions, copies and moves, the iterators count the invocations of their
+ * function objects, and the allocating components (shared keepers, small_vector) count their allocations.
+ * The counters are collected per type in the registry.
+ *
+ * counting<T> counts the copies and moves of the elements themselves, it works without EZY_INSTRUMENT too.
+ *
+ * Note: in instrumentation mode the views cannot be used in constant expressions.
+ */
+
+namespace ezy
+{
+  namespace instrument
+  {
+    struct stats
+    {
+      std::size_t constructions{0};
+      std::size_t copies{0};
+      std::size_t moves{0};
+      std::size_t invocations{0};
+      std::size_t allocations{0};
+    };
+
+    class registry
+    {
+      public:
+        static registry& instance()
+        {
+          static registry r;
+          return r;
+        }
+
+        void record(std::type_index type, event e)
+        {
+          std::lock_guard<std::mutex> lock(mutex);
+          stats& s = counters[type];
+          switch (e)
+          {
+            case event::construction: ++s.constructions; break;
+            case event::copy: ++s.copies; break;
+            case event::move: ++s.moves; break;
+            case event::invocation: ++s.invocations; break;
+            case event::allocation: ++s.allocations; break;
+          }
+        }
+
+        stats get(std::type_index type) const
+        {
+          std::lock_guard<std::mutex> lock(mutex);
+          const auto found = counters.find(type);
+          return found != counters.end() ? found->second : stats{};
+        }
+
+        // copy of every counter, keyed by the type (use `name()` of the key to print them)
+        std::unordered_map<std::type_index, stats> snapshot() const
+        {
+          std::lock_guard<std::mutex> lock(mutex);
+          return counters;
+        }
+
+        void reset()
+        {
+          std::lock_guard<std::mutex> lock(mutex);
+          counters.clear();
+        }
+
+      private:
+        registry() = default;
+
+        mutable std::mutex mutex;
+        std::unordered_map<std::type_index, stats> counters;
+    };
+
+    /**
+     * stats_of<T>() -> stats
+     *
+     * The counters of T, eg. `stats_of<decltype(view.begin())>().copies`.
+     */
+    template <typename T>
+    stats stats_of()
+    {
+      return registry::instance().get(typeid(T));
+    }
+
+    inline void reset()
+    {
+      registry::instance().reset();
+    }
+
+    /**
+     * counting<T>: wraps T and counts its copies and moves into stats_of<counting<T>>(), so the copies of the
+     * elements can be checked in tests.
+     */
+    template <typename T>
+    struct counting
+    {
+      T value;
+
+      counting() = default;
+
+      template <typename... Args, typename = std::enable_if_t<std::is_constructible<T, Args&&...>::value>>
+      explicit counting(Args&&... args)
+        : value(std::forward<Args>(args)...)
+      {}
+
+      counting(const counting& other)
+        : value(other.value)
+      { registry::instance().record(typeid(counting), event::copy); }
+
+      counting(counting&& other) noexcept(std::is_nothrow_move_constructible<T>::value)
+        : value(std::move(other.value))
+      { registry::instance().record(typeid(counting), event::move); }
+
+      counting& operator=(const counting& other)
+      {
+        value = other.value;
+        registry::instance().record(typeid(counting), event::copy);
+        return *this;
+      }
+
+      counting& operator=(counting&& other) noexcept(std::is_nothrow_move_assignable<T>::value)
+      {
+        value = std::move(other.value);
+        registry::instance().record(typeid(counting), event::move);
+        return *this;
+      }
+
+      friend bool operator==(const counting& lhs, const counting& rhs)
+      { return lhs.value == rhs.value; }
+
+      friend bool operator!=(const counting& lhs, const counting& rhs)
+      { return !(lhs == rhs); }
+    };
+  }
+}
+
+#endif
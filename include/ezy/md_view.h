@@ -0,0 +1,611 @@
+#ifndef EZY_MD_VIEW_H_INCLUDED
+#define EZY_MD_VIEW_H_INCLUDED
+
+#include "bits/algorithm.h" // deduce_keeper_t
+#include "bits/bounds_policy.h" // throw_bounds_error
+#include "experimental/keeper.h"
+#include "range.h"
+
+#include <algorithm> // min
+#include <array>
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+
+/**
+ * md_view(range, extents...): a random access range seen as a multi-dimensional array, stored in row-major
+ * order (the last index is the fastest), without copying it. Element (i0, i1, ...) is at
+ * offset + i0 * stride(0) + i1 * stride(1) + ..., the views below only compute a new offset, extents and strides:
+ *
+ * view(i0, i1, ...): the element (unchecked)
+ * row(i), col(j): the i-th slice along the first axis, the j-th along the last one (slice<Axis>(i) in general)
+ * sub_block(first, extents): the block of the given extents from the index first
+ * transposed(): the axes in reverse order
+ * reshaped(extents...): the same elements with other extents, if they are contiguous in the range
+ * in_storage_order(): the axes ordered by decreasing stride, so the iteration follows the memory
+ * blocked(tile): iterates through the last two axes in tile x tile blocks
+ *
+ * The views are random access ranges iterated in row-major order (so they can be zipped, transformed and
+ * split for the parallel algorithms), except the blocked one, which is a forward range. A view over an
+ * lvalue refers to it, a view over an rvalue owns the range, and the views made of it refer to it (or take it
+ * over, if it is an rvalue too). Invalid extents and indices are bounds errors (see bounds_policy.h: they throw
+ * std::logic_error, or abort if exceptions are disabled).
+ */
+
+namespace ezy
+{
+  namespace detail
+  {
+    /**
+     * md_layout: extents, strides and offset of a multi-dimensional view, in elements of the range
+     */
+    template <std::size_t Rank>
+    struct md_layout
+    {
+      using index_type = std::array<std::ptrdiff_t, Rank>;
+
+      constexpr std::ptrdiff_t size() const
+      {
+        std::ptrdiff_t result = 1;
+        for (const auto extent : extents)
+          result *= extent;
+        return result;
+      }
+
+      constexpr std::ptrdiff_t position_of(const index_type& index) const
+      {
+        std::ptrdiff_t result = offset;
+        for (std::size_t d = 0; d < Rank; ++d)
+          result += index[d] * strides[d];
+        return result;
+      }
+
+      // true if the elements are stored in row-major order, without gaps
+      constexpr bool is_contiguous() const
+      {
+        if (size() == 0)
+          return true;
+
+        std::ptrdiff_t stride = 1;
+        for (std::size_t d = Rank; d-- > 0;)
+        {
+          if (extents[d] != 1 && strides[d] != stride)
+            return false;
+          stride *= extents[d];
+        }
+        return true;
+      }
+
+      index_type extents;
+      index_type strides;
+      std::ptrdiff_t offset;
+    };
+
+    template <std::size_t Rank>
+    constexpr md_layout<Rank> row_major_layout(const std::array<std::ptrdiff_t, Rank>& extents, std::ptrdiff_t offset)
+    {
+      md_layout<Rank> layout{extents, {}, offset};
+      std::ptrdiff_t stride = 1;
+      for (std::size_t d = Rank; d-- > 0;)
+      {
+        if (extents[d] < 0)
+          throw_bounds_error("md_view: negative extent");
+
+        layout.strides[d] = stride;
+        stride *= extents[d];
+      }
+      return layout;
+    }
+
+    template <std::size_t Axis, std::size_t Rank>
+    constexpr md_layout<Rank - 1> slice_layout(const md_layout<Rank>& layout, std::size_t i)
+    {
+      static_assert(Rank >= 2, "md_view: a slice needs two axes");
+      static_assert(Axis < Rank, "md_view: no such axis");
+
+      if (i >= static_cast<std::size_t>(layout.extents[Axis]))
+        throw_bounds_error("md_view: index out of range");
+
+      md_layout<Rank - 1> result{{}, {}, layout.offset + static_cast<std::ptrdiff_t>(i) * layout.strides[Axis]};
+      for (std::size_t d = 0, r = 0; d < Rank; ++d)
+      {
+        if (d == Axis)
+          continue;
+
+        result.extents[r] = layout.extents[d];
+        result.strides[r] = layout.strides[d];
+        ++r;
+      }
+      return result;
+    }
+
+    template <std::size_t Rank>
+    constexpr md_layout<Rank> sub_block_layout(const md_layout<Rank>& layout,
+        const std::array<std::size_t, Rank>& first, const std::array<std::size_t, Rank>& extents)
+    {
+      md_layout<Rank> result = layout;
+      for (std::size_t d = 0; d < Rank; ++d)
+      {
+        const auto extent = static_cast<std::size_t>(layout.extents[d]);
+        if (first[d] > extent || extents[d] > extent - first[d])
+          throw_bounds_error("md_view: sub block out of range");
+
+        result.offset += static_cast<std::ptrdiff_t>(first[d]) * layout.strides[d];
+        result.extents[d] = static_cast<std::ptrdiff_t>(extents[d]);
+      }
+      return result;
+    }
+
+    template <std::size_t Rank>
+    constexpr md_layout<Rank> transposed_layout(const md_layout<Rank>& layout)
+    {
+      md_layout<Rank> result = layout;
+      for (std::size_t d = 0; d < Rank; ++d)
+      {
+        result.extents[d] = layout.extents[Rank - 1 - d];
+        result.strides[d] = layout.strides[Rank - 1 - d];
+      }
+      return result;
+    }
+
+    template <std::size_t Rank>
+    constexpr md_layout<Rank> storage_order_layout(const md_layout<Rank>& layout)
+    {
+      md_layout<Rank> result = layout;
+      // insertion sort by decreasing stride, axes with equal strides keep their order
+      for (std::size_t d = 1; d < Rank; ++d)
+      {
+        for (std::size_t e = d; e > 0 && result.strides[e - 1] < result.strides[e]; --e)
+        {
+          const auto extent = result.extents[e];
+          const auto stride = result.strides[e];
+          result.extents[e] = result.extents[e - 1];
+          result.strides[e] = result.strides[e - 1];
+          result.extents[e - 1] = extent;
+          result.strides[e - 1] = stride;
+        }
+      }
+      return result;
+    }
+
+    template <std::size_t NewRank, std::size_t Rank>
+    constexpr md_layout<NewRank> reshaped_layout(const md_layout<Rank>& layout, const std::array<std::ptrdiff_t, NewRank>& extents)
+    {
+      if (!layout.is_contiguous())
+        throw_bounds_error("md_view: only a contiguous view can be reshaped");
+
+      const auto result = row_major_layout(extents, layout.offset);
+      if (result.size() != layout.size())
+        throw_bounds_error("md_view: extents do not match the size of the view");
+
+      return result;
+    }
+
+    /**
+     * md_iterator: the elements of a layout in row-major order. The index is updated incrementally, jumps
+     * compute it from the ordinal (the number of elements before), so it is random access.
+     */
+    template <typename Iterator, std::size_t Rank>
+    struct md_iterator
+    {
+      using difference_type = std::ptrdiff_t;
+      using reference = decltype(*std::declval<Iterator&>());
+      using value_type = value_type_of_reference_t<reference>;
+      using pointer = std::add_pointer_t<reference>;
+      using iterator_category = std::random_access_iterator_tag;
+
+      constexpr md_iterator(const Iterator& first, const md_layout<Rank>& layout, difference_type ordinal)
+        : first(first)
+        , layout(layout)
+        , ordinal(ordinal)
+      {
+        seek();
+      }
+
+      constexpr reference operator*() const
+      {
+        return *std::next(first, position);
+      }
+
+      constexpr reference operator[](difference_type n) const
+      {
+        return *(*this + n);
+      }
+
+      constexpr md_iterator& operator++()
+      {
+        ++ordinal;
+        for (std::size_t d = Rank; d-- > 0;)
+        {
+          position += layout.strides[d];
+          if (++index[d] < layout.extents[d])
+            return *this;
+
+          position -= layout.extents[d] * layout.strides[d];
+          index[d] = 0;
+        }
+        return *this;
+      }
+
+      constexpr md_iterator operator++(int)
+      {
+        auto result = *this;
+        ++*this;
+        return result;
+      }
+
+      constexpr md_iterator& operator--()
+      {
+        --ordinal;
+        for (std::size_t d = Rank; d-- > 0;)
+        {
+          if (index[d] > 0)
+          {
+            --index[d];
+            position -= layout.strides[d];
+            return *this;
+          }
+
+          index[d] = layout.extents[d] - 1;
+          position += index[d] * layout.strides[d];
+        }
+        return *this;
+      }
+
+      constexpr md_iterator operator--(int)
+      {
+        auto result = *this;
+        --*this;
+        return result;
+      }
+
+      constexpr md_iterator& operator+=(difference_type n)
+      {
+        ordinal += n;
+        seek();
+        return *this;
+      }
+
+      constexpr md_iterator& operator-=(difference_type n)
+      {
+        return *this += -n;
+      }
+
+      friend constexpr md_iterator operator+(md_iterator it, difference_type n)
+      { return it += n; }
+
+      friend constexpr md_iterator operator+(difference_type n, md_iterator it)
+      { return it += n; }
+
+      friend constexpr md_iterator operator-(md_iterator it, difference_type n)
+      { return it -= n; }
+
+      friend constexpr difference_type operator-(const md_iterator& lhs, const md_iterator& rhs)
+      { return lhs.ordinal - rhs.ordinal; }
+
+      friend constexpr bool operator==(const md_iterator& lhs, const md_iterator& rhs)
+      { return lhs.ordinal == rhs.ordinal; }
+
+      friend constexpr bool operator!=(const md_iterator& lhs, const md_iterator& rhs)
+      { return lhs.ordinal != rhs.ordinal; }
+
+      friend constexpr bool operator<(const md_iterator& lhs, const md_iterator& rhs)
+      { return lhs.ordinal < rhs.ordinal; }
+
+      friend constexpr bool operator>(const md_iterator& lhs, const md_iterator& rhs)
+      { return lhs.ordinal > rhs.ordinal; }
+
+      friend constexpr bool operator<=(const md_iterator& lhs, const md_iterator& rhs)
+      { return lhs.ordinal <= rhs.ordinal; }
+
+      friend constexpr bool operator>=(const md_iterator& lhs, const md_iterator& rhs)
+      { return lhs.ordinal >= rhs.ordinal; }
+
+      // the first index takes what is left, so the end is one past the last element of the first axis
+      constexpr void seek()
+      {
+        auto rest = ordinal;
+        for (std::size_t d = Rank; d-- > 1;)
+        {
+          const auto extent = layout.extents[d];
+          index[d] = extent > 0 ? rest % extent : 0;
+          rest = extent > 0 ? rest / extent : 0;
+        }
+        index[0] = rest;
+        position = layout.position_of(index);
+      }
+
+      Iterator first;
+      md_layout<Rank> layout;
+      difference_type ordinal;
+      typename md_layout<Rank>::index_type index{};
+      difference_type position{};
+    };
+
+    /**
+     * md_blocked_iterator: the last two axes in tiles of tile x tile elements (row-major inside a tile, the
+     * tiles in row-major order), the other axes in row-major order.
+     */
+    template <typename Iterator, std::size_t Rank>
+    struct md_blocked_iterator
+    {
+      static_assert(Rank >= 2, "md_view: blocked iteration needs two axes");
+
+      static constexpr std::size_t row = Rank - 2;
+      static constexpr std::size_t col = Rank - 1;
+
+      using difference_type = std::ptrdiff_t;
+      using reference = decltype(*std::declval<Iterator&>());
+      using value_type = value_type_of_reference_t<reference>;
+      using pointer = std::add_pointer_t<reference>;
+      using iterator_category = std::forward_iterator_tag;
+
+      constexpr md_blocked_iterator(const Iterator& first, const md_layout<Rank>& layout, difference_type tile, difference_type ordinal)
+        : first(first)
+        , layout(layout)
+        , tile(tile)
+        , ordinal(ordinal)
+        , position(layout.offset)
+        , row_end(std::min(tile, layout.extents[row]))
+        , col_end(std::min(tile, layout.extents[col]))
+      {}
+
+      constexpr reference operator*() const
+      {
+        return *std::next(first, position);
+      }
+
+      constexpr md_blocked_iterator& operator++()
+      {
+        ++ordinal;
+        if (++index[col] < col_end)
+          position += layout.strides[col];
+        else
+          next_row();
+
+        return *this;
+      }
+
+      constexpr md_blocked_iterator operator++(int)
+      {
+        auto result = *this;
+        ++*this;
+        return result;
+      }
+
+      friend constexpr bool operator==(const md_blocked_iterator& lhs, const md_blocked_iterator& rhs)
+      { return lhs.ordinal == rhs.ordinal; }
+
+      friend constexpr bool operator!=(const md_blocked_iterator& lhs, const md_blocked_iterator& rhs)
+      { return lhs.ordinal != rhs.ordinal; }
+
+      constexpr void next_row()
+      {
+        index[col] = tile_col;
+        if (++index[row] < row_end)
+        {
+          position += layout.strides[row] - (col_end - 1 - tile_col) * layout.strides[col];
+          return;
+        }
+
+        next_tile();
+        position = layout.position_of(index);
+      }
+
+      constexpr void next_tile()
+      {
+        tile_col += tile;
+        if (tile_col >= layout.extents[col])
+        {
+          tile_col = 0;
+          tile_row += tile;
+          if (tile_row >= layout.extents[row])
+          {
+            tile_row = 0;
+            for (std::size_t d = row; d-- > 0;)
+            {
+              if (++index[d] < layout.extents[d])
+                break;
+
+              index[d] = 0;
+            }
+          }
+        }
+
+        index[row] = tile_row;
+        index[col] = tile_col;
+        row_end = std::min(tile_row + tile, layout.extents[row]);
+        col_end = std::min(tile_col + tile, layout.extents[col]);
+      }
+
+      Iterator first;
+      md_layout<Rank> layout;
+      difference_type tile;
+      difference_type ordinal;
+      difference_type position;
+      typename md_layout<Rank>::index_type index{};
+      difference_type tile_row{};
+      difference_type tile_col{};
+      difference_type row_end;
+      difference_type col_end;
+    };
+
+    template <typename Keeper, std::size_t Rank>
+    struct md_blocked_view
+    {
+      using Range = ezy::experimental::keeper_value_type_t<Keeper>;
+
+      using iterator = md_blocked_iterator<iterator_type_t<Range>, Rank>;
+      using const_iterator = md_blocked_iterator<iterator_type_t<const Range>, Rank>;
+      using size_type = std::size_t;
+
+      constexpr iterator begin()
+      { return iterator(std::begin(range.get()), layout, tile, 0); }
+
+      constexpr iterator end()
+      { return iterator(std::begin(range.get()), layout, tile, layout.size()); }
+
+      constexpr const_iterator begin() const
+      { return const_iterator(std::begin(static_cast<const Range&>(range.get())), layout, tile, 0); }
+
+      constexpr const_iterator end() const
+      { return const_iterator(std::begin(static_cast<const Range&>(range.get())), layout, tile, layout.size()); }
+
+      constexpr size_type size() const
+      { return static_cast<size_type>(layout.size()); }
+
+      Keeper range;
+      md_layout<Rank> layout;
+      std::ptrdiff_t tile;
+    };
+
+    template <typename Keeper, std::size_t Rank>
+    struct md_range_view
+    {
+      using Range = ezy::experimental::keeper_value_type_t<Keeper>;
+      static_assert(is_random_access_range<Range>::value, "md_view needs a random access range");
+
+      using iterator = md_iterator<iterator_type_t<Range>, Rank>;
+      using const_iterator = md_iterator<iterator_type_t<const Range>, Rank>;
+      using size_type = std::size_t;
+
+      static constexpr std::size_t rank = Rank;
+
+      constexpr iterator begin()
+      { return iterator(std::begin(range.get()), layout, 0); }
+
+      constexpr iterator end()
+      { return iterator(std::begin(range.get()), layout, layout.size()); }
+
+      constexpr const_iterator begin() const
+      { return const_iterator(std::begin(static_cast<const Range&>(range.get())), layout, 0); }
+
+      constexpr const_iterator end() const
+      { return const_iterator(std::begin(static_cast<const Range&>(range.get())), layout, layout.size()); }
+
+      constexpr size_type size() const
+      { return static_cast<size_type>(layout.size()); }
+
+      constexpr size_type extent(std::size_t axis) const
+      { return static_cast<size_type>(layout.extents[axis]); }
+
+      constexpr std::ptrdiff_t stride(std::size_t axis) const
+      { return layout.strides[axis]; }
+
+      template <typename... Indices>
+      constexpr decltype(auto) operator()(Indices... indices)
+      { return *std::next(std::begin(range.get()), position_of(indices...)); }
+
+      template <typename... Indices>
+      constexpr decltype(auto) operator()(Indices... indices) const
+      { return *std::next(std::begin(static_cast<const Range&>(range.get())), position_of(indices...)); }
+
+      template <std::size_t Axis>
+      constexpr auto slice(std::size_t i) const &
+      { return rebind<md_range_view>(slice_layout<Axis>(layout, i)); }
+
+      template <std::size_t Axis>
+      constexpr auto slice(std::size_t i) &&
+      { return std::move(*this).template rebind<md_range_view>(slice_layout<Axis>(layout, i)); }
+
+      constexpr auto row(std::size_t i) const &
+      { return slice<0>(i); }
+
+      constexpr auto row(std::size_t i) &&
+      { return std::move(*this).template slice<0>(i); }
+
+      constexpr auto col(std::size_t j) const &
+      { return slice<Rank - 1>(j); }
+
+      constexpr auto col(std::size_t j) &&
+      { return std::move(*this).template slice<Rank - 1>(j); }
+
+      constexpr auto sub_block(const std::array<std::size_t, Rank>& first, const std::array<std::size_t, Rank>& extents) const &
+      { return rebind<md_range_view>(sub_block_layout(layout, first, extents)); }
+
+      constexpr auto sub_block(const std::array<std::size_t, Rank>& first, const std::array<std::size_t, Rank>& extents) &&
+      { return std::move(*this).template rebind<md_range_view>(sub_block_layout(layout, first, extents)); }
+
+      constexpr auto transposed() const &
+      { return rebind<md_range_view>(transposed_layout(layout)); }
+
+      constexpr auto transposed() &&
+      { return std::move(*this).template rebind<md_range_view>(transposed_layout(layout)); }
+
+      constexpr auto in_storage_order() const &
+      { return rebind<md_range_view>(storage_order_layout(layout)); }
+
+      constexpr auto in_storage_order() &&
+      { return std::move(*this).template rebind<md_range_view>(storage_order_layout(layout)); }
+
+      template <typename... Extents>
+      constexpr auto reshaped(Extents... extents) const &
+      { return rebind<md_range_view>(reshaped_layout(layout, make_extents(extents...))); }
+
+      template <typename... Extents>
+      constexpr auto reshaped(Extents... extents) &&
+      { return std::move(*this).template rebind<md_range_view>(reshaped_layout(layout, make_extents(extents...))); }
+
+      constexpr auto blocked(std::size_t tile) const &
+      { return rebind<md_blocked_view>(layout, checked_tile(tile)); }
+
+      constexpr auto blocked(std::size_t tile) &&
+      { return std::move(*this).template rebind<md_blocked_view>(layout, checked_tile(tile)); }
+
+      template <typename... Extents>
+      static constexpr std::array<std::ptrdiff_t, sizeof...(Extents)> make_extents(Extents... extents)
+      {
+        static_assert(sizeof...(Extents) > 0, "md_view: at least one extent is needed");
+        static_assert((std::is_integral<Extents>::value && ...), "md_view: extents must be integral");
+        return {static_cast<std::ptrdiff_t>(extents)...};
+      }
+
+      static constexpr std::ptrdiff_t checked_tile(std::size_t tile)
+      {
+        if (tile == 0)
+          throw_bounds_error("md_view: zero tile size");
+
+        return static_cast<std::ptrdiff_t>(tile);
+      }
+
+      template <typename... Indices>
+      constexpr std::ptrdiff_t position_of(Indices... indices) const
+      {
+        static_assert(sizeof...(Indices) == Rank, "md_view: one index is needed for each axis");
+        return layout.position_of({static_cast<std::ptrdiff_t>(indices)...});
+      }
+
+      // a view of the same range with an other layout: it refers to the range of this view, or takes it over
+      template <template <typename, std::size_t> class View, std::size_t NewRank, typename... Args>
+      constexpr auto rebind(const md_layout<NewRank>& new_layout, Args... args) const &
+      {
+        auto keeper = ezy::experimental::make_keeper(range.get());
+        return View<decltype(keeper), NewRank>{std::move(keeper), new_layout, args...};
+      }
+
+      template <template <typename, std::size_t> class View, std::size_t NewRank, typename... Args>
+      constexpr auto rebind(const md_layout<NewRank>& new_layout, Args... args) &&
+      {
+        return View<Keeper, NewRank>{std::move(range), new_layout, args...};
+      }
+
+      Keeper range;
+      md_layout<Rank> layout;
+    };
+  }
+
+  template <typename Range, typename... Extents>
+  constexpr auto md_view(Range&& range, Extents... extents)
+  {
+    using result_range_type = detail::md_range_view<detail::deduce_keeper_t<Range>, sizeof...(Extents)>;
+
+    const auto layout = detail::row_major_layout(result_range_type::make_extents(extents...), 0);
+    if (static_cast<std::ptrdiff_t>(ezy::size(range)) != layout.size())
+      detail::throw_bounds_error("md_view: extents do not match the size of the range");
+
+    return result_range_type{ezy::experimental::make_keeper(std::forward<Range>(range)), layout};
+  }
+}
+
+#endif
@@ -0,0 +1,1027 @@
+#ifndef EZY_PARALLEL_H_INCLUDED
+#define EZY_PARALLEL_H_INCLUDED
+
+#include "bits/algorithm.h"
+#include "bits/lookup.h" // is_random_access_iterator
+#include "bits/partition.h"
+#include "bits/sort.h"
+#include "experimental/keeper.h"
+#include "invoke.h"
+#include "range.h"
+
+#include <algorithm> // max, merge, min, sort, stable_sort
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional> // plus
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/**
+ * Parallel algorithms with dynamic load balancing
+ *
+ *   ezy::for_each(ezy::par_unseq_dynamic, range, fn)
+ *   ezy::accumulate(ezy::par_unseq_dynamic, range, init, op = std::plus<>{}) -> Init
+ *   ezy::collect<Result>(ezy::par_unseq_dynamic, range) -> Result
+ *   ezy::sorted(ezy::par_unseq_dynamic, range, compare = std::less<>{}) -> std::vector
+ *   ezy::stable_sorted(ezy::par_unseq_dynamic, range, compare = std::less<>{}) -> std::vector
+ *   ezy::sorted_by(ezy::par_unseq_dynamic, range, key_fn, compare = std::less<>{}) -> std::vector
+ *   ezy::partition_into<Result>(ezy::par_unseq_dynamic, range, predicate) -> std::pair<Result, Result>
+ *   ezy::bucketize<Result>(ezy::par_unseq_dynamic, range, bucket_count, key_fn, bounds policy) -> std::vector<Result>
+ *
+ * The range is split into units (elements, chunks, inner ranges, see splittable below), and the units are
+ * processed by a work stealing scheduler: each thread has a deque of intervals of units, it works on the back
+ * of its own, and steals from the front of the others' if its own is empty. Intervals are split lazily: a
+ * thread splits its interval in half only when its deque is empty, so there is always something to steal,
+ * but the range is not cut into pieces in advance. This balances the load even if the cost of the elements
+ * varies wildly (eg. filter or flatten over the nodes of a graph).
+ *
+ * - fn, op and the functions of the views are called concurrently, in unspecified order
+ * - accumulate: op must be associative, the elements must be convertible to Init; the partial results are
+ *   combined in the order of the elements
+ * - collect keeps the order of the elements
+ * - sorting: merge sort (radix sort for integral keys, see bits/sort.h), both are stable; the keys of
+ *   sorted_by are computed in parallel; small ranges are sorted by a single thread
+ * - partition_into, bucketize: the intervals are distributed into buckets of their own, then these are
+ *   appended to the result buckets in the order of the elements (the buckets are filled in parallel)
+ * - the first exception is rethrown (after every thread stopped)
+ * - ranges which cannot be split are processed sequentially, by the sequential algorithm
+ *
+ * par_unseq_dynamic_t{threads, grain}: the number of threads (0: std::thread::hardware_concurrency()), and
+ * the number of units processed between two checks for splitting (0: chosen by the number of units). The
+ * threads are started for each call, the calling thread is one of them.
+ */
+
+namespace ezy
+{
+  struct par_unseq_dynamic_t
+  {
+    unsigned threads{0};
+    std::size_t grain{0};
+  };
+
+  inline constexpr par_unseq_dynamic_t par_unseq_dynamic{};
+
+  /**
+   * splittable<Range>: the protocol of splitting a range into units
+   *
+   *   splittable<Range>::value: true if the range can be split
+   *   splittable<Range>::splitter(range) -> splitter, made once per algorithm call, with
+   *     size() -> the number of units
+   *     for_each_in(first, last, fn): calls fn with each element of the units in [first, last)
+   *
+   * Random access ranges (eg. containers, slices of them) are split by their elements. The views are split
+   * by the units of their underlying ranges:
+   * - transform, filter: by the units of the underlying range
+   * - zip: by the elements, if each range is random access
+   * - chunk: by the chunks, if the range is random access
+   * - flatten: by the elements, if both the outer and the inner ranges are random access (the sizes of the
+   *   inner ranges are summed up in advance), otherwise by the inner ranges
+   */
+  template <typename Range, typename>
+  struct splittable
+  {
+    static constexpr bool value =
+      detail::is_random_access_iterator<decltype(std::begin(std::declval<Range&>()))>::value;
+
+    template <typename R>
+    static auto splitter(R& range);
+  };
+
+  namespace detail
+  {
+    template <typename Range>
+    using is_splittable = ezy::splittable<ezy::remove_cvref_t<Range>>;
+
+    template <typename Range>
+    auto make_splitter(Range& range)
+    {
+      return is_splittable<Range>::splitter(range);
+    }
+
+    template <typename Iterator>
+    struct random_access_splitter
+    {
+      using difference_type = typename std::iterator_traits<Iterator>::difference_type;
+
+      Iterator first;
+      std::size_t count;
+
+      std::size_t size() const noexcept
+      { return count; }
+
+      template <typename Fn>
+      void for_each_in(std::size_t from, std::size_t until, Fn&& fn) const
+      {
+        const Iterator last = first + static_cast<difference_type>(until);
+        for (Iterator it = first + static_cast<difference_type>(from); it != last; ++it)
+          fn(*it);
+      }
+    };
+
+    template <typename Inner, typename Transformation>
+    struct transform_splitter
+    {
+      Inner inner;
+      Transformation& transformation;
+
+      std::size_t size() const noexcept
+      { return inner.size(); }
+
+      template <typename Fn>
+      void for_each_in(std::size_t from, std::size_t until, Fn&& fn) const
+      {
+        inner.for_each_in(from, until, [this, &fn](auto&& element)
+            {
+              fn(ezy::invoke(transformation, std::forward<decltype(element)>(element)));
+            });
+      }
+    };
+
+    template <typename Inner, typename Predicate>
+    struct filter_splitter
+    {
+      Inner inner;
+      Predicate& predicate;
+
+      std::size_t size() const noexcept
+      { return inner.size(); }
+
+      template <typename Fn>
+      void for_each_in(std::size_t from, std::size_t until, Fn&& fn) const
+      {
+        inner.for_each_in(from, until, [this, &fn](auto&& element)
+            {
+              if (ezy::invoke(predicate, element))
+                fn(std::forward<decltype(element)>(element));
+            });
+      }
+    };
+
+    template <typename Zipper, typename... Iterators>
+    struct zip_splitter
+    {
+      Zipper& zipper;
+      std::tuple<Iterators...> firsts;
+      std::size_t count;
+
+      std::size_t size() const noexcept
+      { return count; }
+
+      template <typename Fn>
+      void for_each_in(std::size_t from, std::size_t until, Fn&& fn) const
+      {
+        for (std::size_t i = from; i < until; ++i)
+        {
+          std::apply([this, &fn, i](const auto&... first)
+              {
+                fn(ezy::invoke(zipper, *(first + static_cast<std::ptrdiff_t>(i))...));
+              }, firsts);
+        }
+      }
+    };
+
+    template <typename Range>
+    struct chunk_splitter
+    {
+      using iterator = iterator_type_t<Range>;
+      using difference_type = typename std::iterator_traits<iterator>::difference_type;
+      using reference = typename chunk_iterator<Range>::reference;
+      using nested_iterator = take_iterator<Range>;
+
+      iterator first;
+      iterator last;
+      std::size_t elements;
+      std::size_t chunk_size;
+
+      std::size_t size() const noexcept
+      { return (elements + chunk_size - 1) / chunk_size; }
+
+      template <typename Fn>
+      void for_each_in(std::size_t from, std::size_t until, Fn&& fn) const
+      {
+        for (std::size_t i = from; i < until; ++i)
+        {
+          const iterator chunk_first = first + static_cast<difference_type>(i * chunk_size);
+          fn(reference{nested_iterator(chunk_first, chunk_size), nested_iterator(last, 0)});
+        }
+      }
+    };
+
+    // flatten by the elements: position of each inner range is the sum of the sizes of the previous ones
+    template <typename Range>
+    class flatten_elements_splitter
+    {
+      public:
+        using outer_iterator = iterator_type_t<Range>;
+
+        explicit flatten_elements_splitter(Range& range)
+          : outer(std::begin(range))
+        {
+          offsets.reserve(static_cast<std::size_t>(std::distance(std::begin(range), std::end(range))) + 1);
+          offsets.push_back(0);
+          for (auto it = std::begin(range); it != std::end(range); ++it)
+            offsets.push_back(offsets.back() + static_cast<std::size_t>(std::distance(std::begin(*it), std::end(*it))));
+        }
+
+        std::size_t size() const noexcept
+        { return offsets.back(); }
+
+        template <typename Fn>
+        void for_each_in(std::size_t from, std::size_t until, Fn&& fn) const
+        {
+          // the first inner range which ends after from (empty ones are skipped)
+          std::size_t k = static_cast<std::size_t>(
+              std::upper_bound(offsets.begin(), offsets.end(), from) - offsets.begin()) - 1;
+
+          for (std::size_t position = from; position < until; ++k)
+          {
+            auto&& inner = *(outer + static_cast<std::ptrdiff_t>(k));
+            const std::size_t last = std::min(until, offsets[k + 1]);
+            auto it = std::begin(inner) + static_cast<std::ptrdiff_t>(position - offsets[k]);
+            for (; position < last; ++position, ++it)
+              fn(*it);
+          }
+        }
+
+      private:
+        outer_iterator outer;
+        std::vector<std::size_t> offsets;
+    };
+
+    // flatten by the inner ranges
+    template <typename Outer>
+    struct flatten_splitter
+    {
+      Outer outer;
+
+      std::size_t size() const noexcept
+      { return outer.size(); }
+
+      template <typename Fn>
+      void for_each_in(std::size_t from, std::size_t until, Fn&& fn) const
+      {
+        outer.for_each_in(from, until, [&fn](auto&& inner)
+            {
+              for (auto&& element : inner)
+                fn(std::forward<decltype(element)>(element));
+            });
+      }
+    };
+  }
+
+  template <typename Range, typename Enable>
+  template <typename R>
+  auto splittable<Range, Enable>::splitter(R& range)
+  {
+    using std::begin;
+    using std::end;
+    auto first = begin(range);
+    return detail::random_access_splitter<decltype(first)>{
+      first, static_cast<std::size_t>(std::distance(first, end(range)))
+    };
+  }
+
+  template <typename Keeper, typename Transformation>
+  struct splittable<detail::range_view<Keeper, Transformation>>
+  {
+    using Range = ezy::experimental::keeper_value_type_t<Keeper>;
+    static constexpr bool value = detail::is_splittable<Range>::value;
+
+    static auto splitter(const detail::range_view<Keeper, Transformation>& view)
+    {
+      auto inner = detail::make_splitter(view.orig_range.get());
+      return detail::transform_splitter<decltype(inner), const Transformation>{
+        std::move(inner), view.transformation
+      };
+    }
+  };
+
+  template <typename Keeper, typename FilterPredicate>
+  struct splittable<detail::range_view_filter<Keeper, FilterPredicate>>
+  {
+    using Range = ezy::experimental::keeper_value_type_t<Keeper>;
+    static constexpr bool value = detail::is_splittable<Range>::value;
+
+    static auto splitter(const detail::range_view_filter<Keeper, FilterPredicate>& view)
+    {
+      auto inner = detail::make_splitter(view.orig_range.get());
+      return detail::filter_splitter<decltype(inner), const FilterPredicate>{
+        std::move(inner), view.predicate
+      };
+    }
+  };
+
+  template <typename Zipper, typename... Keepers>
+  struct splittable<detail::zip_range_view<Zipper, Keepers...>>
+  {
+    static constexpr bool value = (... && detail::is_random_access_iterator<
+        detail::const_iterator_type_t<ezy::experimental::keeper_value_type_t<Keepers>>
+      >::value);
+
+    static auto splitter(const detail::zip_range_view<Zipper, Keepers...>& view)
+    {
+      return std::apply([&view](const auto&... keepers)
+          {
+            return detail::zip_splitter<const Zipper, decltype(std::cbegin(keepers.get()))...>{
+              view.zipper,
+              std::make_tuple(std::cbegin(keepers.get())...),
+              std::min({static_cast<std::size_t>(std::distance(std::cbegin(keepers.get()), std::cend(keepers.get())))...})
+            };
+          }, view.keepers);
+    }
+  };
+
+  template <typename Keeper>
+  struct splittable<detail::chunk_range_view<Keeper>>
+  {
+    using Range = ezy::experimental::keeper_value_type_t<Keeper>;
+    static constexpr bool value = detail::is_random_access_iterator<detail::const_iterator_type_t<Range>>::value;
+
+    static auto splitter(const detail::chunk_range_view<Keeper>& view)
+    {
+      const Range& range = view.keeper.get();
+      return detail::chunk_splitter<const Range>{
+        std::begin(range),
+        std::end(range),
+        static_cast<std::size_t>(std::distance(std::begin(range), std::end(range))),
+        static_cast<std::size_t>(view.size)
+      };
+    }
+  };
+
+  template <typename Keeper>
+  struct splittable<detail::flattened_range_view<Keeper>>
+  {
+    using Range = ezy::experimental::keeper_value_type_t<Keeper>;
+    using outer_iterator = detail::const_iterator_type_t<Range>;
+    using inner_iterator = decltype(std::begin(*std::declval<outer_iterator>()));
+
+    static constexpr bool by_elements = detail::is_random_access_iterator<outer_iterator>::value
+      && std::is_lvalue_reference<decltype(*std::declval<outer_iterator>())>::value
+      && detail::is_random_access_iterator<inner_iterator>::value;
+
+    static constexpr bool value = detail::is_splittable<Range>::value;
+
+    static auto splitter(const detail::flattened_range_view<Keeper>& view)
+    {
+      if constexpr (by_elements)
+      {
+        return detail::flatten_elements_splitter<const Range>(view.range.get());
+      }
+      else
+      {
+        auto outer = detail::make_splitter(view.range.get());
+        return detail::flatten_splitter<decltype(outer)>{std::move(outer)};
+      }
+    }
+  };
+
+  namespace detail
+  {
+    struct unit_interval
+    {
+      std::size_t first;
+      std::size_t last;
+    };
+
+    // the owner works on the back, the thieves take from the front (the larger, older intervals)
+    class interval_deque
+    {
+      public:
+        void push(unit_interval interval)
+        {
+          std::lock_guard<std::mutex> lock(mutex);
+          intervals.push_back(interval);
+          count.store(intervals.size(), std::memory_order_relaxed);
+        }
+
+        bool pop(unit_interval& interval)
+        {
+          std::lock_guard<std::mutex> lock(mutex);
+          if (intervals.empty())
+            return false;
+
+          interval = intervals.back();
+          intervals.pop_back();
+          count.store(intervals.size(), std::memory_order_relaxed);
+          return true;
+        }
+
+        bool steal(unit_interval& interval)
+        {
+          if (empty())
+            return false;
+
+          std::lock_guard<std::mutex> lock(mutex);
+          if (intervals.empty())
+            return false;
+
+          interval = intervals.front();
+          intervals.pop_front();
+          count.store(intervals.size(), std::memory_order_relaxed);
+          return true;
+        }
+
+        bool empty() const noexcept
+        {
+          return count.load(std::memory_order_relaxed) == 0;
+        }
+
+      private:
+        std::mutex mutex;
+        std::deque<unit_interval> intervals;
+        std::atomic<std::size_t> count{0};
+    };
+
+    struct parallel_plan
+    {
+      unsigned threads;
+      std::size_t grain;
+    };
+
+    inline parallel_plan plan_parallel(const par_unseq_dynamic_t& policy, std::size_t units)
+    {
+      const unsigned available = policy.threads != 0
+        ? policy.threads
+        : std::max(1u, std::thread::hardware_concurrency());
+      const auto threads = static_cast<unsigned>(std::max<std::size_t>(1, std::min<std::size_t>(available, units)));
+      const std::size_t grain = policy.grain != 0 ? policy.grain : std::max<std::size_t>(1, units / (threads * 128));
+      return {threads, grain};
+    }
+
+    /**
+     * run_work_stealing(plan, units, body): calls body(first, last, worker) for disjoint intervals which cover
+     * [0, units), on plan.threads threads (worker is the index of the thread, in [0, plan.threads)).
+     */
+    template <typename Body>
+    void run_work_stealing(const parallel_plan& plan, std::size_t units, Body& body)
+    {
+      if (units == 0)
+        return;
+
+      if (plan.threads == 1)
+      {
+        body(std::size_t{0}, units, 0u);
+        return;
+      }
+
+      const unsigned threads = plan.threads;
+      const std::size_t grain = plan.grain;
+      const auto deques = std::make_unique<interval_deque[]>(threads);
+
+      // every thread starts with an equal share, the stealing balances the rest
+      for (unsigned w = 0; w < threads; ++w)
+        deques[w].push({units / threads * w, w + 1 == threads ? units : units / threads * (w + 1)});
+
+      std::atomic<std::size_t> remaining{units};
+      std::atomic<bool> failed{false};
+      std::mutex error_mutex;
+      std::exception_ptr error;
+
+      const auto steal = [&](unsigned self, unit_interval& interval)
+      {
+        for (unsigned k = 1; k < threads; ++k)
+        {
+          if (deques[(self + k) % threads].steal(interval))
+            return true;
+        }
+        return false;
+      };
+
+      const auto work = [&](unsigned self)
+      {
+        unit_interval current{};
+        while (remaining.load(std::memory_order_acquire) != 0 && !failed.load(std::memory_order_relaxed))
+        {
+          if (!deques[self].pop(current) && !steal(self, current))
+          {
+            std::this_thread::yield();
+            continue;
+          }
+
+          while (current.first != current.last && !failed.load(std::memory_order_relaxed))
+          {
+            // lazy binary splitting: half of the interval is offered to the thieves if there is nothing else
+            if (current.last - current.first > 2 * grain && deques[self].empty())
+            {
+              const std::size_t middle = current.first + (current.last - current.first) / 2;
+              deques[self].push({middle, current.last});
+              current.last = middle;
+            }
+
+            const std::size_t until = std::min(current.first + grain, current.last);
+            body(current.first, until, self);
+            remaining.fetch_sub(until - current.first, std::memory_order_acq_rel);
+            current.first = until;
+          }
+        }
+      };
+
+      const auto guarded_work = [&](unsigned self)
+      {
+#if defined(__cpp_exceptions) || defined(__EXCEPTIONS)
+        try
+        {
+          work(self);
+        }
+        catch (...)
+        {
+          std::lock_guard<std::mutex> lock(error_mutex);
+          if (!error)
+            error = std::current_exception();
+          failed.store(true, std::memory_order_relaxed);
+        }
+#else
+        work(self);
+#endif
+      };
+
+      std::vector<std::thread> helpers;
+      helpers.reserve(threads - 1);
+      for (unsigned w = 1; w < threads; ++w)
+        helpers.emplace_back(guarded_work, w);
+
+      guarded_work(0);
+      for (std::thread& helper : helpers)
+        helper.join();
+
+      if (error)
+        std::rethrow_exception(error);
+    }
+
+    // results of intervals, in the order of the intervals
+    template <typename T>
+    std::vector<std::pair<std::size_t, T>> merge_by_position(std::vector<std::vector<std::pair<std::size_t, T>>>& per_worker)
+    {
+      std::vector<std::pair<std::size_t, T>> merged;
+      for (auto& results : per_worker)
+        std::move(results.begin(), results.end(), std::back_inserter(merged));
+
+      std::sort(merged.begin(), merged.end(), [](const auto& lhs, const auto& rhs) { return lhs.first < rhs.first; });
+      return merged;
+    }
+  }
+
+  template <typename Range, typename UnaryFunction>
+  void for_each(par_unseq_dynamic_t policy, Range&& range, UnaryFunction&& fn)
+  {
+    if constexpr (detail::is_splittable<Range>::value)
+    {
+      const auto splitter = detail::make_splitter(range);
+      const auto plan = detail::plan_parallel(policy, splitter.size());
+      auto body = [&splitter, &fn](std::size_t first, std::size_t last, unsigned)
+      {
+        splitter.for_each_in(first, last, [&fn](auto&& element) { ezy::invoke(fn, std::forward<decltype(element)>(element)); });
+      };
+      detail::run_work_stealing(plan, splitter.size(), body);
+    }
+    else
+    {
+      ezy::for_each(range, fn);
+    }
+  }
+
+  template <typename Range, typename Init, typename BinaryOp = std::plus<>>
+  ezy::remove_cvref_t<Init> accumulate(par_unseq_dynamic_t policy, Range&& range, Init&& init, BinaryOp&& op = BinaryOp{})
+  {
+    using T = ezy::remove_cvref_t<Init>;
+    if constexpr (detail::is_splittable<Range>::value)
+    {
+      const auto splitter = detail::make_splitter(range);
+      const auto plan = detail::plan_parallel(policy, splitter.size());
+
+      std::vector<std::vector<std::pair<std::size_t, T>>> partials(plan.threads);
+      auto body = [&](std::size_t first, std::size_t last, unsigned worker)
+      {
+        std::optional<T> partial;
+        splitter.for_each_in(first, last, [&](auto&& element)
+            {
+              if (partial)
+                *partial = ezy::invoke(op, std::move(*partial), std::forward<decltype(element)>(element));
+              else
+                partial.emplace(std::forward<decltype(element)>(element));
+            });
+
+        if (partial)
+          partials[worker].emplace_back(first, std::move(*partial));
+      };
+      detail::run_work_stealing(plan, splitter.size(), body);
+
+      T result(std::forward<Init>(init));
+      for (auto& partial : detail::merge_by_position(partials))
+        result = ezy::invoke(op, std::move(result), std::move(partial.second));
+      return result;
+    }
+    else
+    {
+      return ezy::accumulate(range, std::forward<Init>(init), std::forward<BinaryOp>(op));
+    }
+  }
+
+  template <typename Result, typename Range>
+  Result collect(par_unseq_dynamic_t policy, Range&& range)
+  {
+    if constexpr (detail::is_splittable<Range>::value)
+    {
+      using Element = typename Result::value_type;
+      const auto splitter = detail::make_splitter(range);
+      const auto plan = detail::plan_parallel(policy, splitter.size());
+
+      std::vector<std::vector<std::pair<std::size_t, std::vector<Element>>>> fragments(plan.threads);
+      auto body = [&](std::size_t first, std::size_t last, unsigned worker)
+      {
+        std::vector<Element> fragment;
+        splitter.for_each_in(first, last, [&fragment](auto&& element)
+            {
+              fragment.emplace_back(std::forward<decltype(element)>(element));
+            });
+
+        if (!fragment.empty())
+          fragments[worker].emplace_back(first, std::move(fragment));
+      };
+      detail::run_work_stealing(plan, splitter.size(), body);
+
+      Result result;
+      for (auto& fragment : detail::merge_by_position(fragments))
+      {
+        for (Element& element : fragment.second)
+          detail::insert_back(result, std::move(element));
+      }
+      return result;
+    }
+    else
+    {
+      return ezy::collect<Result>(std::forward<Range>(range));
+    }
+  }
+
+  template <template <typename, typename ...> class ResultWrapper, typename Range>
+  auto collect(par_unseq_dynamic_t policy, Range&& range)
+  {
+    using std::begin;
+    using ElementType = detail::value_type_of_reference_t<decltype(*begin(range))>;
+    return collect<ResultWrapper<ElementType>>(policy, std::forward<Range>(range));
+  }
+
+  namespace detail
+  {
+    // below this size the elements are sorted by a single thread
+    constexpr std::size_t parallel_sort_threshold = std::size_t{1} << 14;
+
+    // elements to be sorted, collected in parallel (an rvalue std::vector is taken as it is)
+    template <typename Range>
+    std::vector<sorted_element_t<Range>> collect_for_sort(const par_unseq_dynamic_t& policy, Range&& range)
+    {
+      using Vector = std::vector<sorted_element_t<Range>>;
+      if constexpr (!std::is_lvalue_reference<Range>::value && std::is_same<ezy::remove_cvref_t<Range>, Vector>::value)
+        return Vector(std::move(range));
+      else
+        return ezy::collect<Vector>(policy, range);
+    }
+
+    // calls body(first, last) for blocks of the same size which cover [0, size), one block on each thread
+    template <typename Body>
+    void for_each_block(unsigned threads, std::size_t size, Body&& body)
+    {
+      const std::size_t block = (size + threads - 1) / threads;
+      auto run_blocks = [&](std::size_t first, std::size_t last, unsigned)
+      {
+        for (std::size_t b = first; b < last; ++b)
+          body(b, std::min(b * block, size), std::min((b + 1) * block, size));
+      };
+      run_work_stealing(parallel_plan{threads, 1}, threads, run_blocks);
+    }
+
+    /**
+     * parallel_radix_sort(threads, items, key_of): the LSD radix sort of bits/sort.h, each thread counts and
+     * scatters a block of the items; the blocks are written to disjoint parts of the buckets, so it is
+     * stable.
+     */
+    template <typename Item, typename KeyOf>
+    void parallel_radix_sort(unsigned threads, std::vector<Item>& items, KeyOf key_of)
+    {
+      using Key = decltype(key_of(items.front()));
+      using Counts = std::array<std::size_t, 256>;
+      constexpr std::size_t digits = sizeof(Key);
+
+      const std::size_t size = items.size();
+      std::vector<std::array<Counts, digits>> all_counts(threads);
+      for_each_block(threads, size, [&](std::size_t b, std::size_t first, std::size_t last)
+          {
+            auto& counts = all_counts[b];
+            counts = {};
+            for (std::size_t i = first; i < last; ++i)
+            {
+              const Key key = key_of(items[i]);
+              for (std::size_t d = 0; d < digits; ++d)
+                ++counts[d][(key >> (8 * d)) & 0xff];
+            }
+          });
+
+      std::vector<Item> buffer(size);
+      std::vector<Counts> offsets(threads);
+      for (std::size_t d = 0; d < digits; ++d)
+      {
+        std::size_t first_digit_count = 0;
+        const std::size_t first_digit = (key_of(items.front()) >> (8 * d)) & 0xff;
+        for (const auto& counts : all_counts)
+          first_digit_count += counts[d][first_digit];
+        if (first_digit_count == size)
+          continue;
+
+        // the blocks are permuted by the previous pass, their digits are counted again
+        if (d != 0)
+        {
+          for_each_block(threads, size, [&](std::size_t b, std::size_t first, std::size_t last)
+              {
+                Counts& counts = all_counts[b][d];
+                counts = {};
+                for (std::size_t i = first; i < last; ++i)
+                  ++counts[(key_of(items[i]) >> (8 * d)) & 0xff];
+              });
+        }
+
+        std::size_t offset = 0;
+        for (std::size_t digit = 0; digit < 256; ++digit)
+        {
+          for (unsigned b = 0; b < threads; ++b)
+          {
+            offsets[b][digit] = offset;
+            offset += all_counts[b][d][digit];
+          }
+        }
+
+        for_each_block(threads, size, [&](std::size_t b, std::size_t first, std::size_t last)
+            {
+              Counts& block_offsets = offsets[b];
+              for (std::size_t i = first; i < last; ++i)
+                buffer[block_offsets[(key_of(items[i]) >> (8 * d)) & 0xff]++] = std::move(items[i]);
+            });
+
+        items.swap(buffer);
+      }
+    }
+
+    // the number of elements taken from a, if the first k elements of the merge of a and b are taken (the
+    // equal elements are taken from a first, like std::merge does)
+    template <typename Iterator, typename Compare>
+    std::size_t merge_path_split(std::size_t k, Iterator a, std::size_t a_size, Iterator b, std::size_t b_size, Compare& compare)
+    {
+      std::size_t low = k > b_size ? k - b_size : 0;
+      std::size_t high = std::min(k, a_size);
+      while (low < high)
+      {
+        const std::size_t i = low + (high - low) / 2;
+        if (!compare(b[k - i - 1], a[i]))
+          low = i + 1;
+        else
+          high = i;
+      }
+      return low;
+    }
+
+    /**
+     * parallel_stable_sort(threads, elements, compare): merge sort; blocks (a few for each thread) are sorted
+     * by std::stable_sort, then the sorted runs are merged pairwise, in rounds, between elements and a
+     * buffer. Each merge is split into parts of the same output size by binary search on the merge path, so
+     * every thread works in the last rounds too.
+     */
+    template <typename T, typename Compare>
+    void parallel_stable_sort(unsigned threads, std::vector<T>& elements, Compare& compare)
+    {
+      const std::size_t size = elements.size();
+      const parallel_plan plan{threads, 1};
+      const std::size_t run = (size + threads * 4 - 1) / (threads * 4);
+      const std::size_t runs = (size + run - 1) / run;
+
+      auto sort_runs = [&](std::size_t first, std::size_t last, unsigned)
+      {
+        for (std::size_t r = first; r < last; ++r)
+          std::stable_sort(elements.begin() + r * run, elements.begin() + std::min((r + 1) * run, size), compare);
+      };
+      run_work_stealing(plan, runs, sort_runs);
+
+      std::vector<T> buffer(size);
+      std::vector<T>* source = &elements;
+      std::vector<T>* target = &buffer;
+      for (std::size_t width = run; width < size; width *= 2)
+      {
+        const std::size_t merges = (size + 2 * width - 1) / (2 * width);
+        const std::size_t parts = (threads * 4 + merges - 1) / merges;
+
+        auto merge_parts = [&](std::size_t first, std::size_t last, unsigned)
+        {
+          for (std::size_t unit = first; unit < last; ++unit)
+          {
+            const std::size_t low = unit / parts * 2 * width;
+            const std::size_t middle = std::min(low + width, size);
+            const std::size_t high = std::min(low + 2 * width, size);
+            const std::size_t part = unit % parts;
+            const std::size_t out_first = (high - low) * part / parts;
+            const std::size_t out_last = (high - low) * (part + 1) / parts;
+
+            const auto a = source->begin() + static_cast<std::ptrdiff_t>(low);
+            const auto b = source->begin() + static_cast<std::ptrdiff_t>(middle);
+            const std::size_t a_first = merge_path_split(out_first, a, middle - low, b, high - middle, compare);
+            const std::size_t a_last = merge_path_split(out_last, a, middle - low, b, high - middle, compare);
+
+            std::merge(
+                std::make_move_iterator(a + a_first), std::make_move_iterator(a + a_last),
+                std::make_move_iterator(b + (out_first - a_first)), std::make_move_iterator(b + (out_last - a_last)),
+                target->begin() + low + out_first,
+                compare);
+          }
+        };
+        run_work_stealing(plan, merges * parts, merge_parts);
+        std::swap(source, target);
+      }
+
+      if (source != &elements)
+        elements.swap(buffer);
+    }
+
+    template <typename T>
+    constexpr bool parallel_sortable = std::is_default_constructible<T>::value && std::is_move_assignable<T>::value;
+
+    template <typename T, typename Compare>
+    void parallel_sort_elements(const par_unseq_dynamic_t& policy, std::vector<T>& elements, Compare& compare)
+    {
+      const unsigned threads = plan_parallel(policy, elements.size() / parallel_sort_threshold).threads;
+      if constexpr (parallel_sortable<T>)
+      {
+        if (threads > 1)
+        {
+          if constexpr (is_default_order<Compare>::value && radix_key<T>::value)
+            parallel_radix_sort(threads, elements, [](const T& t) { return radix_key<T>::get(t); });
+          else
+            parallel_stable_sort(threads, elements, compare);
+          return;
+        }
+      }
+      sort_elements(elements, compare, true);
+    }
+  }
+
+  template <typename Range, typename Compare = std::less<>>
+  std::vector<detail::sorted_element_t<Range>> sorted(par_unseq_dynamic_t policy, Range&& range, Compare compare = Compare{})
+  {
+    auto elements = detail::collect_for_sort(policy, std::forward<Range>(range));
+    detail::parallel_sort_elements(policy, elements, compare);
+    return elements;
+  }
+
+  template <typename Range, typename Compare = std::less<>>
+  std::vector<detail::sorted_element_t<Range>> stable_sorted(par_unseq_dynamic_t policy, Range&& range, Compare compare = Compare{})
+  {
+    auto elements = detail::collect_for_sort(policy, std::forward<Range>(range));
+    detail::parallel_sort_elements(policy, elements, compare);
+    return elements;
+  }
+
+  template <typename Range, typename KeyFn, typename Compare = std::less<>>
+  std::vector<detail::sorted_element_t<Range>> sorted_by(par_unseq_dynamic_t policy, Range&& range, KeyFn key_fn, Compare compare = Compare{})
+  {
+    using Key = detail::sort_key_t<Range, KeyFn>;
+    using T = detail::sorted_element_t<Range>;
+    using Keyed = detail::keyed_positions_t<Key>;
+
+    auto elements = detail::collect_for_sort(policy, std::forward<Range>(range));
+    const unsigned threads = detail::plan_parallel(policy, elements.size() / detail::parallel_sort_threshold).threads;
+    if constexpr (detail::parallel_sortable<typename Keyed::value_type>)
+    {
+      if (threads > 1)
+      {
+        Keyed keyed(elements.size());
+        detail::for_each_block(threads, elements.size(), [&](std::size_t, std::size_t first, std::size_t last)
+            {
+              for (std::size_t i = first; i < last; ++i)
+                keyed[i] = {detail::make_key<Key>(elements[i], key_fn), i};
+            });
+
+        if constexpr (detail::is_default_order<Compare>::value && detail::radix_key<Key>::value)
+        {
+          detail::parallel_radix_sort(threads, keyed, [](const auto& k) { return k.first; });
+        }
+        else
+        {
+          auto compare_keys = [&compare](const auto& lhs, const auto& rhs) { return compare(lhs.first, rhs.first); };
+          detail::parallel_stable_sort(threads, keyed, compare_keys);
+        }
+
+        if constexpr (detail::parallel_sortable<T>)
+        {
+          std::vector<T> result(elements.size());
+          detail::for_each_block(threads, elements.size(), [&](std::size_t, std::size_t first, std::size_t last)
+              {
+                for (std::size_t i = first; i < last; ++i)
+                  result[i] = std::move(elements[keyed[i].second]);
+              });
+          return result;
+        }
+        else
+        {
+          return detail::permute(elements, keyed);
+        }
+      }
+    }
+    return ezy::sorted_by(std::move(elements), std::move(key_fn), std::move(compare));
+  }
+
+  namespace detail
+  {
+    /**
+     * parallel_distribute(policy, range, buckets, key_of) -> bool: each interval of units is distributed into
+     * buckets of its own, then the result buckets are reserved to their final size and filled in parallel (one
+     * thread fills a bucket from the intervals, in their order). Gives back false if there were keys out of
+     * range, like distribute.
+     */
+    template <typename Range, typename Bucket, typename KeyOf>
+    bool parallel_distribute(const par_unseq_dynamic_t& policy, Range&& range, std::vector<Bucket>& buckets, KeyOf& key_of)
+    {
+      if constexpr (is_splittable<Range>::value)
+      {
+        using Element = typename Bucket::value_type;
+        const std::size_t bucket_count = buckets.size();
+        const auto splitter = make_splitter(range);
+        const auto plan = plan_parallel(policy, splitter.size());
+
+        std::vector<std::vector<std::pair<std::size_t, std::vector<std::vector<Element>>>>> fragments(plan.threads);
+        std::atomic<bool> valid{true};
+        auto body = [&](std::size_t first, std::size_t last, unsigned worker)
+        {
+          std::vector<std::vector<Element>> local(bucket_count);
+          splitter.for_each_in(first, last, [&](auto&& element)
+              {
+                const std::size_t key = static_cast<std::size_t>(key_of(element));
+                if (is_valid_bucket(key, bucket_count))
+                  local[key].emplace_back(forward_element<Range>(element));
+                else
+                  valid.store(false, std::memory_order_relaxed);
+              });
+          fragments[worker].emplace_back(first, std::move(local));
+        };
+        run_work_stealing(plan, splitter.size(), body);
+
+        auto merged = merge_by_position(fragments);
+        auto fill = [&](std::size_t first, std::size_t last, unsigned)
+        {
+          for (std::size_t b = first; b < last; ++b)
+          {
+            if constexpr (has_reserve<Bucket>::value)
+            {
+              std::size_t size = buckets[b].size();
+              for (const auto& fragment : merged)
+                size += fragment.second[b].size();
+              buckets[b].reserve(size);
+            }
+
+            for (auto& fragment : merged)
+            {
+              for (Element& element : fragment.second[b])
+                insert_back(buckets[b], std::move(element));
+            }
+          }
+        };
+        run_work_stealing(parallel_plan{plan.threads, 1}, bucket_count, fill);
+        return valid.load();
+      }
+      else
+      {
+        return distribute(std::forward<Range>(range), buckets, key_of);
+      }
+    }
+  }
+
+  template <typename Result = void, typename Range, typename Predicate>
+  std::pair<detail::bucket_t<Result, Range>, detail::bucket_t<Result, Range>>
+  partition_into(par_unseq_dynamic_t policy, Range&& range, Predicate&& predicate)
+  {
+    std::vector<detail::bucket_t<Result, Range>> buckets(2);
+    auto key_of = detail::make_partition_key(predicate);
+    detail::parallel_distribute(policy, std::forward<Range>(range), buckets, key_of);
+    return {std::move(buckets[0]), std::move(buckets[1])};
+  }
+
+  template <typename Result = void, typename Range, typename KeyFn, typename BoundsPolicy = bounds::default_t,
+           typename = std::enable_if_t<detail::is_bounds_policy<BoundsPolicy>::value>>
+  auto bucketize(par_unseq_dynamic_t policy, Range&& range, std::size_t bucket_count, KeyFn&& key_fn,
+      BoundsPolicy bounds_policy = {})
+  {
+    std::vector<detail::bucket_t<Result, Range>> buckets(bucket_count);
+    auto key_of = detail::make_bucket_key(key_fn);
+    const bool valid = detail::parallel_distribute(policy, std::forward<Range>(range), buckets, key_of);
+    return detail::make_bucketized(bounds_policy, valid, buckets);
+  }
+}
+
+#endif
@@ -0,0 +1,41 @@
+#ifndef EZY_QUANTITY_H_INCLUDED
+#define EZY_QUANTITY_H_INCLUDED
+
+#include "strong_type.h"
+#include "features/dimensional.h"
+
+namespace ezy
+{
+  /**
+   * quantity<T, Dimension>
+   *
+   * Strong type of `T` tagged by its dimension, eg.
+   *   quantity<double, si::length> / quantity<double, si::time> -> quantity<double, si::velocity>
+   */
+  template <typename T, typename Dimension>
+  using quantity = strong_type<T, Dimension, features::dimensional>;
+
+  namespace si
+  {
+    // exponents of: length, mass, time, electric current, temperature, amount of substance, luminous intensity
+    using dimensionless      = dimension<0, 0, 0, 0, 0, 0, 0>;
+    using length             = dimension<1, 0, 0, 0, 0, 0, 0>;
+    using mass               = dimension<0, 1, 0, 0, 0, 0, 0>;
+    using time               = dimension<0, 0, 1, 0, 0, 0, 0>;
+    using current            = dimension<0, 0, 0, 1, 0, 0, 0>;
+    using temperature        = dimension<0, 0, 0, 0, 1, 0, 0>;
+    using amount             = dimension<0, 0, 0, 0, 0, 1, 0>;
+    using luminous_intensity = dimension<0, 0, 0, 0, 0, 0, 1>;
+
+    using area         = dimension_product_t<length, length>;
+    using volume       = dimension_product_t<area, length>;
+    using frequency    = dimension_inverse_t<time>;
+    using velocity     = dimension_quotient_t<length, time>;
+    using acceleration = dimension_quotient_t<velocity, time>;
+    using force        = dimension_product_t<mass, acceleration>;
+    using energy       = dimension_product_t<force, length>;
+    using power        = dimension_quotient_t<energy, time>;
+  }
+}
+
+#endif
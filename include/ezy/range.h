@@ -5,14 +5,18 @@
 #include "experimental/keeper.h"
 #include "invoke.h"
 #include "bits/empty_size.h" // ezy::size
+#include "bits/instrument_hooks.h"
 
 #include <type_traits>
 #include <utility>
 #include <iterator>
 
 #include <cstddef>
+#include <cstdint>
 #include <tuple>
+#include <vector>
 #include <limits>
+#include <algorithm> // min
 
 namespace ezy
 {
@@ -36,10 +40,29 @@ namespace detail
   template <typename T>
   using iterator_type_t = typename iterator_type<T>::type;
 
+  /**
+   * value_type_of_reference: the value type belongs to a reference type, tuples of references (eg. zipped
+   * elements) are turned into tuples of values.
+   */
+  template <typename Reference>
+  struct value_type_of_reference
+  {
+    using type = ezy::remove_cvref_t<Reference>;
+  };
+
+  template <typename... Ts>
+  struct value_type_of_reference<std::tuple<Ts...>>
+  {
+    using type = std::tuple<ezy::remove_cvref_t<Ts>...>;
+  };
+
+  template <typename Reference>
+  using value_type_of_reference_t = typename value_type_of_reference<Reference>::type;
+
   template <typename T>
   struct value_type
   {
-    using type = ezy::remove_cvref_t<decltype(*std::begin(std::declval<T>()))>;
+    using type = value_type_of_reference_t<decltype(*std::begin(std::declval<T>()))>;
   };
 
   template <typename T>
@@ -82,15 +105,58 @@ namespace detail
 
 namespace ezy
 {
+  /**
+   * iterator_category of the iterators which can be advanced only once, like the ones of ezy::generator. It
+   * is an input iterator category, and the views keep it (where they would have input iterators anyway), so
+   * eg. chunk can tell that it must buffer the elements.
+   */
+  struct single_pass_iterator_tag : std::input_iterator_tag {};
+
+  // splitting of ranges for the parallel algorithms, see <ezy/parallel.h>
+  template <typename Range, typename = void>
+  struct splittable;
+
 namespace detail
 {
+  template <typename Iterator>
+  using is_single_pass_iterator = std::is_base_of<
+      single_pass_iterator_tag,
+      typename std::iterator_traits<Iterator>::iterator_category
+    >;
+
+  // drop, take and step_by jump in O(1) over random access ranges, and keep random access
+  template <typename Range>
+  using is_random_access_range = std::is_base_of<
+      std::random_access_iterator_tag,
+      typename std::iterator_traits<iterator_type_t<Range>>::iterator_category
+    >;
+
+  // the iterator n elements after the beginning of a random access range, or its end if it is shorter
+  template <typename Range, typename Size>
+  constexpr iterator_type_t<Range> advanced_begin(Range& range, Size n)
+  {
+    const auto first = std::begin(range);
+    const auto size = std::distance(first, std::end(range));
+    if (static_cast<std::uintmax_t>(size) <= static_cast<std::uintmax_t>(n))
+      return std::next(first, size);
+
+    return std::next(first, static_cast<decltype(size)>(n));
+  }
+
+  // Category, unless the iterators of the underlying range are single pass
+  template <typename Range, typename Category>
+  using view_iterator_category_t = std::conditional_t<
+      is_single_pass_iterator<iterator_type_t<Range>>::value,
+      single_pass_iterator_tag,
+      Category
+    >;
 
   /* Based on the post:  https://quuxplusone.github.io/blog/2019/02/06/arrow-proxy/ */
   template <typename T>
   struct arrow_proxy
   {
     T t;
-    T* operator->()
+    constexpr T* operator->()
     {
       return &t;
     }
@@ -116,6 +182,12 @@ namespace detail
           return *this;
       }
 
+      inline constexpr basic_iterator_adaptor& operator--()
+      {
+          --orig;
+          return *this;
+      }
+
       inline constexpr decltype(auto) operator*()
       {
         return *orig;
@@ -186,7 +258,7 @@ namespace detail
       }
 
       template <unsigned N, typename IterT>
-      void set_to(IterT&& it)
+      constexpr void set_to(IterT&& it)
       {
         get<N>() = std::forward<IterT>(it);
       }
@@ -223,35 +295,56 @@ namespace detail
    * pairs.
    */
 
+  // std::reference_wrapper is constexpr only from c++20
+  template <typename T>
+  class range_reference
+  {
+    public:
+      constexpr range_reference(T& t) noexcept
+        : pointer(&t)
+      {}
+
+      template <typename U, typename = std::enable_if_t<std::is_convertible<U*, T*>::value>>
+      constexpr range_reference(const range_reference<U>& other) noexcept
+        : pointer(&other.get())
+      {}
+
+      constexpr T& get() const noexcept
+      { return *pointer; }
+
+    private:
+      T* pointer;
+  };
+
   template <typename... Ranges>
   struct range_tracker
   {
     public:
       constexpr static auto size = sizeof...(Ranges);
 
-      range_tracker(Ranges&... ranges)
+      constexpr range_tracker(Ranges&... ranges)
         : ranges(ranges...)
         , current(std::begin(ranges)...)
       {}
 
-      range_tracker(Ranges&... ranges, end_marker_t&&)
+      constexpr range_tracker(Ranges&... ranges, end_marker_t&&)
         : ranges(ranges...)
         , current(std::end(ranges)...)
       {}
 
-      range_tracker(const range_tracker& rhs)
+      constexpr range_tracker(const range_tracker& rhs)
         : ranges(rhs.ranges)
         , current(rhs.current)
       {}
 
       template <typename... OtherRanges>
-      range_tracker(const range_tracker<OtherRanges...>& rhs)
+      constexpr range_tracker(const range_tracker<OtherRanges...>& rhs)
         : ranges(rhs.ranges)
         , current(rhs.current)
       {
       }
 
-      range_tracker& operator=(const range_tracker& rhs)
+      constexpr range_tracker& operator=(const range_tracker& rhs)
       {
         ezy::experimental::static_for<size>([this, rhs](auto i)
             {
@@ -262,7 +355,7 @@ namespace detail
       }
 
       template <unsigned N>
-      auto get()
+      constexpr auto get()
       {
         using it_type = decltype(std::get<N>(current));
         using end_it_type = decltype(std::end(std::get<N>(ranges).get()));
@@ -270,7 +363,7 @@ namespace detail
       }
 
       template <unsigned N>
-      auto get() const
+      constexpr auto get() const
       {
         using it_type = decltype(std::get<N>(current));
         using end_it_type = decltype(std::end(std::get<N>(ranges).get()));
@@ -278,25 +371,25 @@ namespace detail
       }
 
       template <unsigned N, typename ItT>
-      void set_to(ItT it)
+      constexpr void set_to(ItT it)
       {
         std::get<N>(current) = it;
       }
 
       template <unsigned N>
-      void set_to_begin()
+      constexpr void set_to_begin()
       {
         set_to<N>(std::begin(std::get<N>(ranges).get()));
       }
 
       template <unsigned N>
-      void set_to_end()
+      constexpr void set_to_end()
       {
         set_to<N>(std::end(std::get<N>(ranges).get()));
       }
 
       template <unsigned N>
-      decltype(auto) next()
+      constexpr decltype(auto) next()
       {
         return ++std::get<N>(current);
       }
@@ -307,7 +400,7 @@ namespace detail
       }
 
       template <unsigned N>
-      bool has_next() const
+      constexpr bool has_next() const
       {
         return std::get<N>(current) != std::end(std::get<N>(ranges).get());
       }
@@ -317,39 +410,105 @@ namespace detail
       template <typename RangeType>
       using const_it_type = ezy::detail::iterator_type_t<RangeType>; //typename RangeType::const_iterator;
 
-      std::tuple<std::reference_wrapper<Ranges>...> ranges;
+      std::tuple<range_reference<Ranges>...> ranges;
       std::tuple<const_it_type<Ranges>...> current;
   };
 
 
+  /**
+   * callable_ref refers to a function object stored elsewhere (typically in a view), so iterators do not
+   * need to carry a copy of it. Stateless function objects are stored by value instead, so they can be
+   * optimized out completely.
+   */
+  template <typename Fn, bool Stateless = std::is_empty<std::remove_const_t<Fn>>::value>
+  struct callable_ref
+  {
+    constexpr explicit callable_ref(Fn& f) noexcept
+      : fn(&f)
+    {}
+
+    constexpr Fn& get() const noexcept
+    { return *fn; }
+
+    Fn* fn;
+  };
+
+  template <typename Fn>
+  struct callable_ref<Fn, true> : private std::remove_const_t<Fn>
+  {
+    using base = std::remove_const_t<Fn>;
+
+    constexpr explicit callable_ref(Fn& f)
+      : base(f)
+    {}
+
+    constexpr Fn& get() const noexcept
+    { return const_cast<base&>(static_cast<const base&>(*this)); }
+  };
+
+  /**
+   * callable_copy keeps a copy of a function object which cannot be called through a const reference (eg. a
+   * mutable lambda), so each iterator calls its own copy, as the view itself is const.
+   */
+  template <typename Fn>
+  struct callable_copy
+  {
+    constexpr explicit callable_copy(const Fn& f)
+      : fn(f)
+    {}
+
+    constexpr Fn& get() noexcept
+    { return fn; }
+
+    constexpr const Fn& get() const noexcept
+    { return fn; }
+
+    Fn fn;
+  };
+
+  /**
+   * callable_holder_t: callable_ref if Fn can be called with Args as it is (const), callable_copy otherwise.
+   */
+  template <typename Fn, typename... Args>
+  using callable_holder_t = ezy::conditional_t<std::is_invocable<Fn&, Args...>::value,
+        callable_ref<Fn>,
+        callable_copy<std::remove_const_t<Fn>>
+      >;
+
+  /**
+   * The type of a function object member as it is seen through a const view: const, unless the member is a
+   * reference.
+   */
+  template <typename Fn>
+  using const_member_t = std::remove_reference_t<const Fn>;
+
+  /**
+   * iterator_adaptor
+   *
+   * The converter is kept in the view, the iterator only refers to it.
+   */
   template <typename orig_type,
            typename converter_type
            // , typename = IsFunction<converter_type>
            >
-  struct iterator_adaptor : basic_iterator_adaptor<orig_type>
+  struct iterator_adaptor
+    : basic_iterator_adaptor<orig_type>
+    , private callable_holder_t<converter_type, decltype(*std::declval<orig_type>())>
+    , private instrumented<iterator_adaptor<orig_type, converter_type>>
   {
     public:
       using base = basic_iterator_adaptor<orig_type>;
       using value_type = decltype(*std::declval<orig_type>());
-      using result_type = decltype(std::declval<converter_type>()(std::declval<value_type>()));
+      using converter_ref = callable_holder_t<converter_type, value_type>;
+      using result_type = decltype(std::declval<converter_ref&>().get()(std::declval<value_type>()));
 
-      // constructor
-      using base::basic_iterator_adaptor;
-
-      /*
-      iterator_adaptor(orig_type original, converter_type&& c)
+      constexpr iterator_adaptor(const orig_type& original, converter_type& c)
         : base(original)
-        , converter(std::move(c))
-      {}
-      */
-
-      constexpr iterator_adaptor(const orig_type& original, const converter_type& c)
-        : base(original)
-        , converter(c)
+        , converter_ref(c)
       {}
 
       inline constexpr iterator_adaptor operator+(int increment) const
-      { return iterator_adaptor(base::orig + increment); }
+      { return iterator_adaptor(base::orig + increment, converter_ref::get()); }
 
       inline constexpr iterator_adaptor& operator++()
       {
@@ -359,69 +518,92 @@ namespace detail
 
       constexpr result_type operator*()
       {
-        return converter(*(base::orig));
+        record<iterator_adaptor>(instrument::event::invocation);
+        return converter_ref::get()(*(base::orig));
       }
-
-    private:
-      converter_type converter;
   };
 
   /**
    * iterator_filter
+   *
+   * The predicate is kept in the view, and the end is taken from the range, so the iterator is not larger than
+   * the underlying iterator and a reference to the range (and to the predicate if it is not stateless).
    */
-  template <typename orig_type,
+  template <typename Range,
             typename predicate_type
            >
-  struct iterator_filter : basic_iterator_adaptor<orig_type>
+  struct iterator_filter : private instrumented<iterator_filter<Range, predicate_type>>
   {
     public:
-      using base = basic_iterator_adaptor<orig_type>;
-      using value_type = decltype(*std::declval<orig_type>());
-      using difference_type = typename base::difference_type;
-      using iterator_category = std::input_iterator_tag; // forward_iterator_tag?
-
-      // constructor
-      using base::basic_iterator_adaptor;
+      using orig_type = iterator_type_t<Range>;
+      using reference = decltype(*std::declval<orig_type>());
+      using value_type = ezy::remove_cvref_t<reference>;
+      using pointer = std::add_pointer_t<reference>;
+      using difference_type = typename std::iterator_traits<orig_type>::difference_type;
+      using iterator_category = view_iterator_category_t<Range, std::input_iterator_tag>; // forward_iterator_tag?
+      using predicate_holder = callable_holder_t<predicate_type, reference>;
 
+      constexpr iterator_filter(Range& range, predicate_type& p)
+        : storage(range_tracker<Range>(range), predicate_holder(p))
+      {
+        skip_rejected();
+      }
 
-      /*
-      iterator_filter(orig_type original, predicate_type&& p, const orig_type& end)
-        : base(original)
-        , converter(std::move(c))
+      constexpr iterator_filter(Range& range, predicate_type& p, end_marker_t)
+        : storage(range_tracker<Range>(range, end_marker_t{}), predicate_holder(p))
       {}
-      */
 
-      iterator_filter(orig_type original, const predicate_type& p, const orig_type& end)
-        : base(original)
-        , predicate(p)
-        , end_iterator(end)
+      constexpr inline iterator_filter& operator++()
       {
-        if (base::orig != end_iterator && !predicate(*base::orig))
-          operator++();
+        tracker().template next<0>();
+        skip_rejected();
+        return *this;
       }
 
-      inline iterator_filter& operator++()
+      constexpr reference operator*()
       {
-        ++base::orig;
-        for (; base::orig != end_iterator; ++base::orig)
-          if (predicate(*base::orig))
-            return *this;
+        return *current();
+      }
 
-        return *this;
+      constexpr bool operator==(const iterator_filter& rhs) const
+      { return current() == rhs.current(); }
+
+      constexpr bool operator!=(const iterator_filter& rhs) const
+      { return current() != rhs.current(); }
+
+    private:
+      constexpr range_tracker<Range>& tracker()
+      {
+        return std::get<0>(storage);
       }
 
-      value_type operator*()
+      constexpr orig_type& current()
       {
-        return *(base::orig);
+        return std::get<0>(tracker().current);
       }
 
-    private:
-      predicate_type predicate;
-      const orig_type end_iterator;
+      constexpr const orig_type& current() const
+      {
+        return std::get<0>(std::get<0>(storage).current);
+      }
+
+      constexpr void skip_rejected()
+      {
+        auto& predicate = std::get<1>(storage).get();
+        for (; tracker().template has_next<0>(); tracker().template next<0>())
+        {
+          record<iterator_filter>(instrument::event::invocation);
+          if (predicate(*current()))
+            return;
+        }
+      }
+
+      // tuple, so stateless predicates take no space
+      std::tuple<range_tracker<Range>, predicate_holder> storage;
   };
 
   template <typename first_range_type, typename second_range_type>
-  struct iterator_concatenator
+  struct iterator_concatenator : private instrumented<iterator_concatenator<first_range_type, second_range_type>>
   {
     public:
       using orig_type = const_iterator_type_t<first_range_type>;
@@ -433,15 +615,15 @@ namespace detail
 
       // constructor
 
-      iterator_concatenator(const first_range_type& fr, const second_range_type& sr)
+      constexpr iterator_concatenator(const first_range_type& fr, const second_range_type& sr)
         : tracker(fr, sr)
       {}
 
-      iterator_concatenator(const first_range_type& fr, const second_range_type& sr, end_marker_t&&)
+      constexpr iterator_concatenator(const first_range_type& fr, const second_range_type& sr, end_marker_t&&)
         : tracker(fr, sr, end_marker_t{})
       {}
 
-      inline iterator_concatenator& operator++()
+      constexpr inline iterator_concatenator& operator++()
       {
         {
           auto tracked = tracking_info<0>();
@@ -464,7 +646,7 @@ namespace detail
         return *this;
       }
 
-      auto operator*()
+      constexpr auto operator*()
       {
         auto tracked = tracking_info<0>();
         if (tracked.first != tracked.second)
@@ -475,7 +657,7 @@ namespace detail
         return *tracking_info<1>().first;
       }
 
-      bool operator==(const iterator_concatenator& rhs) const
+      constexpr bool operator==(const iterator_concatenator& rhs) const
       {
         {
           const auto tracked = tracking_info<0>();
@@ -505,19 +687,19 @@ namespace detail
         return !rhs.tracker.template has_next<1>();
       }
 
-      bool operator!=(const iterator_concatenator& rhs) const
+      constexpr bool operator!=(const iterator_concatenator& rhs) const
       {
         return !(*this == rhs);
       }
 
       template <unsigned N>
-      auto tracking_info()
+      constexpr auto tracking_info()
       {
         return tracker.template get<N>();
       }
 
       template <unsigned N>
-      auto tracking_info() const
+      constexpr auto tracking_info() const
       {
         return tracker.template get<N>();
       }
@@ -527,33 +709,33 @@ namespace detail
   };
 
   template <typename range_type>
-  struct iterator_flattener
+  struct iterator_flattener : private instrumented<iterator_flattener<range_type>>
   {
     public:
       using orig_iterator = iterator_type_t<range_type>;
       using inner_iterator = decltype(std::begin(*std::declval<orig_iterator>()));
 
-      using value_type = typename inner_iterator::value_type;
-      using difference_type = typename inner_iterator::difference_type;
-      using pointer = typename inner_iterator::pointer;
-      using reference = typename inner_iterator::reference;
+      using value_type = typename std::iterator_traits<inner_iterator>::value_type;
+      using difference_type = typename std::iterator_traits<inner_iterator>::difference_type;
+      using pointer = typename std::iterator_traits<inner_iterator>::pointer;
+      using reference = typename std::iterator_traits<inner_iterator>::reference;
       using iterator_category = std::forward_iterator_tag;
 
-      iterator_flattener(const range_type& range)
+      constexpr iterator_flattener(const range_type& range)
         : tracker(range)
       {
         if (tracker.template has_next<0>())
           inner = outer()->begin();
       }
 
-      iterator_flattener(const range_type& range, end_marker_t&&)
+      constexpr iterator_flattener(const range_type& range, end_marker_t&&)
         : tracker(range, end_marker_t{})
       {
         if (tracker.template has_next<0>())
           inner = outer()->end();
       }
 
-      iterator_flattener& operator++()
+      constexpr iterator_flattener& operator++()
       {
         ++inner;
         auto outer_tracked = tracker.template get<0>();
@@ -569,17 +751,17 @@ namespace detail
         return *this;
       }
 
-      const value_type& operator*() const
+      constexpr const value_type& operator*() const
       {
         return *inner;
       }
 
-      decltype(auto) operator*()
+      constexpr decltype(auto) operator*()
       {
         return *inner;
       }
 
-      friend bool operator==(const iterator_flattener& lhs, const iterator_flattener& rhs)
+      friend constexpr bool operator==(const iterator_flattener& lhs, const iterator_flattener& rhs)
       {
         const auto& lhs_tracker = lhs.tracker.template get<0>();
         const auto& rhs_tracker = rhs.tracker.template get<0>();
@@ -594,45 +776,58 @@ namespace detail
         return true;
       }
 
-      bool operator!=(const iterator_flattener& rhs) const
+      constexpr bool operator!=(const iterator_flattener& rhs) const
       {
         return !(*this == rhs);
       }
 
-      orig_iterator& outer()
+      constexpr orig_iterator& outer()
       {
         return tracker.template get<0>().first;
       }
 
     private:
         range_tracker<range_type> tracker;
-        inner_iterator inner;
+        inner_iterator inner{};
   };
 
+  template <typename... Iters>
+  using all_random_access = std::conjunction<
+    std::is_base_of<std::random_access_iterator_tag, typename std::iterator_traits<Iters>::iterator_category>...
+  >;
+
+  /**
+   * iterator_zipper
+   *
+   * The zipper itself is kept in the view, the iterator only refers to it.
+   *
+   * If every range is random access, the end iterator is positioned so all the underlying iterators reach
+   * their end at the same time (at the length of the shortest range), then only the first iterator is
+   * compared. Otherwise it stops at the first iterator reaching its end.
+   */
   template <typename Zipper, typename... Ranges>
-  struct iterator_zipper
+  struct iterator_zipper : private instrumented<iterator_zipper<Zipper, Ranges...>>
   {
     public:
-      using difference_type = size_t; // TODO what should it be?
-      using value_type = std::remove_reference_t<decltype(
-          ezy::invoke(std::declval<Zipper>(), (*std::begin(std::declval<Ranges>()))...)
-          )>;
+      using zipper_type = std::remove_reference_t<Zipper>;
+      using tracker_type = iterator_tracker_for<Ranges...>;
+      using reference = decltype(
+          ezy::invoke(std::declval<zipper_type&>(), (*std::begin(std::declval<Ranges&>()))...)
+          );
+      using value_type = value_type_of_reference_t<reference>;
+      using difference_type = std::ptrdiff_t;
       using pointer = std::add_pointer_t<value_type>;
-      using reference = std::add_lvalue_reference_t<value_type>;
       using iterator_category = std::input_iterator_tag; // forward_iterator_tag?
 
-      using DEBUG = std::tuple<Ranges...>;
-      using DEBUG2 = std::tuple<iterator_type_t<Ranges>...>;
-      using tracker_type = iterator_tracker_for<Ranges...>;
-
       static constexpr auto cardinality = sizeof...(Ranges);
+      static constexpr bool is_sized = all_random_access<iterator_type_t<Ranges>...>::value;
 
-      constexpr iterator_zipper(Zipper zipper, Ranges&... rs)
-        : storage(zipper, tracker_type::begin_from_ranges(rs...))
+      constexpr iterator_zipper(zipper_type& zipper, Ranges&... rs)
+        : storage(callable_ref<zipper_type>(zipper), tracker_type::begin_from_ranges(rs...))
       {}
 
-      constexpr iterator_zipper(Zipper zipper, Ranges&... rs, end_marker_t&&)
-        : storage(zipper, tracker_type::end_from_ranges(rs...))
+      constexpr iterator_zipper(zipper_type& zipper, Ranges&... rs, end_marker_t&&)
+        : storage(callable_ref<zipper_type>(zipper), end_from_ranges(rs...))
       {}
 
     private:
@@ -651,15 +846,30 @@ namespace detail
 
       constexpr decltype(auto) zipper()
       {
-        return std::get<zipper_index>(storage);
+        return std::get<zipper_index>(storage).get();
+      }
+
+      static constexpr tracker_type end_from_ranges(Ranges&... rs)
+      {
+        if constexpr (is_sized)
+        {
+          using std::begin;
+          using std::end;
+          const auto length = std::min({std::distance(begin(rs), end(rs))...});
+          const auto advanced = [length](auto it) { it += length; return it; };
+          return tracker_type(advanced(begin(rs))...);
+        }
+        else
+        {
+          return tracker_type::end_from_ranges(rs...);
+        }
       }
 
       template <size_t... Is>
-      constexpr auto deref_helper(std::index_sequence<Is...>)
+      constexpr decltype(auto) deref_helper(std::index_sequence<Is...>)
       {
-        return zipper()(
-            (*(tracker().template get<Is>()))...
-            );
+        record<iterator_zipper>(instrument::event::invocation);
+        return ezy::invoke(zipper(), (*(tracker().template get<Is>()))...);
       }
 
       template <size_t... Is>
@@ -673,7 +883,7 @@ namespace detail
       }
 
     public:
-      constexpr auto operator*()
+      constexpr reference operator*()
       {
         return deref_helper(std::make_index_sequence<cardinality>());
       }
@@ -686,7 +896,10 @@ namespace detail
 
       constexpr bool operator!=(const iterator_zipper& rhs) const
       {
-        return has_next_helper(tracker(), rhs.tracker(), std::make_index_sequence<cardinality>());
+        if constexpr (is_sized)
+          return tracker().template get<0>() != rhs.tracker().template get<0>();
+        else
+          return has_next_helper(tracker(), rhs.tracker(), std::make_index_sequence<cardinality>());
       }
 
       constexpr bool operator==(const iterator_zipper& rhs) const
@@ -695,7 +908,7 @@ namespace detail
       }
 
     private:
-      std::tuple<Zipper, tracker_type> storage;
+      std::tuple<callable_ref<zipper_type>, tracker_type> storage;
   };
 
 /*
@@ -708,7 +921,7 @@ namespace detail
       using difference_type = typename base::difference_type;
       using iterator_category = std::input_iterator_tag; // forward_iterator_tag?
 
-      iterator_group_adaptor(const orig_type& original, const orig_type::difference_type gs, const orig_type& end)
+      constexpr iterator_group_adaptor(const orig_type& original, const orig_type::difference_type gs, const orig_type& end)
         : base(original)
         , group_size(gs)
         , current_position(0)
@@ -716,7 +929,7 @@ namespace detail
     {
     }
 
-    inline iterator_group_adaptor& operator++()
+    constexpr inline iterator_group_adaptor& operator++()
     {
       const auto& target_position = (current_position + group_size)
       for (; (current_position < target_position); ++base::orig)
@@ -726,7 +939,7 @@ namespace detail
       return *this;
     }
 
-    value_type operator*()
+    constexpr value_type operator*()
     {
       return range_view_slice<orig_value_type>(base::orig);
     }
@@ -740,7 +953,7 @@ namespace detail
   */
 
   template <typename RangeType>
-  struct take_iterator
+  struct take_iterator : private instrumented<take_iterator<RangeType>>
   {
     public:
       using _orig_iterator = iterator_type_t<RangeType>;
@@ -749,7 +962,7 @@ namespace detail
       using value_type = typename _iter_traits::value_type;
       using pointer = typename _iter_traits::pointer;
       using reference = typename _iter_traits::reference;
-      using iterator_category = std::forward_iterator_tag; // ?? TODO use the origin
+      using iterator_category = view_iterator_category_t<RangeType, std::forward_iterator_tag>; // TODO use the origin
       using size_type = size_type_t<RangeType>;
 
       take_iterator() = default;
@@ -774,7 +987,7 @@ namespace detail
         , n(other.n)
       {}
 
-      take_iterator& operator=(const take_iterator& rhs)
+      constexpr take_iterator& operator=(const take_iterator& rhs)
       {
         tracker = rhs.tracker;
         n = rhs.n;
@@ -809,7 +1022,7 @@ namespace detail
   };
 
   template <typename RangeType, typename Predicate>
-  struct take_while_iterator
+  struct take_while_iterator : private instrumented<take_while_iterator<RangeType, Predicate>>
   {
     public:
       using _iter_traits = std::iterator_traits<iterator_type_t<RangeType>>;
@@ -817,61 +1030,74 @@ namespace detail
       using value_type = typename _iter_traits::value_type;
       using pointer = typename _iter_traits::pointer;
       using reference = typename _iter_traits::reference;
-      using iterator_category = std::forward_iterator_tag; // ??
+      using iterator_category = view_iterator_category_t<RangeType, std::forward_iterator_tag>; // ??
+      using predicate_holder = callable_holder_t<Predicate, reference>;
 
-      explicit take_while_iterator(RangeType& range, Predicate p)
-        : tracker(range)
-        , predicate(std::move(p))
+      constexpr explicit take_while_iterator(RangeType& range, Predicate& p)
+        : storage(range_tracker<RangeType>(range), predicate_holder(p))
       {
-        const auto tracked = tracker.template get<0>();
+        const auto tracked = tracker().template get<0>();
         const auto &it = tracked.first;
         const auto &end = tracked.second;
-        if (it != end && !predicate(*it))
-          tracker.template set_to<0>(end);
+        if (it == end)
+          return;
+
+        record<take_while_iterator>(instrument::event::invocation);
+        if (!predicate()(*it))
+          tracker().template set_to<0>(end);
       }
 
-      explicit take_while_iterator(RangeType& range, Predicate p, end_marker_t)
-        : tracker(range, end_marker_t{})
-        , predicate(std::move(p))
+      constexpr explicit take_while_iterator(RangeType& range, Predicate& p, end_marker_t)
+        : storage(range_tracker<RangeType>(range, end_marker_t{}), predicate_holder(p))
       {
       }
 
-      inline take_while_iterator& operator++()
+      constexpr inline take_while_iterator& operator++()
       {
-        tracker.template next<0>();
+        tracker().template next<0>();
 
-        const auto tracked = tracker.template get<0>();
+        const auto tracked = tracker().template get<0>();
         if (tracked.first == tracked.second)
           return *this;
 
-        if (!predicate(*tracked.first))
-          tracker.template set_to<0>(tracked.second);
+        record<take_while_iterator>(instrument::event::invocation);
+        if (!predicate()(*tracked.first))
+          tracker().template set_to<0>(tracked.second);
 
         return *this;
       }
 
-      decltype(auto) operator*()
+      constexpr decltype(auto) operator*()
       {
-        return *(tracker.template get<0>().first);
+        return *(tracker().template get<0>().first);
       }
 
-      bool operator!=(const take_while_iterator& rhs) const
+      constexpr bool operator!=(const take_while_iterator& rhs) const
       {
-        return tracker.template get<0>().first != rhs.tracker.template get<0>().first;
+        return tracker().template get<0>().first != rhs.tracker().template get<0>().first;
       }
 
-      bool operator==(const take_while_iterator& rhs) const
+      constexpr bool operator==(const take_while_iterator& rhs) const
       {
         return !(*this != rhs);
       }
 
     private:
-      range_tracker<RangeType> tracker;
-      Predicate predicate;
+      constexpr range_tracker<RangeType>& tracker()
+      { return std::get<0>(storage); }
+
+      constexpr const range_tracker<RangeType>& tracker() const
+      { return std::get<0>(storage); }
+
+      constexpr decltype(auto) predicate()
+      { return std::get<1>(storage).get(); }
+
+      // tuple, so stateless predicates take no space
+      std::tuple<range_tracker<RangeType>, predicate_holder> storage;
   };
 
   template <typename Range>
-  struct drop_iterator
+  struct drop_iterator : private instrumented<drop_iterator<Range>>
   {
     using _iter_traits = std::iterator_traits<iterator_type_t<Range>>;
     using difference_type = typename _iter_traits::difference_type;
@@ -926,7 +1152,7 @@ namespace detail
   };
 
   template <typename Range>
-  struct step_by_iterator
+  struct step_by_iterator : private instrumented<step_by_iterator<Range>>
   {
     using _iter_traits = std::iterator_traits<iterator_type_t<Range>>;
     using difference_type = typename _iter_traits::difference_type;
@@ -980,6 +1206,125 @@ namespace detail
     const size_type n{1};
   };
 
+  /**
+   * stride_iterator: every stride-th element of a random access range. The position is an index, so no
+   * iterator is formed past the end of the range, and it is random access itself.
+   */
+  template <typename Iterator>
+  struct stride_iterator
+  {
+    using difference_type = typename std::iterator_traits<Iterator>::difference_type;
+    using reference = decltype(*std::declval<Iterator&>());
+    using value_type = value_type_of_reference_t<reference>;
+    using pointer = std::add_pointer_t<reference>;
+    using iterator_category = std::random_access_iterator_tag;
+
+    constexpr stride_iterator(const Iterator& first, difference_type index, difference_type stride)
+      : first(first)
+      , index(index)
+      , stride(stride)
+    {}
+
+    constexpr reference operator*() const
+    {
+      return *std::next(first, index * stride);
+    }
+
+    constexpr reference operator[](difference_type n) const
+    {
+      return *std::next(first, (index + n) * stride);
+    }
+
+    constexpr stride_iterator& operator++()
+    {
+      ++index;
+      return *this;
+    }
+
+    constexpr stride_iterator operator++(int)
+    {
+      auto result = *this;
+      ++index;
+      return result;
+    }
+
+    constexpr stride_iterator& operator--()
+    {
+      --index;
+      return *this;
+    }
+
+    constexpr stride_iterator operator--(int)
+    {
+      auto result = *this;
+      --index;
+      return result;
+    }
+
+    constexpr stride_iterator& operator+=(difference_type n)
+    {
+      index += n;
+      return *this;
+    }
+
+    constexpr stride_iterator& operator-=(difference_type n)
+    {
+      index -= n;
+      return *this;
+    }
+
+    friend constexpr stride_iterator operator+(stride_iterator it, difference_type n)
+    { return it += n; }
+
+    friend constexpr stride_iterator operator+(difference_type n, stride_iterator it)
+    { return it += n; }
+
+    friend constexpr stride_iterator operator-(stride_iterator it, difference_type n)
+    { return it -= n; }
+
+    friend constexpr difference_type operator-(const stride_iterator& lhs, const stride_iterator& rhs)
+    { return lhs.index - rhs.index; }
+
+    friend constexpr bool operator==(const stride_iterator& lhs, const stride_iterator& rhs)
+    { return lhs.index == rhs.index; }
+
+    friend constexpr bool operator!=(const stride_iterator& lhs, const stride_iterator& rhs)
+    { return lhs.index != rhs.index; }
+
+    friend constexpr bool operator<(const stride_iterator& lhs, const stride_iterator& rhs)
+    { return lhs.index < rhs.index; }
+
+    friend constexpr bool operator>(const stride_iterator& lhs, const stride_iterator& rhs)
+    { return lhs.index > rhs.index; }
+
+    friend constexpr bool operator<=(const stride_iterator& lhs, const stride_iterator& rhs)
+    { return lhs.index <= rhs.index; }
+
+    friend constexpr bool operator>=(const stride_iterator& lhs, const stride_iterator& rhs)
+    { return lhs.index >= rhs.index; }
+
+    Iterator first;
+    difference_type index;
+    difference_type stride;
+  };
+
+  // step_by over a random access range: strided iterators, the number of elements is known in advance
+  template <typename Range>
+  constexpr stride_iterator<iterator_type_t<Range>> make_stride_iterator(Range& range, size_type_t<Range> n, end_marker_t)
+  {
+    using difference_type = typename stride_iterator<iterator_type_t<Range>>::difference_type;
+    const auto first = std::begin(range);
+    const auto stride = static_cast<difference_type>(n);
+    const auto size = std::distance(first, std::end(range));
+    return {first, (size + stride - 1) / stride, stride};
+  }
+
+  template <typename Range>
+  constexpr stride_iterator<iterator_type_t<Range>> make_stride_iterator(Range& range, size_type_t<Range> n)
+  {
+    return {std::begin(range), 0, static_cast<typename std::iterator_traits<iterator_type_t<Range>>::difference_type>(n)};
+  }
+
   /**
    * basic_range_view
    */
@@ -1003,7 +1348,7 @@ namespace detail
   {
     using Range = ezy::experimental::keeper_value_type_t<Keeper>;
     using _orig_const_iterator = const_iterator_type_t<Range>;
-    using const_iterator = iterator_adaptor<_orig_const_iterator, Transformation>;
+    using const_iterator = iterator_adaptor<_orig_const_iterator, const_member_t<Transformation>>;
     using size_type = size_type_t<Range>;
 
     constexpr const_iterator begin() const
@@ -1023,21 +1368,24 @@ namespace detail
   struct range_view_filter
   {
     using Range = ezy::experimental::keeper_value_type_t<Keeper>;
-    using const_iterator = iterator_filter<const_iterator_type_t<Range>, FilterPredicate>;
+    using const_iterator = iterator_filter<const Range, const_member_t<FilterPredicate>>;
     using size_type = size_type_t<Range>;
 
-    range_view_filter(Keeper&& keeper, FilterPredicate pred)
+    constexpr range_view_filter(Keeper&& keeper, FilterPredicate pred)
       : orig_range(std::move(keeper))
       , predicate(pred)
     {}
 
-    const_iterator begin() const
-    { return const_iterator(std::begin(orig_range.get()), predicate, std::end(orig_range.get())); }
+    constexpr const_iterator begin() const
+    { return const_iterator(orig_range.get(), predicate); }
 
-    const_iterator end() const
-    { return const_iterator(std::end(orig_range.get()), predicate, std::end(orig_range.get())); }
+    constexpr const_iterator end() const
+    { return const_iterator(orig_range.get(), predicate, end_marker_t{}); }
 
     private:
+      template <typename, typename>
+      friend struct ezy::splittable;
+
       Keeper orig_range;
       FilterPredicate predicate;
   };
@@ -1054,28 +1402,26 @@ namespace detail
       using difference_type = typename std::iterator_traits<const_iterator>::difference_type;
       using size_type = size_type_t<Range>; //difference_type; // TODO
 
-      range_view_slice(Keeper&& orig, size_type f, size_type u)
+      // Expects: f <= u (checked by ezy::slice according to its bounds policy)
+      constexpr range_view_slice(Keeper&& orig, size_type f, size_type u)
         : orig_range(std::move(orig))
         , from(f)
         , until(u)
-      {
-        if (from > until)
-          throw std::logic_error("logic error"); // programming error
-      }
+      {}
 
-      const_iterator begin() const
+      constexpr const_iterator begin() const
       { return const_iterator(std::next(std::begin(orig_range.get()), bounded(from))); }
 
-      const_iterator end() const
+      constexpr const_iterator end() const
       { return const_iterator(std::next(std::begin(orig_range.get()), bounded(until))); }
 
     private:
-      difference_type get_range_size() const
+      constexpr difference_type get_range_size() const
       {
         return std::distance(std::begin(orig_range.get()), std::end(orig_range.get()));
       }
 
-      difference_type bounded(difference_type difference) const
+      constexpr difference_type bounded(difference_type difference) const
       {
         return std::min(get_range_size(), difference);
       }
@@ -1092,7 +1438,7 @@ namespace detail
     using const_iterator = typename Range::const_iterator;
     using difference_type = typename const_iterator::difference_type;
 
-    group_range_view(const Range& orig, difference_type size)
+    constexpr group_range_view(const Range& orig, difference_type size)
       : base(orig)
       , group_size(size)
     {
@@ -1115,10 +1461,10 @@ namespace detail
       using difference_type = typename const_iterator::difference_type;
       using size_type = size_type_t<Range1>;
 
-      const_iterator begin() const
+      constexpr const_iterator begin() const
       { return const_iterator(range1.get(), range2.get()); }
 
-      const_iterator end() const
+      constexpr const_iterator end() const
       { return const_iterator(range1.get(), range2.get(), end_marker_t{}); }
 
     public:
@@ -1134,7 +1480,7 @@ namespace detail
       using KeepersTuple = std::tuple<Keepers...>;
 
       using iterator = iterator_zipper<Zipper, ezy::experimental::keeper_value_type_t<Keepers>...>;
-      using const_iterator = iterator_zipper<Zipper, const ezy::experimental::keeper_value_type_t<Keepers>...>;
+      using const_iterator = iterator_zipper<const Zipper, const ezy::experimental::keeper_value_type_t<Keepers>...>;
       using difference_type = typename const_iterator::difference_type;
       using value_type = typename const_iterator::value_type;
       using size_type = size_t;
@@ -1145,77 +1491,29 @@ namespace detail
         , keepers{std::move(keepers)...}
       {}
 
-      template <size_t... Is>
-      constexpr static const_iterator get_begin_helper(
-          Zipper zipper,
-          const KeepersTuple& keepers,
-          std::index_sequence<Is...>
-        )
-      {
-        return const_iterator(zipper, std::get<Is>(keepers).get()...);
-      }
-
-      template <size_t... Is>
-      constexpr static iterator get_begin_helper(
-          Zipper zipper,
-          KeepersTuple& keepers,
-          std::index_sequence<Is...>
-        )
-      {
-        return iterator(zipper, std::get<Is>(keepers).get()...);
-      }
-
-      constexpr static const_iterator get_begin(Zipper zipper, const KeepersTuple& keepers)
+      template <typename Iterator, typename Z, typename KT, size_t... Is>
+      constexpr static Iterator get_begin_helper(Z& zipper, KT& keepers, std::index_sequence<Is...>)
       {
-        return get_begin_helper(zipper, keepers, std::make_index_sequence<std::tuple_size<KeepersTuple>::value>());
+        return Iterator(zipper, std::get<Is>(keepers).get()...);
       }
 
-      constexpr static iterator get_begin(Zipper zipper, KeepersTuple& keepers)
+      template <typename Iterator, typename Z, typename KT, size_t... Is>
+      constexpr static Iterator get_end_helper(Z& zipper, KT& keepers, std::index_sequence<Is...>)
       {
-        return get_begin_helper(zipper, keepers, std::make_index_sequence<std::tuple_size<KeepersTuple>::value>());
-      }
-
-      template <size_t... Is>
-      constexpr static const_iterator get_end_helper(
-          Zipper zipper,
-          const KeepersTuple& keepers,
-          std::index_sequence<Is...>
-        )
-      {
-        return const_iterator(zipper, std::get<Is>(keepers).get()..., end_marker_t{});
-      }
-
-      template <size_t... Is>
-      constexpr static iterator get_end_helper(
-          Zipper zipper,
-          KeepersTuple& keepers,
-          std::index_sequence<Is...>
-        )
-      {
-        return iterator(zipper, std::get<Is>(keepers).get()..., end_marker_t{});
-      }
-
-      constexpr static const_iterator get_end(Zipper zipper, const KeepersTuple& keepers)
-      {
-        return get_end_helper(zipper, keepers, std::make_index_sequence<std::tuple_size<KeepersTuple>::value>());
-      }
-
-      constexpr static iterator get_end(Zipper zipper, KeepersTuple& keepers)
-      {
-        return get_end_helper(zipper, keepers, std::make_index_sequence<std::tuple_size<KeepersTuple>::value>());
+        return Iterator(zipper, std::get<Is>(keepers).get()..., end_marker_t{});
       }
 
       constexpr const_iterator begin() const
-      { return get_begin(zipper, keepers); }
+      { return get_begin_helper<const_iterator>(zipper, keepers, std::index_sequence_for<Keepers...>()); }
 
       constexpr const_iterator end() const
-      { return get_end(zipper, keepers); }
+      { return get_end_helper<const_iterator>(zipper, keepers, std::index_sequence_for<Keepers...>()); }
 
       constexpr iterator begin()
-      { return get_begin(zipper, keepers); }
+      { return get_begin_helper<iterator>(zipper, keepers, std::index_sequence_for<Keepers...>()); }
 
       constexpr iterator end()
-      { return get_end(zipper, keepers); }
+      { return get_end_helper<iterator>(zipper, keepers, std::index_sequence_for<Keepers...>()); }
 
     public:
     //private:
@@ -1234,22 +1532,22 @@ namespace detail
 
       using size_type = typename Range::size_type;
 
-      const_iterator begin() const
+      constexpr const_iterator begin() const
       {
         return const_iterator(range.get());
       }
 
-      const_iterator end() const
+      constexpr const_iterator end() const
       {
         return const_iterator(range.get(), end_marker_t{});
       }
 
-      iterator begin()
+      constexpr iterator begin()
       {
         return iterator(range.get());
       }
 
-      iterator end()
+      constexpr iterator end()
       {
         return iterator(range.get(), end_marker_t{});
       }
@@ -1258,98 +1556,155 @@ namespace detail
       Keeper range;
   };
 
+  template <typename Range>
+  using take_iterator_for = ezy::conditional_t<is_random_access_range<Range>::value,
+        iterator_type_t<Range>,
+        take_iterator<Range>
+      >;
+
+  // over random access ranges: the iterators of the range, the end is found in O(1)
   template <typename Keeper>
   struct take_n_range_view
   {
     public:
       using Range = ezy::experimental::keeper_value_type_t<Keeper>;
 
-      using iterator = take_iterator<Range>;
-      using const_iterator = take_iterator<const Range>;
+      using iterator = take_iterator_for<Range>;
+      using const_iterator = take_iterator_for<const Range>;
       using size_type = size_type_t<Range>;
 
       constexpr iterator begin()
       {
-        return iterator(range.get(), n);
+        if constexpr (is_random_access_range<Range>::value)
+          return std::begin(range.get());
+        else
+          return iterator(range.get(), n);
       }
 
       constexpr iterator end()
       {
-        return iterator(range.get(), end_marker_t{});
+        if constexpr (is_random_access_range<Range>::value)
+          return advanced_begin(range.get(), n);
+        else
+          return iterator(range.get(), end_marker_t{});
       }
 
       constexpr const_iterator begin() const
       {
-        return const_iterator(range.get(), n);
+        if constexpr (is_random_access_range<const Range>::value)
+          return std::begin(static_cast<const Range&>(range.get()));
+        else
+          return const_iterator(range.get(), n);
       }
 
       constexpr const_iterator end() const
       {
-        return const_iterator(range.get(), end_marker_t{});
+        if constexpr (is_random_access_range<const Range>::value)
+          return advanced_begin(static_cast<const Range&>(range.get()), n);
+        else
+          return const_iterator(range.get(), end_marker_t{});
       }
 
       Keeper range;
       size_type n;
   };
 
+  template <typename Range>
+  using drop_iterator_for = ezy::conditional_t<is_random_access_range<Range>::value,
+        iterator_type_t<Range>,
+        drop_iterator<Range>
+      >;
+
+  // over random access ranges: the iterators of the range, the beginning is found in O(1)
   template <typename Keeper>
   struct drop_range_view
   {
     using Range = ezy::experimental::keeper_value_type_t<Keeper>;
-    using const_iterator = drop_iterator<const Range>;
-    using iterator = drop_iterator<Range>;
+    using const_iterator = drop_iterator_for<const Range>;
+    using iterator = drop_iterator_for<Range>;
     using size_type = size_type_t<Range>;
 
     constexpr const_iterator begin() const
     {
-      return const_iterator(range.get(), n);
+      if constexpr (is_random_access_range<const Range>::value)
+        return advanced_begin(static_cast<const Range&>(range.get()), n);
+      else
+        return const_iterator(range.get(), n);
     }
 
     constexpr const_iterator end() const
     {
-      return const_iterator(range.get(), end_marker_t{});
+      if constexpr (is_random_access_range<const Range>::value)
+        return std::end(static_cast<const Range&>(range.get()));
+      else
+        return const_iterator(range.get(), end_marker_t{});
     }
 
     constexpr iterator begin()
     {
-      return iterator(range.get(), n);
+      if constexpr (is_random_access_range<Range>::value)
+        return advanced_begin(range.get(), n);
+      else
+        return iterator(range.get(), n);
     }
 
     constexpr iterator end()
     {
-      return iterator(range.get(), end_marker_t{});
+      if constexpr (is_random_access_range<Range>::value)
+        return std::end(range.get());
+      else
+        return iterator(range.get(), end_marker_t{});
     }
 
     Keeper range;
     const size_type n;
   };
 
+  template <typename Range>
+  using step_by_iterator_for = ezy::conditional_t<is_random_access_range<Range>::value,
+        stride_iterator<iterator_type_t<Range>>,
+        step_by_iterator<Range>
+      >;
+
+  // over random access ranges: stride_iterators
   template <typename Keeper>
   struct step_by_range_view
   {
     using Range = ezy::experimental::keeper_value_type_t<Keeper>;
-    using const_iterator = step_by_iterator<const Range>;
-    using iterator = step_by_iterator<Range>;
+    using const_iterator = step_by_iterator_for<const Range>;
+    using iterator = step_by_iterator_for<Range>;
     using size_type = size_type_t<Range>;
 
     constexpr const_iterator begin() const
     {
-      return const_iterator(keeper.get(), n);
+      if constexpr (is_random_access_range<const Range>::value)
+        return make_stride_iterator(static_cast<const Range&>(keeper.get()), n);
+      else
+        return const_iterator(keeper.get(), n);
     }
 
     constexpr const_iterator end() const
     {
-      return const_iterator(keeper.get(), end_marker_t{});
+      if constexpr (is_random_access_range<const Range>::value)
+        return make_stride_iterator(static_cast<const Range&>(keeper.get()), n, end_marker_t{});
+      else
+        return const_iterator(keeper.get(), end_marker_t{});
     }
 
     constexpr iterator begin()
     {
-      return iterator(keeper.get(), n);
+      if constexpr (is_random_access_range<Range>::value)
+        return make_stride_iterator(keeper.get(), n);
+      else
+        return iterator(keeper.get(), n);
     }
 
     constexpr iterator end()
     {
-      return iterator(keeper.get(), end_marker_t{});
+      if constexpr (is_random_access_range<Range>::value)
+        return make_stride_iterator(keeper.get(), n, end_marker_t{});
+      else
+        return iterator(keeper.get(), end_marker_t{});
     }
 
     Keeper keeper;
@@ -1362,25 +1717,25 @@ namespace detail
     public:
       using Range = ezy::experimental::keeper_value_type_t<Keeper>;
       using iterator = take_while_iterator<Range, Predicate>;
-      using const_iterator = take_while_iterator<const Range, Predicate>;
+      using const_iterator = take_while_iterator<const Range, const Predicate>;
       using size_type = size_type_t<Range>;
 
-      iterator begin()
+      constexpr iterator begin()
       {
         return iterator(range.get(), pred);
       }
 
-      iterator end()
+      constexpr iterator end()
       {
         return iterator(range.get(), pred, end_marker_t{});
       }
 
-      const_iterator begin() const
+      constexpr const_iterator begin() const
       {
         return const_iterator(range.get(), pred);
       }
 
-      const_iterator end() const
+      constexpr const_iterator end() const
       {
         return const_iterator(range.get(), pred, end_marker_t{});
       }
@@ -1390,7 +1745,7 @@ namespace detail
   };
 
   template <typename T, typename Operation>
-  struct iterate_iterator
+  struct iterate_iterator : private instrumented<iterate_iterator<T, Operation>>
   {
     using difference_type = std::ptrdiff_t;
     using value_type = T;
@@ -1407,9 +1762,11 @@ namespace detail
       : storage(rhs.storage)
     {}
 
+    // element-wise, since the assignment of std::tuple is constexpr only from c++20
     constexpr iterate_iterator& operator=(const iterate_iterator& rhs)
     {
-      storage = rhs.storage;
+      std::get<0>(storage) = std::get<0>(rhs.storage);
+      std::get<1>(storage) = std::get<1>(rhs.storage);
       return *this;
     }
 
@@ -1434,6 +1791,7 @@ namespace detail
 
     constexpr iterate_iterator& operator++()
     {
+      record<iterate_iterator>(instrument::event::invocation);
       std::get<0>(storage) = ezy::invoke(std::get<1>(storage), std::get<0>(storage));
       return *this;
     }
@@ -1464,7 +1822,7 @@ namespace detail
   };
 
   template <typename Range>
-  struct cycle_iterator
+  struct cycle_iterator : private instrumented<cycle_iterator<Range>>
   {
     using orig_traits = std::iterator_traits<iterator_type_t<Range>>;
     using difference_type = typename orig_traits::difference_type;
@@ -1473,12 +1831,16 @@ namespace detail
     using reference = typename orig_traits::reference;
     using iterator_category = std::forward_iterator_tag;
 
-    decltype(auto) operator*()
+    constexpr explicit cycle_iterator(Range& range)
+      : tracker(range)
+    {}
+
+    constexpr decltype(auto) operator*()
     {
       return *(tracker.template get<0>().first);
     }
 
-    cycle_iterator& operator++()
+    constexpr cycle_iterator& operator++()
     {
       tracker.template next<0>();
       if (!tracker.template has_next<0>())
@@ -1488,7 +1850,7 @@ namespace detail
       return *this;
     }
 
-    bool operator!=(const cycle_iterator&) const
+    constexpr bool operator!=(const cycle_iterator&) const
     {
       return true;
     }
@@ -1506,24 +1868,24 @@ namespace detail
     using size_type = size_type_t<Range>;
 
     /*
-    iterator begin()
+    constexpr iterator begin()
     { return iterator{range.get()}; }
 
-    iterator end()
+    constexpr iterator end()
     { return iterator{range.get()}; }
     */
 
-    const_iterator begin() const
+    constexpr const_iterator begin() const
     { return const_iterator{range.get()}; }
 
-    const_iterator end() const
+    constexpr const_iterator end() const
     { return const_iterator{range.get()}; }
 
     Keeper range;
   };
 
   template <typename T>
-  struct repeat_iterator
+  struct repeat_iterator : private instrumented<repeat_iterator<T>>
   {
     using size_type = std::size_t;
     using difference_type = std::ptrdiff_t;
@@ -1532,7 +1894,11 @@ namespace detail
     using reference = T&;
     using iterator_category = std::forward_iterator_tag; // random_access
 
-    decltype(auto) operator*()
+    constexpr explicit repeat_iterator(const T& t)
+      : t(t)
+    {}
+
+    constexpr decltype(auto) operator*()
     {
       return t;
     }
@@ -1542,12 +1908,12 @@ namespace detail
       return t;
     }
 
-    repeat_iterator& operator++()
+    constexpr repeat_iterator& operator++()
     {
       return *this;
     }
 
-    bool operator!=(const repeat_iterator&) const
+    constexpr bool operator!=(const repeat_iterator&) const
     {
       return true;
     }
@@ -1564,10 +1930,10 @@ namespace detail
     using size_type = size_t;
 
 
-    const_iterator begin() const
+    constexpr const_iterator begin() const
     { return const_iterator{t}; }
 
-    const_iterator end() const
+    constexpr const_iterator end() const
     { return const_iterator{t}; }
 
     T t; // as keeper?
@@ -1581,29 +1947,29 @@ namespace detail
     Iter first;
     Sentinel last;
 
-    Iter begin()
+    constexpr Iter begin()
     {
       return first;
     }
 
-    Sentinel end()
+    constexpr Sentinel end()
     {
       return last;
     }
 
-    Iter begin() const
+    constexpr Iter begin() const
     {
       return first;
     }
 
-    Sentinel end() const
+    constexpr Sentinel end() const
     {
       return last;
     }
   };
 
   template <typename Range>
-  struct chunk_iterator
+  struct chunk_iterator : private instrumented<chunk_iterator<Range>>
   {
     using _iter_traits = std::iterator_traits<iterator_type_t<Range>>;
     using _nested_iterator = take_iterator<Range>;
@@ -1623,18 +1989,27 @@ namespace detail
       : tracker(range, end_marker_t{})
     {}
 
-    // same as step_by_iterator::op++
+    // same as step_by_iterator::op++, random access ranges jump
     constexpr chunk_iterator& operator++()
     {
-      size_type step = 0;
-      while (step++ < size && tracker.template has_next<0>())
+      if constexpr (is_random_access_range<Range>::value)
       {
-        tracker.template next<0>();
+        auto tracked = tracker.template get<0>();
+        const auto remaining = std::distance(tracked.first, tracked.second);
+        tracker.template set_to<0>(std::next(tracked.first, std::min(remaining, static_cast<decltype(remaining)>(size))));
+      }
+      else
+      {
+        size_type step = 0;
+        while (step++ < size && tracker.template has_next<0>())
+        {
+          tracker.template next<0>();
+        }
       }
       return *this;
     }
 
-    reference operator*()
+    constexpr reference operator*()
     {
       const auto tracked = tracker.template get<0>();
       return reference{
@@ -1643,7 +2018,7 @@ namespace detail
       };
     }
 
-    pointer operator->()
+    constexpr pointer operator->()
     {
       return pointer{operator*()};
     }
@@ -1662,12 +2037,88 @@ namespace detail
     size_type size{1};
   };
 
+  /**
+   * chunk of a single pass range: the elements of each chunk are collected into a vector, as the next chunk
+   * could not step over them again.
+   */
+  template <typename Range>
+  struct buffered_chunk_iterator : private instrumented<buffered_chunk_iterator<Range>>
+  {
+    using _iter_traits = std::iterator_traits<iterator_type_t<Range>>;
+    using difference_type = typename _iter_traits::difference_type;
+    using value_type = std::vector<value_type_of_reference_t<decltype(*std::declval<iterator_type_t<Range>&>())>>;
+    using reference = const value_type&;
+    using pointer = const value_type*;
+    using iterator_category = single_pass_iterator_tag;
+    using size_type = size_type_t<Range>;
+
+    explicit buffered_chunk_iterator(Range& range, size_type size)
+      : tracker(range)
+      , size(size)
+    {
+      fill();
+    }
+
+    explicit buffered_chunk_iterator(Range& range, end_marker_t)
+      : tracker(range, end_marker_t{})
+    {}
+
+    buffered_chunk_iterator& operator++()
+    {
+      fill();
+      return *this;
+    }
+
+    reference operator*() const
+    {
+      return buffer;
+    }
+
+    pointer operator->() const
+    {
+      return &buffer;
+    }
+
+    // only the end has an empty chunk
+    bool operator!=(const buffered_chunk_iterator& rhs) const
+    {
+      return buffer.empty() != rhs.buffer.empty();
+    }
+
+    bool operator==(const buffered_chunk_iterator& rhs) const
+    {
+      return !(*this != rhs);
+    }
+
+    range_tracker<Range> tracker;
+    size_type size{1};
+    value_type buffer;
+
+  private:
+    void fill()
+    {
+      buffer.clear();
+      while (buffer.size() < static_cast<std::size_t>(size) && tracker.template has_next<0>())
+      {
+        buffer.push_back(*tracker.template get<0>().first);
+        tracker.template next<0>();
+      }
+    }
+  };
+
+  template <typename Range>
+  using chunk_iterator_for = std::conditional_t<
+      is_single_pass_iterator<iterator_type_t<Range>>::value,
+      buffered_chunk_iterator<Range>,
+      chunk_iterator<Range>
+    >;
+
   template <typename Keeper>
   struct chunk_range_view
   {
     using Range = ezy::experimental::keeper_value_type_t<Keeper>;
-    using const_iterator = chunk_iterator<const Range>;
-    using iterator = chunk_iterator<Range>;
+    using const_iterator = chunk_iterator_for<const Range>;
+    using iterator = chunk_iterator_for<Range>;
     using size_type = size_type_t<Range>;
 
     constexpr const_iterator begin() const
@@ -1694,6 +2145,31 @@ namespace detail
     Keeper keeper;
     const size_type size;
   };
+
+  /**
+   * is_view: the views refer to (or keep) other ranges, so they do not own the elements they give, even if
+   * they are temporaries. The views keeping one range define Range, the others are listed.
+   */
+  template <typename T, typename = void>
+  struct is_view : std::false_type {};
+
+  template <typename T>
+  struct is_view<T, void_t<typename T::Range>> : std::true_type {};
+
+  template <typename Keeper1, typename Keeper2>
+  struct is_view<concatenated_range_view<Keeper1, Keeper2>> : std::true_type {};
+
+  template <typename Zipper, typename... Keepers>
+  struct is_view<zip_range_view<Zipper, Keepers...>> : std::true_type {};
+
+  template <typename Iter, typename Sentinel>
+  struct is_view<subrange_view<Iter, Sentinel>> : std::true_type {};
+
+  template <typename T, typename Fn>
+  struct is_view<iterate_view<T, Fn>> : std::true_type {};
+
+  template <typename T>
+  struct is_view<repeat_view<T>> : std::true_type {};
 }
 }
 
@@ -0,0 +1,337 @@
+#ifndef EZY_SMALL_VECTOR_H_INCLUDED
+#define EZY_SMALL_VECTOR_H_INCLUDED
+
+#include "bits/instrument_hooks.h"
+
+#include <algorithm> // equal, rotate, max
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <memory> // allocator, uninitialized_*, destroy
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace ezy
+{
+  /**
+   * small_vector: a vector which stores up to N elements inline, and spills to the heap (with Allocator) if
+   * more elements are added. Elements are moved (if it cannot throw) or copied on spill, like by std::vector.
+   */
+  template <typename T, std::size_t N, typename Allocator = std::allocator<T>>
+  class small_vector
+  {
+    static_assert(N > 0, "Inline capacity must be positive");
+
+    using allocator_traits = std::allocator_traits<Allocator>;
+
+    public:
+      using value_type = T;
+      using allocator_type = Allocator;
+      using size_type = std::size_t;
+      using difference_type = std::ptrdiff_t;
+      using reference = T&;
+      using const_reference = const T&;
+      using pointer = T*;
+      using const_pointer = const T*;
+      using iterator = T*;
+      using const_iterator = const T*;
+
+      small_vector() noexcept(noexcept(Allocator()))
+        : small_vector(Allocator())
+      {}
+
+      explicit small_vector(const Allocator& allocator) noexcept
+        : allocator(allocator)
+        , elements(inline_data())
+      {}
+
+      template <typename InputIt, typename = typename std::iterator_traits<InputIt>::iterator_category>
+      small_vector(InputIt first, InputIt last, const Allocator& allocator = Allocator())
+        : small_vector(allocator)
+      {
+        if constexpr (std::is_base_of<std::forward_iterator_tag,
+            typename std::iterator_traits<InputIt>::iterator_category>::value)
+          reserve(static_cast<size_type>(std::distance(first, last)));
+
+        for (; first != last; ++first)
+          emplace_back(*first);
+      }
+
+      small_vector(std::initializer_list<T> init, const Allocator& allocator = Allocator())
+        : small_vector(init.begin(), init.end(), allocator)
+      {}
+
+      small_vector(const small_vector& other)
+        : small_vector(other.begin(), other.end(),
+            allocator_traits::select_on_container_copy_construction(other.allocator))
+      {}
+
+      small_vector(small_vector&& other) noexcept(std::is_nothrow_move_constructible<T>::value)
+        : small_vector(other.allocator)
+      {
+        steal(other);
+      }
+
+      small_vector& operator=(const small_vector& other)
+      {
+        if (this != &other)
+        {
+          clear();
+          reserve(other.size());
+          std::uninitialized_copy(other.begin(), other.end(), begin());
+          count = other.count;
+        }
+        return *this;
+      }
+
+      small_vector& operator=(small_vector&& other) noexcept(std::is_nothrow_move_constructible<T>::value)
+      {
+        if (this != &other)
+        {
+          clear();
+          release();
+          steal(other);
+        }
+        return *this;
+      }
+
+      ~small_vector()
+      {
+        clear();
+        release();
+      }
+
+      template <typename... Args>
+      reference emplace_back(Args&&... args)
+      {
+        if (count == reserved)
+          return grow_emplace_back(std::forward<Args>(args)...);
+
+        T* element = ::new (static_cast<void*>(elements + count)) T(std::forward<Args>(args)...);
+        ++count;
+        return *element;
+      }
+
+      void push_back(const T& t)
+      { emplace_back(t); }
+
+      void push_back(T&& t)
+      { emplace_back(std::move(t)); }
+
+      iterator insert(const_iterator position, const T& t)
+      { return emplace(position, t); }
+
+      iterator insert(const_iterator position, T&& t)
+      { return emplace(position, std::move(t)); }
+
+      template <typename... Args>
+      iterator emplace(const_iterator position, Args&&... args)
+      {
+        const auto offset = position - cbegin();
+        emplace_back(std::forward<Args>(args)...);
+        std::rotate(begin() + offset, end() - 1, end());
+        return begin() + offset;
+      }
+
+      void pop_back() noexcept
+      {
+        --count;
+        std::destroy_at(end());
+      }
+
+      void clear() noexcept
+      {
+        std::destroy(begin(), end());
+        count = 0;
+      }
+
+      void reserve(size_type new_capacity)
+      {
+        if (new_capacity > reserved)
+          grow(new_capacity);
+      }
+
+      pointer data() noexcept
+      { return elements; }
+
+      const_pointer data() const noexcept
+      { return elements; }
+
+      iterator begin() noexcept
+      { return elements; }
+
+      iterator end() noexcept
+      { return elements + count; }
+
+      const_iterator begin() const noexcept
+      { return elements; }
+
+      const_iterator end() const noexcept
+      { return elements + count; }
+
+      const_iterator cbegin() const noexcept
+      { return begin(); }
+
+      const_iterator cend() const noexcept
+      { return end(); }
+
+      reference operator[](size_type i) noexcept
+      { return elements[i]; }
+
+      const_reference operator[](size_type i) const noexcept
+      { return elements[i]; }
+
+      reference front() noexcept
+      { return *begin(); }
+
+      const_reference front() const noexcept
+      { return *begin(); }
+
+      reference back() noexcept
+      { return *(end() - 1); }
+
+      const_reference back() const noexcept
+      { return *(end() - 1); }
+
+      size_type size() const noexcept
+      { return count; }
+
+      size_type capacity() const noexcept
+      { return reserved; }
+
+      static constexpr size_type inline_capacity() noexcept
+      { return N; }
+
+      bool empty() const noexcept
+      { return count == 0; }
+
+      // true if the elements are stored inline
+      bool is_inline() const noexcept
+      { return elements == inline_data(); }
+
+      allocator_type get_allocator() const noexcept
+      { return allocator; }
+
+      friend bool operator==(const small_vector& lhs, const small_vector& rhs)
+      { return std::equal(lhs.begin(), lhs.end(), rhs.begin(), rhs.end()); }
+
+      friend bool operator!=(const small_vector& lhs, const small_vector& rhs)
+      { return !(lhs == rhs); }
+
+    private:
+      T* inline_data() noexcept
+      { return std::launder(reinterpret_cast<T*>(storage)); }
+
+      const T* inline_data() const noexcept
+      { return std::launder(reinterpret_cast<const T*>(storage)); }
+
+      // releases the new buffer if moving (or copying) the elements fails
+      struct buffer_guard
+      {
+        Allocator& allocator;
+        T* buffer;
+        size_type size;
+
+        ~buffer_guard()
+        {
+          if (buffer)
+            allocator_traits::deallocate(allocator, buffer, size);
+        }
+      };
+
+      // destroys the new element if moving (or copying) the others fails
+      struct element_guard
+      {
+        T* element;
+
+        ~element_guard()
+        {
+          if (element)
+            std::destroy_at(element);
+        }
+      };
+
+      void grow(size_type new_capacity)
+      {
+        buffer_guard guard{allocator, allocator_traits::allocate(allocator, new_capacity), new_capacity};
+        detail::record<small_vector>(instrument::event::allocation);
+        uninitialized_move_if_noexcept(begin(), end(), guard.buffer);
+        adopt(guard);
+      }
+
+      // the new element is constructed before the others are moved, as args may refer to one of them
+      template <typename... Args>
+      reference grow_emplace_back(Args&&... args)
+      {
+        const size_type new_capacity = std::max(reserved * 2, count + 1);
+        buffer_guard guard{allocator, allocator_traits::allocate(allocator, new_capacity), new_capacity};
+        detail::record<small_vector>(instrument::event::allocation);
+
+        element_guard element{::new (static_cast<void*>(guard.buffer + count)) T(std::forward<Args>(args)...)};
+        T* result = element.element;
+        uninitialized_move_if_noexcept(begin(), end(), guard.buffer);
+        element.element = nullptr;
+
+        adopt(guard);
+        ++count;
+        return *result;
+      }
+
+      // expects: the elements are moved to the buffer of guard
+      void adopt(buffer_guard& guard) noexcept
+      {
+        std::destroy(begin(), end());
+        release();
+        elements = std::exchange(guard.buffer, nullptr);
+        reserved = guard.size;
+      }
+
+      static void uninitialized_move_if_noexcept(T* first, T* last, T* out)
+      {
+        if constexpr (std::is_nothrow_move_constructible<T>::value || !std::is_copy_constructible<T>::value)
+          std::uninitialized_move(first, last, out);
+        else
+          std::uninitialized_copy(first, last, out);
+      }
+
+      // frees the heap buffer, expects: no elements alive
+      void release() noexcept
+      {
+        if (!is_inline())
+          allocator_traits::deallocate(allocator, elements, reserved);
+
+        elements = inline_data();
+        reserved = N;
+      }
+
+      // expects: no elements alive, the inline buffer is in use
+      void steal(small_vector& other)
+      {
+        if (other.is_inline() || !(allocator == other.allocator))
+        {
+          reserve(other.size());
+          std::uninitialized_move(other.begin(), other.end(), begin());
+          count = other.count;
+          other.clear();
+        }
+        else
+        {
+          elements = other.elements;
+          reserved = other.reserved;
+          count = other.count;
+          other.elements = other.inline_data();
+          other.reserved = N;
+          other.count = 0;
+        }
+      }
+
+      Allocator allocator;
+      T* elements;
+      size_type count{0};
+      size_type reserved{N};
+      alignas(T) unsigned char storage[N * sizeof(T)];
+  };
+}
+
+#endif
@@ -0,0 +1,240 @@
+#ifndef EZY_STATIC_VECTOR_H_INCLUDED
+#define EZY_STATIC_VECTOR_H_INCLUDED
+
+#include "bits/bounds_policy.h" // throw_bounds_error
+#include "optional"
+
+#include <algorithm> // equal, rotate
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <memory> // uninitialized_*, destroy
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace ezy
+{
+  /**
+   * static_vector: a vector with a fixed capacity, the elements are stored inline (no allocation at all).
+   *
+   * Adding an element to a full static_vector is a programming error, it is reported in the same way as by
+   * the default bounds policy (std::logic_error, or abort if exceptions are disabled). try_push_back and
+   * try_collect can be used if the number of elements is not known in advance.
+   */
+  template <typename T, std::size_t N>
+  class static_vector
+  {
+    static_assert(N > 0, "Capacity must be positive");
+
+    public:
+      using value_type = T;
+      using size_type = std::size_t;
+      using difference_type = std::ptrdiff_t;
+      using reference = T&;
+      using const_reference = const T&;
+      using pointer = T*;
+      using const_pointer = const T*;
+      using iterator = T*;
+      using const_iterator = const T*;
+
+      static_vector() noexcept = default;
+
+      template <typename InputIt, typename = typename std::iterator_traits<InputIt>::iterator_category>
+      static_vector(InputIt first, InputIt last)
+      {
+        for (; first != last; ++first)
+          emplace_back(*first);
+      }
+
+      static_vector(std::initializer_list<T> init)
+        : static_vector(init.begin(), init.end())
+      {}
+
+      static_vector(const static_vector& other)
+        : static_vector(other.begin(), other.end())
+      {}
+
+      static_vector(static_vector&& other) noexcept(std::is_nothrow_move_constructible<T>::value)
+      {
+        std::uninitialized_move(other.begin(), other.end(), begin());
+        count = other.count;
+      }
+
+      static_vector& operator=(const static_vector& other)
+      {
+        if (this != &other)
+        {
+          clear();
+          std::uninitialized_copy(other.begin(), other.end(), begin());
+          count = other.count;
+        }
+        return *this;
+      }
+
+      static_vector& operator=(static_vector&& other) noexcept(std::is_nothrow_move_constructible<T>::value)
+      {
+        if (this != &other)
+        {
+          clear();
+          std::uninitialized_move(other.begin(), other.end(), begin());
+          count = other.count;
+        }
+        return *this;
+      }
+
+      ~static_vector()
+      { clear(); }
+
+      template <typename... Args>
+      reference emplace_back(Args&&... args)
+      {
+        if (full())
+          detail::throw_bounds_error("static_vector: capacity exceeded");
+
+        return unchecked_emplace_back(std::forward<Args>(args)...);
+      }
+
+      void push_back(const T& t)
+      { emplace_back(t); }
+
+      void push_back(T&& t)
+      { emplace_back(std::move(t)); }
+
+      /**
+       * try_push_back: adds the element if there is space for it
+       * Returns: false if the vector was full
+       */
+      template <typename U>
+      bool try_push_back(U&& u)
+      {
+        if (full())
+          return false;
+
+        unchecked_emplace_back(std::forward<U>(u));
+        return true;
+      }
+
+      iterator insert(const_iterator position, const T& t)
+      { return emplace(position, t); }
+
+      iterator insert(const_iterator position, T&& t)
+      { return emplace(position, std::move(t)); }
+
+      template <typename... Args>
+      iterator emplace(const_iterator position, Args&&... args)
+      {
+        const auto offset = position - cbegin();
+        emplace_back(std::forward<Args>(args)...);
+        std::rotate(begin() + offset, end() - 1, end());
+        return begin() + offset;
+      }
+
+      void pop_back() noexcept
+      {
+        --count;
+        std::destroy_at(end());
+      }
+
+      void clear() noexcept
+      {
+        std::destroy(begin(), end());
+        count = 0;
+      }
+
+      pointer data() noexcept
+      { return std::launder(reinterpret_cast<T*>(storage)); }
+
+      const_pointer data() const noexcept
+      { return std::launder(reinterpret_cast<const T*>(storage)); }
+
+      iterator begin() noexcept
+      { return data(); }
+
+      iterator end() noexcept
+      { return data() + count; }
+
+      const_iterator begin() const noexcept
+      { return data(); }
+
+      const_iterator end() const noexcept
+      { return data() + count; }
+
+      const_iterator cbegin() const noexcept
+      { return begin(); }
+
+      const_iterator cend() const noexcept
+      { return end(); }
+
+      reference operator[](size_type i) noexcept
+      { return data()[i]; }
+
+      const_reference operator[](size_type i) const noexcept
+      { return data()[i]; }
+
+      reference front() noexcept
+      { return *begin(); }
+
+      const_reference front() const noexcept
+      { return *begin(); }
+
+      reference back() noexcept
+      { return *(end() - 1); }
+
+      const_reference back() const noexcept
+      { return *(end() - 1); }
+
+      size_type size() const noexcept
+      { return count; }
+
+      static constexpr size_type capacity() noexcept
+      { return N; }
+
+      static constexpr size_type max_size() noexcept
+      { return N; }
+
+      bool empty() const noexcept
+      { return count == 0; }
+
+      bool full() const noexcept
+      { return count == N; }
+
+      friend bool operator==(const static_vector& lhs, const static_vector& rhs)
+      { return std::equal(lhs.begin(), lhs.end(), rhs.begin(), rhs.end()); }
+
+      friend bool operator!=(const static_vector& lhs, const static_vector& rhs)
+      { return !(lhs == rhs); }
+
+    private:
+      template <typename... Args>
+      reference unchecked_emplace_back(Args&&... args)
+      {
+        T* element = ::new (static_cast<void*>(data() + count)) T(std::forward<Args>(args)...);
+        ++count;
+        return *element;
+      }
+
+      alignas(T) unsigned char storage[N * sizeof(T)];
+      size_type count{0};
+  };
+
+  /**
+   * try_collect<Container>(range) -> ezy::optional<Container>
+   *
+   * Collects into a fixed capacity Container (which has try_push_back), gives back nullopt if the range
+   * does not fit.
+   */
+  template <typename Container, typename Range>
+  ezy::optional<Container> try_collect(Range&& range)
+  {
+    Container container;
+    for (auto&& element : range)
+    {
+      if (!container.try_push_back(std::forward<decltype(element)>(element)))
+        return std::nullopt;
+    }
+    return ezy::optional<Container>(std::move(container));
+  }
+}
+
+#endif
@@ -32,7 +32,7 @@ namespace ezy
           //, std::enable_if_t<std::is_constructible_v<type, Args...>>* = nullptr
           //, std::enable_if_t<detail::is_braces_constructible<T, Args...>::value>* = nullptr
           //, std::enable_if_t<(sizeof...(Args) != 1) || (!std::is_same_v<ezy::remove_cvref_t<typename detail::headof<Args...>::type>, strong_type_payload>)>* = nullptr
-          )
+          ) noexcept(std::is_nothrow_constructible<T, Arg0, Args...>::value)
         : _value{std::forward<Arg0>(arg0), std::forward<Args>(args)...}
       {}
 
@@ -52,6 +52,7 @@ namespace ezy
 
       template <typename Arg0, typename... Args>
       constexpr strong_type_payload(Arg0&& arg0, Args&&... args)
+        noexcept(std::is_nothrow_constructible<T, Arg0, Args...>::value)
         : _value{std::forward<Arg0>(arg0), std::forward<Args>(args)...}
       {}
 
@@ -64,26 +65,26 @@ namespace ezy
       using _payload = detail::strong_type_payload<T, IsExtended>;
       using _payload::strong_type_payload;
 
-      constexpr T& get() & { return this->_value; }
-      constexpr decltype(auto) get() &&
+      constexpr T& get() & noexcept { return this->_value; }
+      constexpr decltype(auto) get() && noexcept
       {
         return get_forwarded(std::is_lvalue_reference<T>{});
       }
-      constexpr const T& get() const & { return this->_value; }
+      constexpr const T& get() const & noexcept { return this->_value; }
 
-      explicit operator T() { return this->_value; }
-      explicit operator T() const { return this->_value; }
+      constexpr explicit operator T() { return this->_value; }
+      constexpr explicit operator T() const { return this->_value; }
 
       private:
 
         // lvalue_reference
-        constexpr decltype(auto) get_forwarded(std::true_type)
+        constexpr decltype(auto) get_forwarded(std::true_type) noexcept
         {
           return this->_value;
         }
 
         // not lvalue_reference
-        constexpr decltype(auto) get_forwarded(std::false_type)
+        constexpr decltype(auto) get_forwarded(std::false_type) noexcept
         {
           return std::move(this->_value);
         }
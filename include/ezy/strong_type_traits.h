@@ -158,6 +158,22 @@ namespace ezy
   template <typename ST, typename U>
   using rebind_strong_type_t = typename rebind_strong_type<ST, U>::type;
 
+  /**
+   * rebind_tag
+   */
+  template <typename ST, typename NewTag>
+  struct rebind_tag
+  {};
+
+  template <typename T, typename Tag, typename NewTag, typename... Features>
+  struct rebind_tag<strong_type<T, Tag, Features...>, NewTag>
+  {
+    using type = strong_type<T, NewTag, Features...>;
+  };
+
+  template <typename ST, typename NewTag>
+  using rebind_tag_t = typename rebind_tag<ST, NewTag>::type;
+
   /**
    * strong_type_base
    */
@@ -178,39 +194,35 @@ namespace ezy
 
   /**
    * has_feature
+   *
+   * A feature is present if it is listed or it is a base of a listed (composed) feature. Listed
+   * features are found without instantiating anything. Otherwise features are impersonalized, so
+   * their impls are instantiated once, not once per strong type, and checked in one fold.
    */
   namespace detail
   {
-    // impersonalization is no longer required
-    template <typename T>
-    struct is_derived_from
-    {
-      template <typename U>
-      struct apply : std::is_base_of<T, U> {};
-    };
-
     struct impersonal {};
 
     template <typename Feature>
     using impersonalize_t = impl_t<Feature, impersonal>;
 
-    template <typename ST>
-    struct extract_impersonalized_features
-    {
-      using type = ezy::tuple_traits::map_t< ezy::extract_features_t<ST>, ezy::detail::impersonalize_t>;
-    };
-
-    template <typename ST>
-    using extract_impersonalized_features_t = typename extract_impersonalized_features<ST>::type;
+    template <typename Features, typename Feature>
+    struct has_impersonalized_feature;
 
+    template <typename... Features, typename Feature>
+    struct has_impersonalized_feature<ezy::typelist<Features...>, Feature>
+      : std::integral_constant<bool,
+          (std::is_base_of<impersonalize_t<Feature>, impersonalize_t<Features>>::value || ...)
+        >
+    {};
   }
 
   template <typename ST, typename Feature>
-  using has_feature =
-  ezy::tuple_traits::any_of<
-    detail::extract_impersonalized_features_t<ST>,
-    detail::is_derived_from<detail::impersonalize_t<Feature>>::template apply
-  >;
+  struct has_feature : std::disjunction<
+      ezy::tuple_traits::contains<ezy::extract_features_t<ST>, Feature>,
+      detail::has_impersonalized_feature<ezy::extract_features_t<ST>, Feature>
+    >
+  {};
 
   template <typename ST, typename Feature>
   constexpr bool has_feature_v = has_feature<ST, Feature>::value;
@@ -30,28 +30,26 @@ namespace ezy { namespace tuple_traits
 
   /**
    * extend
+   *
+   * Concatenation is a fold over an operator, so the instantiation depth does not grow with the
+   * number of tuples.
    */
   namespace detail
   {
-    template <typename...>
-    struct combine_tuple_like;
-
     template <typename TupleLike>
-    struct combine_tuple_like<TupleLike>
+    struct concat_box
     {
       using type = TupleLike;
     };
 
-    template <template <typename...> class Tuple, typename... Ts1, typename... Ts2, typename...Tuples>
-    struct combine_tuple_like<Tuple<Ts1...>, Tuple<Ts2...>, Tuples...>
-    {
-      using type = typename combine_tuple_like<Tuple<Ts1..., Ts2...>,  Tuples...>::type;
-    };
+    template <template <typename...> class Tuple, typename... Ts1, typename... Ts2>
+    concat_box<Tuple<Ts1..., Ts2...>> operator+(concat_box<Tuple<Ts1...>>, concat_box<Tuple<Ts2...>>);
   }
+
   template <typename... Tuples>
   struct extend
   {
-    using type = typename detail::combine_tuple_like<Tuples...>::type;
+    using type = typename decltype((detail::concat_box<Tuples>{} + ...))::type;
   };
 
   template <typename... Tuples>
@@ -90,32 +88,13 @@ namespace ezy { namespace tuple_traits
   /**
    * remove
    */
-  template <typename T, typename... Ts>
-  struct tuple_remove_helper;
-
-  template <template <typename...> class Tuple, typename T>
-  struct tuple_remove_helper<T, Tuple<>>
-  {
-    using type = Tuple<>;
-  };
-
-  template <template <typename...> class Tuple, typename Head, typename... Tail, typename T>
-  struct tuple_remove_helper<T, Tuple<Head, Tail...>>
-  {
-    using type = extend_t<
-                          ezy::conditional_t<
-                            !std::is_same<Head, T>::value,
-                            Tuple<Head>,
-                            Tuple<>
-                          >,
-                          typename tuple_remove_helper<T, Tuple<Tail...>>::type
-                         >;
-  };
-
   template <typename Tuple, typename T>
-  struct remove
+  struct remove;
+
+  template <template <typename...> class Tuple, typename... Ts, typename T>
+  struct remove<Tuple<Ts...>, T>
   {
-    using type = typename tuple_remove_helper<T, Tuple>::type;
+    using type = extend_t<Tuple<>, ezy::conditional_t<std::is_same<Ts, T>::value, Tuple<>, Tuple<Ts>>...>;
   };
 
   template <typename Tuple, typename T>
@@ -127,17 +106,8 @@ namespace ezy { namespace tuple_traits
   template <typename Tuple, template <typename> class Predicate>
   struct any_of;
 
-  template <template <typename...> class Tuple, template <typename> class Predicate>
-  struct any_of<Tuple<>, Predicate> : std::false_type {};
-
-  template <template <typename...> class Tuple, template <typename> class Predicate, typename Head, typename... Tail>
-  struct any_of<Tuple<Head, Tail...>, Predicate> :
-    ezy::conditional_t<
-      Predicate<Head>::value,
-      std::true_type,
-      any_of<Tuple<Tail...>, Predicate>
-    >
-  {};
+  template <template <typename...> class Tuple, typename... Ts, template <typename> class Predicate>
+  struct any_of<Tuple<Ts...>, Predicate> : std::integral_constant<bool, (Predicate<Ts>::value || ...)> {};
 
   template <typename Tuple, template <typename> class Predicate>
   constexpr bool any_of_v = any_of<Tuple, Predicate>::value;
@@ -148,17 +118,8 @@ namespace ezy { namespace tuple_traits
   template <typename Tuple, template <typename> class Predicate>
   struct none_of;
 
-  template <template <typename...> class Tuple, template <typename> class Predicate>
-  struct none_of<Tuple<>, Predicate> : std::true_type {};
-
-  template <template <typename...> class Tuple, template <typename> class Predicate, typename Head, typename... Tail>
-  struct none_of<Tuple<Head, Tail...>, Predicate> :
-    ezy::conditional_t<
-      Predicate<Head>::value,
-      std::false_type,
-      none_of<Tuple<Tail...>, Predicate>
-    >
-  {};
+  template <template <typename...> class Tuple, typename... Ts, template <typename> class Predicate>
+  struct none_of<Tuple<Ts...>, Predicate> : std::integral_constant<bool, !(Predicate<Ts>::value || ...)> {};
 
   template <typename Tuple, template <typename> class Predicate>
   constexpr bool none_of_v = none_of<Tuple, Predicate>::value;
@@ -170,17 +131,8 @@ namespace ezy { namespace tuple_traits
   template <typename Tuple, template <typename> class Predicate>
   struct all_of;
 
-  template <template <typename...> class Tuple, template <typename> class Predicate>
-  struct all_of<Tuple<>, Predicate> : std::true_type {};
-
-  template <template <typename...> class Tuple, template <typename> class Predicate, typename Head, typename... Tail>
-  struct all_of<Tuple<Head, Tail...>, Predicate> :
-    ezy::conditional_t<
-      !Predicate<Head>::value,
-      std::false_type,
-      all_of<Tuple<Tail...>, Predicate>
-    >
-  {};
+  template <template <typename...> class Tuple, typename... Ts, template <typename> class Predicate>
+  struct all_of<Tuple<Ts...>, Predicate> : std::integral_constant<bool, (Predicate<Ts>::value && ...)> {};
 
   template <typename Tuple, template <typename> class Predicate>
   constexpr bool all_of_v = all_of<Tuple, Predicate>::value;
@@ -193,14 +145,8 @@ namespace ezy { namespace tuple_traits
   template <typename Tuple, typename T>
   struct contains;
 
-  template <template <typename...> class Tuple, typename T>
-  struct contains<Tuple<>, T> : std::false_type {};
-
-  template <template <typename...> class Tuple, typename T, typename Head, typename... Tail>
-  struct contains<Tuple<Head, Tail...>, T> : contains<Tuple<Tail...>, T> {};
-
-  template <template <typename...> class Tuple, typename T, typename... Tail>
-  struct contains<Tuple<T, Tail...>, T> : std::true_type {};
+  template <template <typename...> class Tuple, typename... Ts, typename T>
+  struct contains<Tuple<Ts...>, T> : std::integral_constant<bool, (std::is_same<Ts, T>::value || ...)> {};
 
   template <typename Tuple, typename T>
   constexpr bool contains_v = contains<Tuple, T>::value;
@@ -211,23 +157,10 @@ namespace ezy { namespace tuple_traits
   template <typename Tuple, template <typename> class Predicate>
   struct filter;
 
-  template <template <typename...> class Tuple, template <typename> class Predicate>
-  struct filter<Tuple<>, Predicate>
+  template <template <typename...> class Tuple, typename... Ts, template <typename> class Predicate>
+  struct filter<Tuple<Ts...>, Predicate>
   {
-    using type = Tuple<>;
-  };
-
-  template <template <typename...> class Tuple, typename Head, typename... Tail, template <typename> class Predicate>
-  struct filter<Tuple<Head, Tail...>, Predicate>
-  {
-    using type = extend_t<
-        ezy::conditional_t<
-          Predicate<Head>::value,
-          Tuple<Head>,
-          Tuple<>
-        >,
-        typename filter<Tuple<Tail...>, Predicate>::type
-      >;
+    using type = extend_t<Tuple<>, ezy::conditional_t<Predicate<Ts>::value, Tuple<Ts>, Tuple<>>...>;
   };
 
   template <typename Tuple, template <typename> class Predicate>
@@ -281,19 +214,10 @@ namespace ezy { namespace tuple_traits
   template <typename Tuple1, typename Tuple2>
   struct subtract;
 
-  template <typename Tuple1, template <typename...> class Tuple>
-  struct subtract<Tuple1, Tuple<>>
+  template <template <typename...> class Tuple, typename... Ts1, typename Tuple2>
+  struct subtract<Tuple<Ts1...>, Tuple2>
   {
-    using type = Tuple1;
-  };
-
-  template <template <typename...> class Tuple, typename Tuple1, typename Tuple2Head, typename... Tuple2Tail>
-  struct subtract<Tuple1, Tuple<Tuple2Head, Tuple2Tail...>>
-  {
-    using type = typename subtract<
-                                   remove_t<Tuple1, Tuple2Head>,
-                                   Tuple<Tuple2Tail...>
-                                  >::type;
+    using type = extend_t<Tuple<>, ezy::conditional_t<contains<Tuple2, Ts1>::value, Tuple<>, Tuple<Ts1>>...>;
   };
 
   template <typename Tuple1, typename Tuple2>
@@ -347,23 +271,14 @@ namespace ezy { namespace tuple_traits
   template <typename Tuple1, typename Tuple2>
   struct zip;
 
-  template <template <typename...> class Tuple>
-  struct zip<Tuple<>, Tuple<>>
-  {
-    using type = Tuple<>;
-  };
-
-  template <template <typename...> class Tuple, typename Head1, typename... Tail1, typename Head2, typename... Tail2>
-  struct zip<Tuple<Head1, Tail1...>, Tuple<Head2, Tail2...>>
+  template <template <typename...> class Tuple, typename... Ts1, typename... Ts2>
+  struct zip<Tuple<Ts1...>, Tuple<Ts2...>>
   {
     static_assert(
-        sizeof...(Tail1) == sizeof...(Tail2),
+        sizeof...(Ts1) == sizeof...(Ts2),
         "zipped tuples must have the same size");
 
-    using type = extend_t<
-      Tuple<Tuple<Head1, Head2>>,
-      typename zip<Tuple<Tail1...>, Tuple<Tail2...>>::type
-    >;
+    using type = Tuple<Tuple<Ts1, Ts2>...>;
   };
 
   template <typename Tuple1, typename Tuple2>
@@ -0,0 +1,95 @@
+#ifndef EZY_VIEW_LAYOUT_H_INCLUDED
+#define EZY_VIEW_LAYOUT_H_INCLUDED
+
+#include "range.h"
+#include "typelist_traits.h"
+
+#include <algorithm> // max
+#include <cstddef>
+
+namespace ezy
+{
+  /**
+   * view_layout: sizes of a view (or range) and its iterator.
+   */
+  template <typename View>
+  struct view_layout
+  {
+    using view_type = View;
+    using iterator_type = detail::iterator_type_t<View>;
+
+    static constexpr std::size_t view_size = sizeof(View);
+    static constexpr std::size_t iterator_size = sizeof(iterator_type);
+  };
+
+  namespace detail
+  {
+    template <typename View, typename = void>
+    struct nested_ranges
+    {
+      using type = ezy::typelist<>;
+    };
+
+    template <typename View>
+    struct nested_ranges<View, void_t<typename View::Range>>
+    {
+      using type = ezy::typelist<std::remove_cv_t<typename View::Range>>;
+    };
+
+    template <typename Keeper1, typename Keeper2>
+    struct nested_ranges<concatenated_range_view<Keeper1, Keeper2>>
+    {
+      using type = ezy::typelist<
+        std::remove_cv_t<ezy::experimental::keeper_value_type_t<Keeper1>>,
+        std::remove_cv_t<ezy::experimental::keeper_value_type_t<Keeper2>>
+      >;
+    };
+
+    template <typename Zipper, typename... Keepers>
+    struct nested_ranges<zip_range_view<Zipper, Keepers...>>
+    {
+      using type = ezy::typelist<std::remove_cv_t<ezy::experimental::keeper_value_type_t<Keepers>>...>;
+    };
+
+    template <typename View, typename NestedRanges = typename nested_ranges<View>::type>
+    struct view_layouts_impl;
+
+    template <typename View, typename... NestedRanges>
+    struct view_layouts_impl<View, ezy::typelist<NestedRanges...>>
+    {
+      using type = ezy::tuple_traits::extend_t<
+        ezy::typelist<view_layout<View>>,
+        typename view_layouts_impl<NestedRanges>::type...
+      >;
+    };
+  }
+
+  /**
+   * view_layouts: view_layout of a view and of every range nested into it (depth first), down to the
+   * original ranges, eg. for `ezy::filter(ezy::transform(v, f), p)` it contains the layouts of the filter
+   * view, the transform view and `v`.
+   */
+  template <typename View>
+  struct view_layouts : detail::view_layouts_impl<ezy::remove_cvref_t<View>>
+  {};
+
+  template <typename View>
+  using view_layouts_t = typename view_layouts<View>::type;
+
+  /**
+   * max_iterator_size: the size of the largest iterator in a pipeline, eg. to check a size budget:
+   * `static_assert(ezy::max_iterator_size_v<decltype(pipeline)> <= 3 * sizeof(void*));`
+   */
+  template <typename View, typename Layouts = view_layouts_t<View>>
+  struct max_iterator_size;
+
+  template <typename View, typename... Layouts>
+  struct max_iterator_size<View, ezy::typelist<Layouts...>>
+    : std::integral_constant<std::size_t, std::max({Layouts::iterator_size...})>
+  {};
+
+  template <typename View>
+  constexpr std::size_t max_iterator_size_v = max_iterator_size<View>::value;
+}
+
+#endif
@@ -3,11 +3,20 @@
 #include <ezy/algorithm>
 #include <ezy/strong_type>
 #include <ezy/features/iterable.h>
+#include <ezy/features/algo_find.h>
 #include <ezy/string.h>
 #include <ezy/experimental/function.h>
+#include <ezy/experimental/arena.h>
+#include <ezy/optional>
+#include <ezy/result>
 
 #include <vector>
+#include <array>
 #include <list>
+#include <set>
+#include <memory_resource>
+#include <cstdint>
+#include <string>
 
 #include "common.h"
 
@@ -234,6 +243,13 @@ SCENARIO("transform")
   REQUIRE(join_as_strings(mapped) == "234");
 }
 
+SCENARIO("transform with mutable lambda")
+{
+  std::vector<int> v{1,2,3};
+  auto mapped = ezy::transform(v, [last = 0](int i) mutable { last = i + 1; return last; });
+  REQUIRE(join_as_strings(mapped) == "234");
+}
+
 SCENARIO("filter")
 {
   std::vector<int> v{1,2,3,4,5,6};
@@ -241,6 +257,13 @@ SCENARIO("filter")
   REQUIRE(join_as_strings(filtered) == "246");
 }
 
+SCENARIO("filter with mutable lambda")
+{
+  std::vector<int> v{1,2,3,4,5,6};
+  auto filtered = ezy::filter(v, [last = 0](int i) mutable { last = i; return last % 2 == 0; });
+  REQUIRE(join_as_strings(filtered) == "246");
+}
+
 SCENARIO("filter array")
 {
   const int a[] = {1,2,3,4,5,6};
@@ -374,6 +397,63 @@ SCENARIO("zip_with")
   }
 }
 
+SCENARIO("zip_with stateful zipper")
+{
+  const std::vector<int> table{100, 200, 300, 400};
+  const auto lookup_add = [table](int i, int j) { return table[i] + j; };
+  const auto zipped = ezy::zip_with(lookup_add, std::vector{0, 1, 2}, std::vector{1, 2, 3});
+  REQUIRE(join_as_strings(zipped, ",") == "101,202,303");
+
+  THEN("the zipper is not copied into the iterator")
+  {
+    using ZipIterator = decltype(std::begin(zipped));
+    static_assert(sizeof(ZipIterator) == (sizeof(ezy::detail::iterator_tracker_for<std::vector<int>>) * 2 + sizeof(void*)));
+  }
+}
+
+SCENARIO("zip lvalues")
+{
+  std::vector<int> v1{1,2,3};
+  std::vector<int> v2{4,5,6};
+  auto zipped = ezy::zip(v1, v2);
+
+  THEN("elements are referred")
+  {
+    using Reference = decltype(*std::begin(zipped));
+    static_assert(std::is_same_v<Reference, std::tuple<int&, int&>>);
+    for (auto [a, b] : zipped)
+      a += b;
+
+    REQUIRE(join_as_strings(v1, ",") == "5,7,9");
+  }
+
+  THEN("temporaries produced by the ranges are stored by value")
+  {
+    const auto mapped = ezy::zip(v1, ezy::transform(v2, [](int i) { return i * 2; }));
+    using Reference = decltype(*std::begin(mapped));
+    static_assert(std::is_same_v<Reference, std::tuple<const int&, int>>);
+    REQUIRE(join_zipped(mapped) == "1+8;2+10;3+12;");
+  }
+
+  THEN("it can be collected to values")
+  {
+    const auto collected = ezy::collect<std::vector>(zipped);
+    static_assert(std::is_same_v<typename decltype(collected)::value_type, std::tuple<int, int>>);
+    REQUIRE(collected.size() == 3);
+  }
+}
+
+SCENARIO("zip random access ranges of different size")
+{
+  const std::vector<int> v1{1,2,3,4};
+  const std::vector<int> v2{4,5};
+  const auto zipped = ezy::zip(v1, v2);
+  using ZipIterator = decltype(std::begin(zipped));
+  static_assert(ZipIterator::is_sized);
+  REQUIRE(std::distance(std::begin(zipped), std::end(zipped)) == 2);
+  REQUIRE(join_zipped(zipped) == "1+4;2+5;");
+}
+
 // consider a builtin algorithm (eg. zip_forward)
 SCENARIO("zip mutable reference")
 {
@@ -402,12 +482,61 @@ SCENARIO("zip rvalue ")
   REQUIRE(joined == "11,22,33,44,55");
 }
 
+SCENARIO("zipper tuples")
+{
+  int i = 1;
+
+  GIVEN("forward_as_tuple")
+  THEN("it refers to every argument, like std::forward_as_tuple")
+  {
+    static_assert(std::is_same_v<decltype(ezy::forward_as_tuple(i, 2)), std::tuple<int&, int&&>>);
+    static_assert(std::is_same_v<decltype(ezy::forward_as_tuple(i, 2)), decltype(std::forward_as_tuple(i, 2))>);
+  }
+
+  GIVEN("capture_as_tuple")
+  THEN("it refers to lvalues, but keeps rvalues by value")
+  {
+    static_assert(std::is_same_v<decltype(ezy::capture_as_tuple(i, 2)), std::tuple<int&, int>>);
+  }
+
+  GIVEN("zip of a range which produces temporaries")
+  THEN("the temporaries are kept in the tuple")
+  {
+    const std::vector v{1, 2, 3};
+    const auto zipped = ezy::zip(v, ezy::transform(v, [](int e) { return e * 10; }));
+    using Element = decltype(*std::begin(zipped));
+    static_assert(std::is_same_v<Element, std::tuple<const int&, int>>);
+    REQUIRE(std::get<1>(*std::begin(zipped)) == 10);
+  }
+}
+
 SCENARIO("slice")
 {
   std::vector<int> v{1,2,3,4,5,6,7,8};
   REQUIRE(join_as_strings(ezy::slice(v, 0, 3)) == "123");
 }
 
+SCENARIO("slice with bounds policies")
+{
+  const std::vector v{1, 2, 3, 4, 5};
+
+  GIVEN("a reversed interval")
+  {
+    REQUIRE_THROWS_AS(ezy::slice(v, 3, 1), std::logic_error);
+    REQUIRE_THROWS_AS(ezy::slice(v, 3, 1, ezy::bounds::throwing), std::logic_error);
+    REQUIRE(ezy::empty(ezy::slice(v, 3, 1, ezy::bounds::clamping)));
+
+    const auto checked = ezy::slice(v, 3, 1, ezy::bounds::checked);
+    REQUIRE(checked.error() == ezy::bounds_error::reversed_interval);
+  }
+
+  GIVEN("a valid interval")
+  {
+    REQUIRE(join_as_strings(ezy::slice(v, 1, 3, ezy::bounds::clamping)) == "23");
+    REQUIRE(join_as_strings(ezy::slice(v, 1, 3, ezy::bounds::checked).success()) == "23");
+  }
+}
+
 SCENARIO("slice on array")
 {
   int a[] = {1,2,3,4,5,6,7,8};
@@ -479,6 +608,13 @@ SCENARIO("take_while")
   REQUIRE(join_as_strings(ezy::take_while(v, [](int i) { return i != 5; })) == "1234");
 }
 
+SCENARIO("take_while with mutable lambda")
+{
+  std::vector<int> v{1,2,3,4,5,6,7,8};
+  auto taken = ezy::take_while(v, [last = 0](int i) mutable { last = i; return last != 5; });
+  REQUIRE(join_as_strings(taken) == "1234");
+}
+
 SCENARIO("take_while allows mutating")
 {
   std::vector<int> v{1,2,3,4,5,6,7,8};
@@ -597,6 +733,61 @@ SCENARIO("step_by works on array")
   REQUIRE(join_as_strings(ezy::step_by(a, 3), ",") == "1,4,7");
 }
 
+SCENARIO("drop, take and step_by over random access ranges")
+{
+  std::vector<int> v{0,1,2,3,4,5,6,7,8,9};
+
+  GIVEN("a container")
+  {
+    THEN("the views are random access")
+    {
+      using std::begin;
+      using category = std::iterator_traits<decltype(begin(ezy::step_by(v, 3)))>::iterator_category;
+      REQUIRE(std::is_same<category, std::random_access_iterator_tag>::value);
+
+      const auto strided = ezy::step_by(v, 3);
+      REQUIRE(strided.end() - strided.begin() == 4);
+      REQUIRE(strided.begin()[3] == 9);
+      REQUIRE(*(strided.end() - 1) == 9);
+      REQUIRE(ezy::size(ezy::step_by(v, 5)) == 2);
+      REQUIRE(ezy::size(ezy::drop(v, 4)) == 6);
+      REQUIRE(ezy::size(ezy::take(v, 4)) == 4);
+    }
+
+    THEN("the counts are clamped to the end")
+    {
+      REQUIRE(ezy::empty(ezy::drop(v, 11)));
+      REQUIRE(join_as_strings(ezy::take(v, 100)) == "0123456789");
+      REQUIRE(join_as_strings(ezy::step_by(v, 100)) == "0");
+      REQUIRE(join_as_strings(ezy::step_by(ezy::drop(v, 1), 4), ",") == "1,5,9");
+    }
+  }
+
+  GIVEN("a transformed container")
+  {
+    int calls = 0;
+    const auto counted = ezy::transform(v, [&calls](int i) { ++calls; return i * 10; });
+
+    THEN("the skipped elements are not touched")
+    {
+      REQUIRE(join_as_strings(ezy::step_by(ezy::drop(counted, 2), 4), ",") == "20,60");
+      REQUIRE(calls == 2);
+    }
+  }
+
+  GIVEN("a range which is not random access")
+  {
+    const std::list<int> l{0,1,2,3,4,5,6};
+    REQUIRE(join_as_strings(ezy::step_by(ezy::drop(l, 1), 3), ",") == "1,4");
+    REQUIRE(join_as_strings(ezy::take(l, 2)) == "01");
+  }
+
+  GIVEN("chunks")
+  {
+    REQUIRE(ezy::size(ezy::chunk(v, 4)) == 3);
+  }
+}
+
 SCENARIO("flatten")
 {
   std::vector<std::vector<int>> v{std::vector{1,2,3,4,5,6,7,8}, {}, std::vector{0,0,0}};
@@ -614,6 +805,100 @@ SCENARIO("find_element")
   REQUIRE(not_found == std::end(v));
 }
 
+namespace
+{
+  // searches every needle at every position of ranges of every size up to 80, compares to std::find
+  template <typename T>
+  int vectorized_find_mismatches()
+  {
+    int mismatches = 0;
+    for (std::size_t size = 0; size < 80; ++size)
+    {
+      std::vector<T> v(size);
+      for (std::size_t i = 0; i < size; ++i)
+        v[i] = static_cast<T>(i + 1);
+
+      for (std::size_t needle = 0; needle <= size + 1; ++needle)
+      {
+        const T t = static_cast<T>(needle);
+        mismatches += ezy::find_element(v, t) != std::find(v.begin(), v.end(), t);
+#ifdef EZY_SIMD_X86
+        // the sse2 kernel is used directly only if the cpu has no avx2
+        mismatches += ezy::detail::simd::find_any_sse2(v.data(), v.data() + v.size(), std::array{t})
+          != v.data() + (std::find(v.begin(), v.end(), t) - v.begin());
+#endif
+        mismatches += ezy::find_any_of(v, t, static_cast<T>(needle + 3)) != std::find_if(v.begin(), v.end(),
+            [&](T e) { return e == t || e == static_cast<T>(needle + 3); });
+      }
+    }
+    return mismatches;
+  }
+}
+
+SCENARIO("vectorized find_element")
+{
+  GIVEN("contiguous ranges of integral types")
+  {
+    REQUIRE(vectorized_find_mismatches<std::uint8_t>() == 0);
+    REQUIRE(vectorized_find_mismatches<std::int16_t>() == 0);
+    REQUIRE(vectorized_find_mismatches<std::uint32_t>() == 0);
+    REQUIRE(vectorized_find_mismatches<std::int64_t>() == 0);
+    REQUIRE(vectorized_find_mismatches<char>() == 0);
+  }
+
+  GIVEN("64 bit elements which differ only in one half")
+  {
+    const std::vector<std::uint64_t> v{0x100000001ull, 0x200000001ull, 0x100000002ull, 0x200000002ull};
+    REQUIRE(ezy::find_element(v, std::uint64_t{0x200000002ull}) == v.begin() + 3);
+    REQUIRE(ezy::find_element(v, std::uint64_t{0x100000003ull}) == v.end());
+  }
+
+  GIVEN("needles of other types")
+  {
+    const std::vector<std::uint8_t> bytes{1, 255, 0};
+    REQUIRE(ezy::find_element(bytes, 255) == bytes.begin() + 1);
+    REQUIRE(ezy::find_element(bytes, -1) == bytes.end());
+    REQUIRE(ezy::find_element(bytes, 511) == bytes.end());
+
+    const std::vector<std::int32_t> numbers{-1, 2};
+    REQUIRE(ezy::find_element(numbers, std::int64_t{2}) == numbers.begin() + 1);
+    REQUIRE(ezy::find_element(numbers, std::int64_t{-1}) == numbers.begin());
+    REQUIRE(ezy::find_element(numbers, std::int64_t{1} << 40) == numbers.end());
+  }
+
+  GIVEN("a string")
+  {
+    const std::string s = "a fairly long string, longer than the width of a vector register";
+    REQUIRE(ezy::find_element(s, 'v') == s.begin() + s.find('v'));
+    REQUIRE(ezy::contains(s, 'g'));
+    REQUIRE(!ezy::contains(s, 'z'));
+    REQUIRE(ezy::find_any_of(s, ',', 'x') == s.begin() + s.find(','));
+  }
+
+  GIVEN("an array")
+  {
+    const int primes[] = {2, 3, 5, 7, 11, 13, 17, 19, 23, 29};
+    REQUIRE(*ezy::find_element(primes, 29) == 29);
+    REQUIRE(ezy::find_any_of(primes, 4, 6, 8) == std::end(primes));
+  }
+}
+
+SCENARIO("find_any_of")
+{
+  GIVEN("a range which is not contiguous")
+  {
+    const std::list<int> l{1, 2, 3, 4};
+    REQUIRE(*ezy::find_any_of(l, 4, 3) == 3);
+    REQUIRE(ezy::find_any_of(l, 5, 6) == l.end());
+  }
+
+  GIVEN("non integral elements")
+  {
+    const std::vector<std::string> words{"a", "b", "c"};
+    REQUIRE(*ezy::find_any_of(words, "c", "b") == "b");
+  }
+}
+
 SCENARIO("find_element in temporary should not compile")
 {
   //const auto found = ezy::find_element(std::vector{1,2,3,4,5,6,7,8}, 5);
@@ -771,6 +1056,101 @@ SCENARIO("find_if a move_only type")
   REQUIRE(found->i == 4);
 }
 
+SCENARIO("find_all_keys")
+{
+  const std::vector<int> rows{40, 10, 30, 20, 10};
+
+  const auto values_of = [](const auto& found)
+  {
+    std::vector<int> values;
+    for (const auto& p : found)
+      values.push_back(p.has_value() ? *p.get() : -1);
+    return values;
+  };
+
+  GIVEN("an unsorted range")
+  {
+    const std::vector<int> keys{20, 50, 10, 20};
+    const auto found = ezy::find_all_keys(rows, keys);
+
+    THEN("the elements are found in the order of the keys")
+    {
+      REQUIRE(values_of(found) == std::vector{20, -1, 10, 20});
+    }
+
+    THEN("the first equal element is found")
+    {
+      REQUIRE(found[2].get() == &rows[1]);
+      REQUIRE(found[0].get() == found[3].get());
+    }
+  }
+
+  GIVEN("no keys")
+  {
+    REQUIRE(ezy::find_all_keys(rows, std::vector<int>{}).empty());
+  }
+
+  GIVEN("sorted range and sorted keys")
+  {
+    const std::vector<int> sorted_rows{1, 3, 3, 5, 7, 9};
+    const auto sorted_view = ezy::assume_sorted(sorted_rows);
+    const auto found = ezy::find_all_keys(sorted_view, ezy::assume_sorted(std::vector{0, 3, 4, 9}));
+    REQUIRE(values_of(found) == std::vector{-1, 3, -1, 9});
+    REQUIRE(found[1].get() == &sorted_rows[1]);
+  }
+
+  GIVEN("a range with find member")
+  {
+    const std::set<int> row_set{1, 2, 3};
+    REQUIRE(values_of(ezy::find_all_keys(row_set, std::list{3, 4})) == std::vector{3, -1});
+
+    const auto index = ezy::indexed(rows);
+    REQUIRE(values_of(ezy::find_all_keys(index, std::vector{30, 35})) == std::vector{30, -1});
+  }
+
+  GIVEN("the same as find for each key")
+  {
+    std::vector<int> many_rows;
+    for (int i = 0; i < 3000; ++i)
+      many_rows.push_back((i * 37) % 1000);
+
+    std::vector<int> keys;
+    for (int i = 0; i < 500; ++i)
+      keys.push_back((i * 13) % 1200);
+
+    const auto found = ezy::find_all_keys(many_rows, keys);
+    int mismatches = 0;
+    for (std::size_t i = 0; i < keys.size(); ++i)
+    {
+      const auto expected = std::find(many_rows.begin(), many_rows.end(), keys[i]);
+      mismatches += (expected == many_rows.end() ? nullptr : &*expected) != found[i].get();
+    }
+    REQUIRE(mismatches == 0);
+  }
+
+  GIVEN("a range of prvalues")
+  {
+    const auto tens = ezy::transform(rows, [](int i) { return i / 10; });
+    const auto found = ezy::find_all_keys(tens, std::vector{3, 5, 1});
+
+    THEN("copies of the elements are given back")
+    {
+      static_assert(std::is_same_v<decltype(found), const std::vector<ezy::optional<int>>>);
+      REQUIRE(found.size() == 3);
+      REQUIRE(found[0].value() == 3);
+      REQUIRE(!found[1].has_value());
+      REQUIRE(found[2].value() == 1);
+    }
+  }
+
+  GIVEN("a strong type with algo_find")
+  {
+    using Rows = ezy::strong_type<std::vector<int>, struct RowsTag, ezy::features::algo_find>;
+    const Rows strong_rows{1, 2, 3};
+    REQUIRE(values_of(strong_rows.find_all_keys(std::vector{2, 4})) == std::vector{2, -1});
+  }
+}
+
 SCENARIO("collect explicitly to the same type")
 {
   std::vector<int> v{1,2,3,4};
@@ -998,3 +1378,166 @@ SCENARIO("range(from, until, step)")
     REQUIRE(join_as_strings(r, ",") == "2,-1,-4,-7,-10,-13,-16");
   }
 }
+
+SCENARIO("views over shared and arena keepers")
+{
+  GIVEN("a shared vector")
+  {
+    auto numbers = ezy::experimental::make_shared_keeper(std::vector{1, 2, 3, 4});
+    const auto evens = ezy::filter(numbers, [](int i) { return i % 2 == 0; });
+    REQUIRE(numbers.use_count() == 2);
+
+    WHEN("the view is copied")
+    {
+      auto copied = evens;
+      THEN("the vector is not copied")
+      {
+        REQUIRE(numbers.use_count() == 3);
+        REQUIRE(ezy::collect<std::vector<int>>(copied) == std::vector{2, 4});
+      }
+    }
+  }
+
+  GIVEN("a vector in an arena")
+  {
+    std::pmr::monotonic_buffer_resource resource;
+    ezy::experimental::arena arena(resource);
+    const auto doubled = ezy::transform(
+        ezy::experimental::make_arena_keeper(arena, std::vector{1, 2, 3}),
+        [](int i) { return i * 2; });
+    auto copied = doubled;
+    REQUIRE(ezy::collect<std::vector<int>>(copied) == std::vector{2, 4, 6});
+  }
+}
+
+SCENARIO("collect results")
+{
+  using R = ezy::result<int, std::string>;
+  auto parse = [](const std::string& s) -> R {
+    if (!s.empty() && std::all_of(s.begin(), s.end(), [](char c) { return c >= '0' && c <= '9'; }))
+      return R{std::stoi(s)};
+    else
+      return R{"not a number: " + s};
+  };
+
+  GIVEN("a range of successes")
+  {
+    const std::vector<R> results{R{1}, R{2}, R{3}};
+    THEN("the successes are collected")
+    {
+      const auto collected = ezy::collect_results<std::vector<int>>(results);
+      static_assert(std::is_same_v<decltype(collected), const ezy::result<std::vector<int>, std::string>>);
+      REQUIRE(collected.success() == std::vector{1, 2, 3});
+      REQUIRE(ezy::collect_results<std::set>(results).success() == std::set{1, 2, 3});
+      REQUIRE(ezy::sequence(results).success() == std::vector{1, 2, 3});
+    }
+  }
+
+  GIVEN("a range with errors")
+  {
+    const std::vector<std::string> rows{"1", "x", "3", "y"};
+    THEN("the first error is given back")
+    {
+      REQUIRE(ezy::sequence(ezy::transform(rows, parse)).error() == "not a number: x");
+    }
+
+    THEN("traverse does not call the function after the first error")
+    {
+      int calls = 0;
+      const auto result = ezy::traverse(rows, [&](const std::string& s) { ++calls; return parse(s); });
+      REQUIRE(result.error() == "not a number: x");
+      REQUIRE(calls == 2);
+    }
+
+    THEN("partition_results splits successes and errors")
+    {
+      const auto [numbers, errors] = ezy::partition_results(ezy::transform(rows, parse));
+      REQUIRE(numbers == std::vector{1, 3});
+      REQUIRE(errors == std::vector<std::string>{"not a number: x", "not a number: y"});
+    }
+
+    THEN("partition_results appends to the given containers")
+    {
+      std::vector<int> numbers{0};
+      std::vector<std::string> errors;
+      numbers.reserve(rows.size() + 1);
+      ezy::partition_results(ezy::transform(rows, parse), numbers, errors);
+      REQUIRE(numbers == std::vector{0, 1, 3});
+      REQUIRE(errors.size() == 2);
+    }
+  }
+
+  GIVEN("an empty range")
+  {
+    REQUIRE(ezy::sequence(std::vector<R>{}).success().empty());
+  }
+
+  GIVEN("optionals")
+  {
+    using O = ezy::optional<int>;
+    REQUIRE(ezy::sequence(std::vector{O{1}, O{2}}).value() == std::vector{1, 2});
+    REQUIRE(!ezy::sequence(std::vector{O{1}, O{std::nullopt}}).has_value());
+  }
+
+  GIVEN("a temporary container of move only successes")
+  {
+    using Rm = ezy::result<move_only, std::string>;
+    std::vector<Rm> results;
+    results.emplace_back(move_only{1});
+    results.emplace_back(move_only{2});
+    THEN("they are moved out")
+    {
+      const auto collected = ezy::sequence(std::move(results));
+      REQUIRE(collected.success().size() == 2);
+      REQUIRE(collected.success()[1].i == 2);
+    }
+  }
+
+  GIVEN("a temporary array of move only successes")
+  {
+    using Rm = ezy::result<move_only, std::string>;
+    std::array<Rm, 2> results{Rm{move_only{1}}, Rm{move_only{2}}};
+    THEN("they are moved out")
+    {
+      const auto collected = ezy::collect_results<std::vector>(std::move(results));
+      REQUIRE(collected.success()[1].i == 2);
+    }
+  }
+
+  GIVEN("a temporary view of a container")
+  {
+    std::vector<ezy::result<std::string, int>> results{std::string("a"), std::string("b")};
+    THEN("the elements of the container are not moved from")
+    {
+      REQUIRE(ezy::sequence(ezy::take(results, 2)).success() == std::vector<std::string>{"a", "b"});
+      REQUIRE(results[0].success() == "a");
+    }
+  }
+
+  GIVEN("move only successes made by a view")
+  {
+    using Rm = ezy::result<move_only, std::string>;
+    const auto collected = ezy::traverse(std::vector{1, 2, 3}, [](int i) { return Rm{move_only{i}}; });
+    REQUIRE(collected.success()[2].i == 3);
+  }
+}
+
+SCENARIO("step_by and chunk with bounds policies")
+{
+  const std::vector v{1, 2, 3, 4, 5};
+
+  GIVEN("zero step")
+  {
+    REQUIRE_THROWS_AS(ezy::step_by(v, 0), std::logic_error);
+    REQUIRE(join_as_strings(ezy::step_by(v, 0, ezy::bounds::clamping)) == "12345");
+    REQUIRE(ezy::step_by(v, 0, ezy::bounds::checked).error() == ezy::bounds_error::zero_step);
+    REQUIRE(join_as_strings(ezy::step_by(v, 2, ezy::bounds::checked).success()) == "135");
+  }
+
+  GIVEN("zero chunk size")
+  {
+    REQUIRE_THROWS_AS(ezy::chunk(v, 0), std::logic_error);
+    REQUIRE(ezy::size(ezy::chunk(v, 0, ezy::bounds::clamping)) == 5);
+    REQUIRE(ezy::chunk(v, 0, ezy::bounds::checked).is_error());
+  }
+}
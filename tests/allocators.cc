@@ -0,0 +1,172 @@
+#include <catch.hpp>
+
+#include <ezy/algorithm>
+#include <ezy/small_vector.h>
+#include <ezy/strong_type>
+#include <ezy/result>
+
+#include <memory_resource>
+#include <set>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include "common.h"
+
+SCENARIO("collect with allocator")
+{
+  counting_resource resource;
+  const std::vector<int> numbers{1, 2, 3, 4};
+  const auto squares = ezy::transform(numbers, [](int i) { return i * i; });
+
+  GIVEN("a pmr container")
+  {
+    const auto collected = ezy::collect<std::pmr::vector<int>>(squares, &resource);
+    REQUIRE(collected == std::pmr::vector<int>{1, 4, 9, 16});
+    REQUIRE(collected.get_allocator().resource() == &resource);
+    REQUIRE(resource.allocations == 1);
+  }
+
+  GIVEN("a pmr container template")
+  {
+    const auto collected = ezy::collect<std::pmr::vector>(squares, &resource);
+    REQUIRE(collected == std::pmr::vector<int>{1, 4, 9, 16});
+    REQUIRE(collected.get_allocator().resource() == &resource);
+  }
+
+  GIVEN("a container which cannot be constructed from iterators and an allocator")
+  {
+    const auto collected = ezy::collect<std::pmr::unordered_set<int>>(squares, &resource);
+    REQUIRE(collected.size() == 4);
+    REQUIRE(collected.count(9) == 1);
+    REQUIRE(collected.get_allocator().resource() == &resource);
+  }
+
+  GIVEN("an ordered container")
+  {
+    const auto collected = ezy::collect<std::pmr::set<int>>(squares, &resource);
+    REQUIRE(*collected.begin() == 1);
+    REQUIRE(collected.get_allocator().resource() == &resource);
+  }
+
+  GIVEN("an allocator object")
+  {
+    const auto collected = ezy::collect<std::vector<int>>(squares, std::allocator<int>{});
+    REQUIRE(collected == std::vector{1, 4, 9, 16});
+  }
+
+  GIVEN("a small_vector which outgrows its inline buffer")
+  {
+    using V = ezy::small_vector<int, 2, std::pmr::polymorphic_allocator<int>>;
+    const auto collected = ezy::collect<V>(squares, &resource);
+    REQUIRE(!collected.is_inline());
+    REQUIRE(collected.get_allocator().resource() == &resource);
+    REQUIRE(resource.allocations == 1);
+  }
+}
+
+SCENARIO("iterable strong types to containers with allocator")
+{
+  counting_resource resource;
+  using Numbers = ezy::strong_type<std::vector<int>, struct NumbersTag, ezy::features::iterable>;
+  const Numbers numbers{1, 2, 3};
+
+  GIVEN("a container type")
+  {
+    const auto collected = numbers.map([](int i) { return i + 1; }).to<std::pmr::vector<int>>(&resource);
+    REQUIRE(collected == std::pmr::vector<int>{2, 3, 4});
+    REQUIRE(collected.get_allocator().resource() == &resource);
+  }
+
+  GIVEN("a container template")
+  {
+    const auto collected = numbers.to<std::pmr::vector>(&resource);
+    REQUIRE(collected == std::pmr::vector<int>{1, 2, 3});
+    REQUIRE(collected.get_allocator().resource() == &resource);
+  }
+}
+
+SCENARIO("join with allocator")
+{
+  counting_resource resource;
+  const std::vector<std::string> words{"a long enough word to be on the heap", "b", "c"};
+
+  GIVEN("an explicit return type")
+  {
+    const auto joined = ezy::join<std::pmr::string>(words, ", ", &resource);
+    REQUIRE(joined == "a long enough word to be on the heap, b, c");
+    REQUIRE(joined.get_allocator().resource() == &resource);
+    REQUIRE(resource.allocations > 0);
+  }
+
+  GIVEN("an empty range")
+  {
+    REQUIRE(ezy::join<std::pmr::string>(std::vector<std::string>{}, ", ", &resource).empty());
+  }
+
+  GIVEN("a range of pmr strings")
+  {
+    const std::pmr::vector<std::pmr::string> pmr_words{{"x", "y"}, &resource};
+    const auto joined = ezy::join(pmr_words, "-", &resource);
+    REQUIRE(joined == "x-y");
+    REQUIRE(joined.get_allocator().resource() == &resource);
+  }
+
+  GIVEN("an iterable strong type")
+  {
+    using Words = ezy::strong_type<std::vector<std::pmr::string>, struct WordsTag, ezy::features::iterable>;
+    const Words strong_words{std::pmr::string{"x"}, std::pmr::string{"y"}};
+    REQUIRE(strong_words.join("+", &resource) == "x+y");
+  }
+}
+
+SCENARIO("result algorithms with allocator")
+{
+  counting_resource resource;
+  using R = ezy::result<int, std::string>;
+  const std::vector<R> results{R{1}, R{"failed"}, R{3}};
+  const std::vector<R> successes{R{1}, R{2}};
+
+  GIVEN("collect_results")
+  {
+    const auto collected = ezy::collect_results<std::pmr::vector>(successes, &resource);
+    REQUIRE(collected.success() == std::pmr::vector<int>{1, 2});
+    REQUIRE(collected.success().get_allocator().resource() == &resource);
+    REQUIRE(ezy::collect_results<std::pmr::vector<int>>(results, &resource).error() == "failed");
+  }
+
+  GIVEN("traverse")
+  {
+    const auto traversed = ezy::traverse<std::pmr::vector>(std::vector{1, 2},
+        [](int i) { return R{i * 2}; }, &resource);
+    REQUIRE(traversed.success() == std::pmr::vector<int>{2, 4});
+    REQUIRE(traversed.success().get_allocator().resource() == &resource);
+  }
+
+  GIVEN("partition_results")
+  {
+    const std::vector<ezy::result<int, std::pmr::string>> pmr_results{1, std::pmr::string{"failed"}, 3};
+    const auto [values, errors] = ezy::partition_results<std::pmr::vector>(pmr_results, &resource);
+    REQUIRE(values == std::pmr::vector<int>{1, 3});
+    REQUIRE(errors.size() == 1);
+    REQUIRE(values.get_allocator().resource() == &resource);
+    REQUIRE(errors.get_allocator().resource() == &resource);
+    REQUIRE(errors.front().get_allocator().resource() == &resource);
+  }
+}
+
+SCENARIO("pipeline in an arena")
+{
+  // every allocation must be served from the buffer, the upstream resource throws std::bad_alloc
+  std::byte buffer[1024];
+  std::pmr::monotonic_buffer_resource arena{buffer, sizeof(buffer), std::pmr::null_memory_resource()};
+
+  const std::vector<int> numbers{1, 2, 3, 4, 5, 6};
+  const auto evens = ezy::collect<std::pmr::vector>(ezy::filter(numbers, [](int i) { return i % 2 == 0; }), &arena);
+  const auto words = ezy::collect<std::pmr::vector<std::pmr::string>>(
+      ezy::transform(evens, [](int i) { return std::to_string(i); }), &arena);
+  const auto joined = ezy::join<std::pmr::string>(words, ",", &arena);
+
+  REQUIRE(joined == "2,4,6");
+  REQUIRE(words.front().get_allocator().resource() == &arena);
+}
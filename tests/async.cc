@@ -0,0 +1,131 @@
+#include <catch.hpp>
+
+#include <ezy/algorithm>
+#include <ezy/async.h>
+#include <ezy/result> // bounds::checked
+#include <ezy/strong_type>
+#include <ezy/features/algo_async.h>
+
+#include <atomic>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "common.h"
+
+SCENARIO("async pipeline stage")
+{
+  GIVEN("a range")
+  {
+    std::vector<int> numbers(10000);
+    std::iota(numbers.begin(), numbers.end(), 0);
+
+    THEN("every element arrives in order")
+    {
+      const auto result = ezy::collect<std::vector<int>>(ezy::async(numbers, 16));
+      REQUIRE(result == numbers);
+    }
+
+    THEN("the upstream runs on another thread")
+    {
+      const auto consumer = std::this_thread::get_id();
+      const auto ids = ezy::transform(numbers, [](int) { return std::this_thread::get_id(); });
+      for (const auto& id : ezy::take(ezy::async(ids, 8), 3))
+        REQUIRE(id != consumer);
+    }
+
+    THEN("views can be used on both sides")
+    {
+      const auto squares = ezy::transform(numbers, [](int i) { return i * i; });
+      const auto odd = ezy::filter(ezy::async(squares, 64), [](int i) { return i % 2 == 1; });
+      REQUIRE(ezy::collect<std::vector<int>>(ezy::take(odd, 3)) == std::vector{1, 9, 25});
+    }
+
+    THEN("it can be chunked")
+    {
+      const auto chunked = ezy::chunk(ezy::async(ezy::take(numbers, 5), 4), 2);
+      REQUIRE(ezy::collect<std::vector<std::vector<int>>>(chunked) == std::vector<std::vector<int>>{{0, 1}, {2, 3}, {4}});
+    }
+  }
+
+  GIVEN("an empty range")
+  {
+    const std::vector<int> empty;
+    REQUIRE(ezy::empty(ezy::async(empty, 4)));
+  }
+
+  GIVEN("an infinite range")
+  {
+    THEN("the worker stops when the view is destroyed")
+    {
+      std::atomic<int> produced{0};
+      {
+        const auto counted = ezy::transform(ezy::iterate(0), [&produced](int i) { ++produced; return i; });
+        REQUIRE(ezy::collect<std::vector<int>>(ezy::take(ezy::async(counted, 4), 3)) == std::vector{0, 1, 2});
+      }
+      // backpressure: at most the capacity, and the one waiting to be pushed, after the consumed ones
+      REQUIRE(produced <= 3 + 4 + 1);
+    }
+  }
+
+  GIVEN("a range which throws")
+  {
+    const auto throwing = ezy::transform(ezy::iterate(0), [](int i)
+        {
+          if (i == 3)
+            throw std::runtime_error("decode error");
+          return i;
+        });
+
+    THEN("the exception is rethrown after the elements before it")
+    {
+      auto stage = ezy::async(throwing, 2);
+      std::vector<int> received;
+      REQUIRE_THROWS_AS(
+          [&] { for (int i : stage) received.push_back(i); }(),
+          std::runtime_error);
+      REQUIRE(received == std::vector{0, 1, 2});
+    }
+  }
+
+  GIVEN("move only elements")
+  {
+    const auto elements = ezy::take(ezy::transform(ezy::iterate(0), [](int i) { return move_only(i); }), 3);
+
+    THEN("they are moved through the queue")
+    {
+      auto stage = ezy::async(elements, 2);
+      int sum = 0;
+      for (auto& m : stage)
+      {
+        const move_only taken = std::move(m);
+        sum += taken.i;
+      }
+      REQUIRE(sum == 3);
+    }
+  }
+
+  GIVEN("a zero capacity")
+  {
+    REQUIRE_THROWS_AS(ezy::async(std::vector{1}, 0), std::logic_error);
+    REQUIRE(ezy::async(std::vector{1}, 0, ezy::bounds::checked).error() == ezy::bounds_error::zero_capacity);
+  }
+
+  GIVEN("a strong type with algo_async")
+  {
+    using Lines = ezy::strong_type<std::vector<std::string>, struct LinesTag,
+          ezy::features::algo_iterable, ezy::features::algo_async>;
+    const Lines lines{std::vector<std::string>{"a", "bb", "ccc"}};
+
+    THEN("the stages can be chained")
+    {
+      const auto total = lines
+        .map([](const std::string& s) { return s.size(); })
+        .async(2)
+        .accumulate(std::size_t{0});
+      REQUIRE(total == 6);
+    }
+  }
+}
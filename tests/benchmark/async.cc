@@ -0,0 +1,57 @@
+// Overlap of two CPU bound stages with ezy::async, compared to running them on one thread, and the per
+// element cost of the queue itself.
+// Not run by the tests: build the async_benchmark target and run it.
+
+#include <ezy/algorithm>
+#include <ezy/async.h>
+
+#include <chrono>
+#include <cstdio>
+#include <numeric>
+#include <vector>
+
+namespace
+{
+  template <typename Fn>
+  void print_time(const char* name, Fn fn)
+  {
+    const auto start = std::chrono::steady_clock::now();
+    const long long result = fn();
+    const auto stop = std::chrono::steady_clock::now();
+    const auto ms = std::chrono::duration<double, std::milli>(stop - start).count();
+    std::printf("%-36s %9.3f ms (%lld)\n", name, ms, result);
+  }
+
+  // stands for decoding or parsing: some work per element
+  long long work(long long value, int rounds)
+  {
+    for (int i = 0; i < rounds; ++i)
+      value = value * 6364136223846793005LL + 1442695040888963407LL;
+    return value & 0xff;
+  }
+}
+
+int main()
+{
+  std::vector<long long> input(1'000'000);
+  std::iota(input.begin(), input.end(), 0);
+
+  const auto decode = [](long long i) { return work(i, 200); };
+  const auto parse = [](long long i) { return work(i, 200); };
+
+  print_time("decode + parse, one thread", [&] {
+      return ezy::accumulate(ezy::transform(ezy::transform(input, decode), parse), 0LL);
+    });
+
+  print_time("decode | async | parse", [&] {
+      return ezy::accumulate(ezy::transform(ezy::async(ezy::transform(input, decode), 1024), parse), 0LL);
+    });
+
+  print_time("copy, one thread", [&] {
+      return ezy::accumulate(input, 0LL);
+    });
+
+  print_time("copy through async", [&] {
+      return ezy::accumulate(ezy::async(input, 1024), 0LL);
+    });
+}
@@ -0,0 +1,121 @@
+// Footprint of vectors of optionals/results and latency of map/and_then chains, compact vs. std based types.
+// Not run by the tests: build the compact_types_benchmark target and run it.
+
+#include <ezy/compact_optional>
+#include <ezy/compact_result>
+#include <ezy/experimental/value_provider.h>
+#include <ezy/optional>
+#include <ezy/result>
+
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+namespace
+{
+  // the results carry their discriminant in the niche of count (-1), the error has no state
+  struct count
+  {
+    int value;
+  };
+
+  struct too_small {};
+}
+
+template <>
+struct ezy::niche_traits<count>
+{
+  static constexpr count null_value() noexcept
+  { return count{-1}; }
+
+  static constexpr bool is_null(const count& c) noexcept
+  { return c.value == -1; }
+};
+
+namespace
+{
+  constexpr int elements = 1 << 20;
+  constexpr int repeats = 50;
+
+  template <typename Container>
+  void print_footprint(const char* name, const Container& c)
+  {
+    std::printf("%-36s %4zu bytes/element %8zu KiB\n", name, sizeof(typename Container::value_type),
+        c.capacity() * sizeof(typename Container::value_type) / 1024);
+  }
+
+  template <typename Fn>
+  void print_latency(const char* name, Fn fn)
+  {
+    long long sink = 0;
+    const auto start = std::chrono::steady_clock::now();
+    for (int r = 0; r < repeats; ++r)
+      sink += fn();
+    const auto stop = std::chrono::steady_clock::now();
+    const auto ns = std::chrono::duration<double, std::nano>(stop - start).count() / (double(repeats) * elements);
+    std::printf("%-36s %6.2f ns/element (%lld)\n", name, ns, sink);
+  }
+
+  template <typename Optional>
+  std::vector<Optional> make_optionals()
+  {
+    std::vector<Optional> v;
+    v.reserve(elements);
+    for (int i = 0; i < elements; ++i)
+      v.push_back(i % 7 == 0 ? Optional{std::nullopt} : Optional{i});
+    return v;
+  }
+
+  template <typename Result>
+  std::vector<Result> make_results()
+  {
+    std::vector<Result> v;
+    v.reserve(elements);
+    for (int i = 0; i < elements; ++i)
+      v.push_back(i % 7 == 0 ? Result::make_error(too_small{}) : Result::make_success(count{i}));
+    return v;
+  }
+
+  template <typename Optional>
+  long long optional_chain(const std::vector<Optional>& v)
+  {
+    const auto half = [](int i) { return i % 2 == 0 ? Optional{i / 2} : Optional{std::nullopt}; };
+    long long sum = 0;
+    for (const auto& o : v)
+      sum += o.map([](int i) { return i + 1; }).and_then(half).map([](int i) { return i * 3; }).value_or(0);
+    return sum;
+  }
+
+  template <typename Result>
+  long long result_chain(const std::vector<Result>& v)
+  {
+    const auto checked = [](count c) { return c.value > 1000 ? Result::make_success(count{c.value - 1000}) : Result::make_error(too_small{}); };
+    long long sum = 0;
+    for (const auto& r : v)
+      sum += r.map([](count c) { return count{c.value + 1}; }).and_then(checked).map([](count c) { return count{c.value * 3}; }).success_or(count{0}).value;
+    return sum;
+  }
+}
+
+int main()
+{
+  using StdOptional = ezy::optional<int>;
+  using NicheOptional = ezy::niche_optional<int, ezy::experimental::value_provider<-1>>;
+  using StdResult = ezy::strong_type<std::variant<count, too_small>, ezy::notag_t, ezy::features::result_like_continuation>;
+  using CompactResult = ezy::compact_result<count, too_small>;
+
+  const auto std_optionals = make_optionals<StdOptional>();
+  const auto niche_optionals = make_optionals<NicheOptional>();
+  const auto std_results = make_results<StdResult>();
+  const auto compact_results = make_results<CompactResult>();
+
+  print_footprint("vector<optional<int>>", std_optionals);
+  print_footprint("vector<niche_optional<int>>", niche_optionals);
+  print_footprint("vector<result<count, error>>", std_results);
+  print_footprint("vector<compact_result<count, error>>", compact_results);
+
+  print_latency("optional<int> chain", [&] { return optional_chain(std_optionals); });
+  print_latency("niche_optional<int> chain", [&] { return optional_chain(niche_optionals); });
+  print_latency("result<count, error> chain", [&] { return result_chain(std_results); });
+  print_latency("compact_result<count, error> chain", [&] { return result_chain(compact_results); });
+}
@@ -0,0 +1,81 @@
+// Latency of find_element, contains and find_any_of on contiguous ranges of integral types, compared to
+// std::find and to a scalar loop.
+// Not run by the tests: build the find_benchmark target and run it.
+
+#include <ezy/algorithm>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace
+{
+  constexpr int repeats = 20000;
+
+  template <typename Fn>
+  void print_latency(const char* name, std::size_t elements, Fn fn)
+  {
+    long long sink = 0;
+    const auto start = std::chrono::steady_clock::now();
+    for (int r = 0; r < repeats; ++r)
+      sink += fn();
+    const auto stop = std::chrono::steady_clock::now();
+    const auto ns = std::chrono::duration<double, std::nano>(stop - start).count() / (double(repeats) * elements);
+    std::printf("%-46s %6.3f ns/element (%lld)\n", name, ns, sink);
+  }
+
+  template <typename It, typename T>
+  It scalar_find(It first, It last, const T& value)
+  {
+    for (; first != last; ++first)
+      if (*first == value)
+        return first;
+    return last;
+  }
+
+  template <typename T>
+  void benchmark(const char* type_name, std::size_t elements)
+  {
+    // the needle is the last element, so the whole range is scanned
+    std::vector<T> v(elements, T{1});
+    v.back() = T{2};
+    volatile T needle = T{2};
+
+    char name[64];
+    std::snprintf(name, sizeof(name), "std::find vector<%s>[%zu]", type_name, elements);
+    print_latency(name, elements, [&] { return std::find(v.begin(), v.end(), T{needle}) - v.begin(); });
+
+    std::snprintf(name, sizeof(name), "scalar loop vector<%s>[%zu]", type_name, elements);
+    print_latency(name, elements, [&] { return scalar_find(v.begin(), v.end(), T{needle}) - v.begin(); });
+
+    std::snprintf(name, sizeof(name), "ezy::find_element vector<%s>[%zu]", type_name, elements);
+    print_latency(name, elements, [&] { return ezy::find_element(v, T{needle}) - v.begin(); });
+
+    std::snprintf(name, sizeof(name), "std::find_if (3 needles) vector<%s>[%zu]", type_name, elements);
+    print_latency(name, elements, [&] {
+        const T n = needle;
+        return std::find_if(v.begin(), v.end(), [n](T e) { return e == 5 || e == 7 || e == n; }) - v.begin();
+      });
+
+    std::snprintf(name, sizeof(name), "ezy::find_any_of (3) vector<%s>[%zu]", type_name, elements);
+    print_latency(name, elements, [&] { return ezy::find_any_of(v, T{5}, T{7}, T{needle}) - v.begin(); });
+  }
+}
+
+int main()
+{
+  for (std::size_t elements : {std::size_t{64}, std::size_t{2048}, std::size_t{1} << 16})
+  {
+    benchmark<std::uint8_t>("uint8_t", elements);
+    benchmark<std::uint16_t>("uint16_t", elements);
+    benchmark<std::uint32_t>("uint32_t", elements);
+    benchmark<std::uint64_t>("uint64_t", elements);
+  }
+
+  const std::string text(4096, 'a');
+  print_latency("ezy::contains string[4096]", text.size(), [&] { return ezy::contains(text, 'z'); });
+  print_latency("std::string::find string[4096]", text.size(), [&] { return text.find('z') != std::string::npos; });
+}
@@ -0,0 +1,69 @@
+// Per element cost of ezy::generator compared to ezy::iterate, and the cost of creating generators (with the
+// frame pool) compared to creating a vector.
+// Not run by the tests: build the generator_benchmark target and run it.
+
+#include <ezy/algorithm>
+#include <ezy/generator.h>
+
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+namespace
+{
+  template <typename Fn>
+  void print_latency(const char* name, long long count, Fn fn)
+  {
+    long long sink = 0;
+    const auto start = std::chrono::steady_clock::now();
+    sink += fn();
+    const auto stop = std::chrono::steady_clock::now();
+    const auto ns = std::chrono::duration<double, std::nano>(stop - start).count() / double(count);
+    std::printf("%-40s %7.3f ns (%lld)\n", name, ns, sink);
+  }
+
+  ezy::generator<long long> count_from(long long first)
+  {
+    for (long long i = first;; ++i)
+      co_yield i;
+  }
+
+  ezy::generator<long long> up_to(long long last)
+  {
+    for (long long i = 0; i < last; ++i)
+      co_yield i;
+  }
+}
+
+int main()
+{
+  constexpr long long elements = 10'000'000;
+  const auto odd = [](long long i) { return i % 2 == 1; };
+
+  print_latency("iterate, per element", elements, [&] {
+      return ezy::accumulate(ezy::filter(ezy::take(ezy::iterate(0LL), elements), odd), 0LL);
+    });
+
+  print_latency("generator, per element", elements, [&] {
+      return ezy::accumulate(ezy::filter(ezy::take(count_from(0), elements), odd), 0LL);
+    });
+
+  constexpr long long generators = 1'000'000;
+
+  print_latency("generator of 4 elements, per generator", generators, [&] {
+      long long sum = 0;
+      for (long long i = 0; i < generators; ++i)
+        sum += ezy::accumulate(up_to(4), 0LL);
+      return sum;
+    });
+
+  print_latency("vector of 4 elements, per vector", generators, [&] {
+      long long sum = 0;
+      for (long long i = 0; i < generators; ++i)
+      {
+        const std::vector<long long> v{0, 1, 2, 3};
+        sum += ezy::accumulate(v, 0LL);
+      }
+      return sum;
+    });
+}
@@ -0,0 +1,54 @@
+// Traversals of a 4096 x 4096 matrix: row-major, column-major (through a transposed md_view) and the same
+// elements in storage order; transposing copies with plain and with cache-blocked iteration.
+// Not run by the tests: build the md_view_benchmark target and run it.
+
+#include <ezy/algorithm>
+#include <ezy/md_view.h>
+
+#include <chrono>
+#include <cstdio>
+#include <numeric>
+#include <vector>
+
+namespace
+{
+  constexpr int n = 4096;
+  constexpr int repeats = 5;
+
+  template <typename Fn>
+  void print_time(const char* name, Fn fn)
+  {
+    long long sink = 0;
+    const auto start = std::chrono::steady_clock::now();
+    for (int r = 0; r < repeats; ++r)
+      sink += fn();
+    const auto stop = std::chrono::steady_clock::now();
+    const auto ms = std::chrono::duration<double, std::milli>(stop - start).count() / repeats;
+    std::printf("%-36s %9.3f ms/run (%lld)\n", name, ms, sink);
+  }
+}
+
+int main()
+{
+  std::vector<int> elements(static_cast<std::size_t>(n) * n);
+  std::iota(elements.begin(), elements.end(), 0);
+  std::vector<int> copy(elements.size());
+
+  const auto matrix = ezy::md_view(elements, n, n);
+
+  print_time("row-major sum", [&] { return ezy::accumulate(matrix, 0LL); });
+  print_time("column-major sum", [&] { return ezy::accumulate(matrix.transposed(), 0LL); });
+  print_time("column-major view in storage order", [&] { return ezy::accumulate(matrix.transposed().in_storage_order(), 0LL); });
+
+  print_time("transposing copy", [&] {
+      for (auto&& [from, to] : ezy::zip(matrix.transposed(), ezy::md_view(copy, n, n)))
+        to = from;
+      return copy[1];
+    });
+
+  print_time("transposing copy, blocked(32)", [&] {
+      for (auto&& [from, to] : ezy::zip(matrix.transposed().blocked(32), ezy::md_view(copy, n, n).blocked(32)))
+        to = from;
+      return copy[1];
+    });
+}
@@ -0,0 +1,70 @@
+// Splitting a batch into 64 shards: one filter view per shard (64 scans), compared to ezy::bucketize (one
+// pass, buckets allocated once) and its parallel version.
+// Not run by the tests: build the partition_benchmark target and run it.
+
+#include <ezy/algorithm>
+#include <ezy/parallel.h>
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <numeric>
+#include <vector>
+
+namespace
+{
+  template <typename Fn>
+  void print_time(const char* name, Fn fn)
+  {
+    const auto start = std::chrono::steady_clock::now();
+    const long long result = fn();
+    const auto stop = std::chrono::steady_clock::now();
+    const auto ms = std::chrono::duration<double, std::milli>(stop - start).count();
+    std::printf("%-36s %9.3f ms (%lld)\n", name, ms, result);
+  }
+
+  struct request
+  {
+    std::uint64_t session;
+    std::uint32_t payload[6];
+  };
+
+  std::size_t shard_of(const request& r)
+  {
+    return static_cast<std::size_t>((r.session * 0x9e3779b97f4a7c15ULL) >> 58);
+  }
+}
+
+int main()
+{
+  std::vector<request> batch(4'000'000);
+  for (std::size_t i = 0; i < batch.size(); ++i)
+    batch[i].session = i;
+
+  print_time("64 filters", [&] {
+      long long total = 0;
+      for (std::size_t s = 0; s < 64; ++s)
+      {
+        const auto shard = ezy::collect<std::vector<request>>(
+            ezy::filter(batch, [s](const request& r) { return shard_of(r) == s; }));
+        total += static_cast<long long>(shard.size() * s);
+      }
+      return total;
+    });
+
+  print_time("bucketize", [&] {
+      const auto shards = ezy::bucketize(batch, 64, shard_of);
+      long long total = 0;
+      for (std::size_t s = 0; s < 64; ++s)
+        total += static_cast<long long>(shards[s].size() * s);
+      return total;
+    });
+
+  print_time("bucketize, par_unseq_dynamic", [&] {
+      const auto shards = ezy::bucketize(ezy::par_unseq_dynamic, batch, 64, shard_of);
+      long long total = 0;
+      for (std::size_t s = 0; s < 64; ++s)
+        total += static_cast<long long>(shards[s].size() * s);
+      return total;
+    });
+}
@@ -0,0 +1,76 @@
+// Sorting records by a computed key: collect + std::sort with the key computed in the comparator, compared
+// to ezy::sorted_by (keys computed once, radix sort) and its parallel version.
+// Not run by the tests: build the sort_benchmark target and run it.
+
+#include <ezy/algorithm>
+#include <ezy/parallel.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+namespace
+{
+  template <typename Fn>
+  void print_time(const char* name, Fn fn)
+  {
+    const auto start = std::chrono::steady_clock::now();
+    const long long result = fn();
+    const auto stop = std::chrono::steady_clock::now();
+    const auto ms = std::chrono::duration<double, std::milli>(stop - start).count();
+    std::printf("%-36s %9.3f ms (%lld)\n", name, ms, result);
+  }
+
+  struct record
+  {
+    std::uint64_t id;
+    std::uint32_t payload[6];
+  };
+
+  // stands for an expensive key: a hash of the id
+  std::int64_t key_of(const record& r)
+  {
+    std::uint64_t h = r.id;
+    for (int i = 0; i < 16; ++i)
+      h = h * 6364136223846793005ULL + 1442695040888963407ULL;
+    return static_cast<std::int64_t>(h >> 1);
+  }
+}
+
+int main()
+{
+  std::mt19937_64 engine(42);
+  std::vector<record> records(2'000'000);
+  for (record& r : records)
+    r.id = engine();
+
+  print_time("collect + std::sort, key in compare", [&] {
+      auto copy = ezy::collect<std::vector<record>>(records);
+      std::sort(copy.begin(), copy.end(), [](const record& lhs, const record& rhs) { return key_of(lhs) < key_of(rhs); });
+      return static_cast<long long>(copy.front().id & 0xff);
+    });
+
+  print_time("sorted_by", [&] {
+      return static_cast<long long>(ezy::sorted_by(records, key_of).front().id & 0xff);
+    });
+
+  print_time("sorted_by, par_unseq_dynamic", [&] {
+      return static_cast<long long>(ezy::sorted_by(ezy::par_unseq_dynamic, records, key_of).front().id & 0xff);
+    });
+
+  std::vector<std::int64_t> keys(records.size());
+  std::transform(records.begin(), records.end(), keys.begin(), key_of);
+
+  print_time("std::sort of integers", [&] {
+      auto copy = keys;
+      std::sort(copy.begin(), copy.end());
+      return static_cast<long long>(copy.front() & 0xff);
+    });
+
+  print_time("sorted of integers (radix)", [&] {
+      return static_cast<long long>(ezy::sorted(keys).front() & 0xff);
+    });
+}
@@ -0,0 +1,142 @@
+#include <catch.hpp>
+
+#include <ezy/bulk.h>
+#include <ezy/strong_type>
+
+#include <vector>
+#include <array>
+
+namespace
+{
+  using Meters = ezy::strong_type<double, struct meters_tag, ezy::features::addable, ezy::features::multipliable>;
+  using Seconds = ezy::strong_type<double, struct seconds_tag, ezy::features::addable>;
+  using Name = ezy::strong_type<std::string, struct name_tag>;
+}
+
+SCENARIO("has_underlying_layout")
+{
+  static_assert(ezy::has_underlying_layout_v<Meters>);
+  static_assert(ezy::has_underlying_layout_v<ezy::strong_type<int, struct Tag>>);
+  static_assert(!ezy::has_underlying_layout_v<Name>);
+  static_assert(!ezy::has_underlying_layout_v<ezy::strong_type<int&, struct Tag>>);
+  static_assert(!ezy::has_underlying_layout_v<double>);
+}
+
+SCENARIO("underlying_span")
+{
+  GIVEN("a vector of strong types")
+  {
+    std::vector<Meters> distances{Meters{1.0}, Meters{2.0}, Meters{3.5}};
+
+    WHEN("viewed as underlying")
+    {
+      auto span = ezy::underlying_span(distances);
+      static_assert(std::is_same_v<decltype(span.begin()), double*>);
+      REQUIRE(ezy::size(span) == 3);
+      REQUIRE(*span.begin() == 1.0);
+
+      THEN("modification is visible in the original")
+      {
+        *span.begin() = 10.0;
+        REQUIRE(distances[0].get() == 10.0);
+      }
+    }
+
+    WHEN("const vector viewed")
+    {
+      const auto& const_distances = distances;
+      auto span = ezy::underlying_span(const_distances);
+      static_assert(std::is_same_v<decltype(span.begin()), const double*>);
+      REQUIRE(ezy::accumulate(span, 0.0) == 6.5);
+    }
+  }
+}
+
+SCENARIO("bulk operations")
+{
+  GIVEN("vectors of strong types")
+  {
+    const std::vector<Meters> lhs{Meters{1.0}, Meters{2.0}, Meters{3.0}, Meters{4.0}, Meters{5.0}};
+    const std::vector<Meters> rhs{Meters{10.0}, Meters{20.0}, Meters{30.0}, Meters{40.0}, Meters{50.0}};
+
+    WHEN("added")
+    {
+      std::vector<Meters> out(lhs.size());
+      ezy::bulk::add(out, lhs, rhs);
+      REQUIRE(out[0].get() == 11.0);
+      REQUIRE(out[4].get() == 55.0);
+    }
+
+    WHEN("scaled")
+    {
+      auto scaled = lhs;
+      ezy::bulk::scale(scaled, 2.0);
+      REQUIRE(scaled[0].get() == 2.0);
+      REQUIRE(scaled[4].get() == 10.0);
+    }
+
+    WHEN("axpy")
+    {
+      auto y = rhs;
+      ezy::bulk::axpy(3.0, lhs, y);
+      REQUIRE(y[0].get() == 13.0);
+      REQUIRE(y[4].get() == 65.0);
+    }
+
+    WHEN("summed")
+    {
+      const auto sum = ezy::bulk::sum(lhs);
+      static_assert(std::is_same_v<decltype(sum), const Meters>);
+      REQUIRE(sum.get() == 15.0);
+    }
+  }
+
+  GIVEN("arrays of arithmetic values")
+  {
+    const std::array<int, 6> values{1, 2, 3, 4, 5, 6};
+    REQUIRE(ezy::bulk::sum(values) == 21);
+
+    std::array<int, 6> doubled{};
+    ezy::bulk::add(doubled, values, values);
+    REQUIRE(doubled[5] == 12);
+  }
+
+  GIVEN("an empty range")
+  {
+    const std::vector<Seconds> empty;
+    REQUIRE(ezy::bulk::sum(empty).get() == 0.0);
+  }
+
+  GIVEN("small integers")
+  {
+    const std::vector<short> shorts{1, 2, 3, 4, 5};
+    static_assert(std::is_same_v<decltype(ezy::bulk::sum(shorts)), short>);
+    REQUIRE(ezy::bulk::sum(shorts) == 15);
+
+    const std::array<char, 3> chars{1, 2, 3};
+    REQUIRE(ezy::bulk::sum(chars) == 6);
+
+    using Count = ezy::strong_type<short, struct count_tag, ezy::features::addable>;
+    const std::vector<Count> counts{Count{short{1}}, Count{short{2}}, Count{short{3}}};
+    REQUIRE(ezy::bulk::sum(counts).get() == 6);
+  }
+
+  GIVEN("ranges longer than the vector registers")
+  {
+    std::vector<int> values(1001);
+    for (size_t i = 0; i < values.size(); ++i)
+      values[i] = static_cast<int>(i);
+
+    THEN("the tails are handled")
+    {
+      REQUIRE(ezy::bulk::sum(values) == 500500);
+
+      std::vector<int> out(values.size());
+      ezy::bulk::add(out, values, values);
+      ezy::bulk::scale(out, 3);
+      ezy::bulk::axpy(-6, values, out);
+      REQUIRE(ezy::bulk::sum(out) == 0);
+      REQUIRE(out.back() == 0);
+    }
+  }
+}
@@ -0,0 +1,114 @@
+/**
+ * Kernels for checking the generated code of strong type arithmetic.
+ *
+ * Every `strong_<kernel>` must compile to the same instructions as its `plain_<kernel>` pair (see
+ * compare_disassembly.cmake). Both are compiled with optimization, so the features must be inlined
+ * completely.
+ */
+#include <ezy/strong_type.h>
+#include <ezy/features/arithmetic.h>
+#include <ezy/quantity.h>
+
+#include <type_traits>
+#include <cstddef>
+
+using Meters = ezy::strong_type<double, struct meters_tag,
+      ezy::features::addable,
+      ezy::features::multipliable,
+      ezy::features::less
+    >;
+
+static_assert(std::is_trivially_copyable_v<Meters>);
+static_assert(std::is_standard_layout_v<Meters>);
+static_assert(sizeof(Meters) == sizeof(double));
+static_assert(alignof(Meters) == alignof(double));
+
+static_assert(noexcept(std::declval<Meters>() + std::declval<Meters>()));
+static_assert(noexcept(std::declval<Meters&>() += std::declval<Meters>()));
+static_assert(noexcept(std::declval<Meters>() * 2.0));
+static_assert(noexcept(std::declval<Meters>() < std::declval<Meters>()));
+
+static_assert((Meters{1.5} + Meters{2.0}).get() == 3.5);
+static_assert((Meters{1.5} * 2.0).get() == 3.0);
+static_assert(Meters{1.0} < Meters{2.0});
+
+using Length = ezy::quantity<double, ezy::si::length>;
+using Time = ezy::quantity<double, ezy::si::time>;
+using Velocity = ezy::quantity<double, ezy::si::velocity>;
+
+static_assert(std::is_trivially_copyable_v<Velocity>);
+static_assert(sizeof(Velocity) == sizeof(double));
+static_assert(std::is_same_v<decltype(std::declval<Length>() / std::declval<Time>()), Velocity>);
+static_assert(noexcept(std::declval<Length>() / std::declval<Time>()));
+static_assert((Length{3.0} / Time{2.0}).get() == 1.5);
+
+extern "C"
+{
+  double plain_sum(const double* values, size_t n)
+  {
+    double sum{0.0};
+    for (size_t i = 0; i < n; ++i)
+      sum += values[i];
+    return sum;
+  }
+
+  double strong_sum(const Meters* values, size_t n)
+  {
+    Meters sum{0.0};
+    for (size_t i = 0; i < n; ++i)
+      sum += values[i];
+    return sum.get();
+  }
+
+  void plain_add(double* out, const double* lhs, const double* rhs, size_t n)
+  {
+    for (size_t i = 0; i < n; ++i)
+      out[i] = lhs[i] + rhs[i];
+  }
+
+  void strong_add(Meters* out, const Meters* lhs, const Meters* rhs, size_t n)
+  {
+    for (size_t i = 0; i < n; ++i)
+      out[i] = lhs[i] + rhs[i];
+  }
+
+  void plain_axpy(double* out, double a, const double* x, const double* y, size_t n)
+  {
+    for (size_t i = 0; i < n; ++i)
+      out[i] = x[i] * a + y[i];
+  }
+
+  void strong_axpy(Meters* out, double a, const Meters* x, const Meters* y, size_t n)
+  {
+    for (size_t i = 0; i < n; ++i)
+      out[i] = x[i] * a + y[i];
+  }
+
+  size_t plain_count_less(const double* values, double limit, size_t n)
+  {
+    size_t count{0};
+    for (size_t i = 0; i < n; ++i)
+      count += values[i] < limit;
+    return count;
+  }
+
+  size_t strong_count_less(const Meters* values, Meters limit, size_t n)
+  {
+    size_t count{0};
+    for (size_t i = 0; i < n; ++i)
+      count += values[i] < limit;
+    return count;
+  }
+
+  void plain_velocity(double* out, const double* distance, const double* time, size_t n)
+  {
+    for (size_t i = 0; i < n; ++i)
+      out[i] = distance[i] / time[i];
+  }
+
+  void strong_velocity(Velocity* out, const Length* distance, const Time* time, size_t n)
+  {
+    for (size_t i = 0; i < n; ++i)
+      out[i] = distance[i] / time[i];
+  }
+}
@@ -0,0 +1,46 @@
+# Compares the disassembly of `plain_<kernel>` and `strong_<kernel>` function pairs.
+#
+# Parameters:
+#   OBJDUMP - path to objdump
+#   OBJECT  - object file containing the kernels
+#   KERNELS - list of kernel names
+
+function(disassemble symbol out_var)
+  execute_process(
+    COMMAND ${OBJDUMP} -d --no-show-raw-insn --disassemble=${symbol} ${OBJECT}
+    OUTPUT_VARIABLE disassembly
+    RESULT_VARIABLE result
+  )
+  if (NOT result EQUAL 0)
+    message(FATAL_ERROR "objdump failed on ${OBJECT}")
+  endif()
+
+  string(REPLACE ";" "," disassembly "${disassembly}")
+  string(REPLACE "\n" ";" lines "${disassembly}")
+
+  set(body "")
+  foreach(line IN LISTS lines)
+    if (line MATCHES "^ *[0-9a-f]+:\t(.*)$")
+      # branch targets are printed as absolute addresses, keep only the offset within the function
+      string(REGEX REPLACE "[0-9a-f]+ <${symbol}(\\+0x[0-9a-f]+)?>" "<\\1>" instruction "${CMAKE_MATCH_1}")
+      string(APPEND body "  ${instruction}\n")
+    endif()
+  endforeach()
+
+  if (body STREQUAL "")
+    message(FATAL_ERROR "${symbol} is not found in ${OBJECT}")
+  endif()
+
+  set(${out_var} "${body}" PARENT_SCOPE)
+endfunction()
+
+foreach(kernel IN LISTS KERNELS)
+  disassemble(plain_${kernel} plain)
+  disassemble(strong_${kernel} strong)
+  if (NOT plain STREQUAL strong)
+    message(FATAL_ERROR
+      "Generated code of strong_${kernel} differs from plain_${kernel}\n"
+      "plain_${kernel}:\n${plain}\n"
+      "strong_${kernel}:\n${strong}")
+  endif()
+endforeach()
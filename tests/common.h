@@ -1,6 +1,8 @@
 #ifndef TESTS_COMMON_H_INCLUDED
 #define TESTS_COMMON_H_INCLUDED
 
+#include <memory_resource>
+
 struct move_only
 {
   int i;
@@ -25,5 +27,28 @@ struct non_transferable
   non_transferable& operator=(non_transferable&&) = delete;
 };
 
+// counts the allocations, the memory is allocated by new_delete_resource
+struct counting_resource : std::pmr::memory_resource
+{
+  int allocations{0};
+  int deallocations{0};
+
+  void* do_allocate(std::size_t bytes, std::size_t alignment) override
+  {
+    ++allocations;
+    return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+  }
+
+  void do_deallocate(void* p, std::size_t bytes, std::size_t alignment) override
+  {
+    ++deallocations;
+    std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+  }
+
+  bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override
+  {
+    return this == &other;
+  }
+};
 
 #endif
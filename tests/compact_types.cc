@@ -0,0 +1,205 @@
+#include <catch.hpp>
+
+#include <ezy/compact_optional>
+#include <ezy/compact_result>
+#include <ezy/experimental/value_provider.h>
+
+#include <string>
+#include <vector>
+
+namespace
+{
+  enum class error_code : unsigned char { none, invalid, overflow };
+
+  // results without a value
+  struct done {};
+  struct not_found {};
+}
+
+template <>
+struct ezy::niche_traits<error_code>
+{
+  static constexpr error_code null_value() noexcept
+  { return error_code::none; }
+
+  static constexpr bool is_null(const error_code& e) noexcept
+  { return e == error_code::none; }
+};
+
+namespace
+{
+  using Index = ezy::niche_optional<int, ezy::experimental::value_provider<-1>>;
+  using IntResult = ezy::compact_result<int, error_code>;
+
+  auto parse_digit = [](char c) -> IntResult
+  {
+    if (c < '0' || c > '9')
+      return IntResult::make_error(error_code::invalid);
+
+    return IntResult::make_success(c - '0');
+  };
+}
+
+SCENARIO("niche optional")
+{
+  static_assert(sizeof(Index) == sizeof(int));
+  static_assert(sizeof(std::vector<Index>::value_type) == sizeof(int));
+  static_assert(std::is_trivially_copyable_v<Index>);
+
+  GIVEN("a value")
+  {
+    const Index i{5};
+    REQUIRE(i.has_value());
+    REQUIRE(i.value() == 5);
+    REQUIRE(*i == 5);
+    REQUIRE(i.value_or(3) == 5);
+  }
+
+  GIVEN("nothing")
+  {
+    const Index i{std::nullopt};
+    REQUIRE(!i.has_value());
+    REQUIRE(!i);
+    REQUIRE(i.value_or(3) == 3);
+    REQUIRE_THROWS_AS(i.value(), std::bad_optional_access);
+  }
+
+  GIVEN("the niche value")
+  {
+    const Index i{-1};
+    THEN("it is empty")
+    {
+      REQUIRE(!i.has_value());
+    }
+  }
+
+  GIVEN("map")
+  {
+    const auto twice = [](int i) { return i * 2; };
+    WHEN("success type does not change")
+    {
+      const auto mapped = Index{4}.map(twice);
+      THEN("the niche is kept")
+      {
+        static_assert(std::is_same_v<decltype(mapped), const Index>);
+        REQUIRE(mapped.value() == 8);
+        REQUIRE(!Index{std::nullopt}.map(twice).has_value());
+      }
+    }
+
+    WHEN("success type changes")
+    {
+      const auto mapped = Index{4}.map([](int i) { return i * 1.5; });
+      THEN("the compact storage of the new type is used")
+      {
+        static_assert(std::is_same_v<decltype(mapped), const ezy::compact_optional<double>>);
+        REQUIRE(mapped.value() == 6.0);
+      }
+    }
+  }
+
+  GIVEN("and_then")
+  {
+    const auto half = [](int i) { return i % 2 == 0 ? Index{i / 2} : Index{std::nullopt}; };
+    REQUIRE(Index{20}.and_then(half).and_then(half).value() == 5);
+    REQUIRE(!Index{10}.and_then(half).and_then(half).has_value());
+  }
+}
+
+SCENARIO("compact optional")
+{
+  static_assert(sizeof(ezy::compact_optional<int*>) == sizeof(int*));
+  static_assert(std::is_same_v<ezy::extract_underlying_type_t<ezy::compact_optional<int>>, std::optional<int>>);
+
+  int i = 3;
+  const ezy::compact_optional<int*> p{&i};
+  REQUIRE(p.has_value());
+  REQUIRE(**p == 3);
+  REQUIRE(!ezy::compact_optional<int*>{nullptr}.has_value());
+  REQUIRE(p.map([](int* ptr) { return *ptr + 1; }).value() == 4);
+}
+
+SCENARIO("compact result")
+{
+  static_assert(std::is_same_v<ezy::extract_underlying_type_t<IntResult>, std::variant<int, error_code>>);
+
+  GIVEN("a success")
+  {
+    const auto r = parse_digit('7');
+    REQUIRE(r.is_success());
+    REQUIRE(r.success() == 7);
+    REQUIRE(r.map([](int i) { return i + 1; }).success() == 8);
+    REQUIRE(r.and_then([](int i) { return parse_digit(static_cast<char>('0' + i - 5)); }).success() == 2);
+  }
+
+  GIVEN("an error")
+  {
+    const auto r = parse_digit('x');
+    REQUIRE(r.is_error());
+    REQUIRE(r.error() == error_code::invalid);
+    REQUIRE(r.map([](int i) { return i + 1; }).error() == error_code::invalid);
+    REQUIRE(r.success_or(-1) == -1);
+  }
+
+  GIVEN("map_error")
+  {
+    const auto mapped = parse_digit('x').map_error([](error_code) { return 0.5; });
+    static_assert(std::is_same_v<decltype(mapped), const ezy::compact_result<int, double>>);
+    REQUIRE(mapped.error() == 0.5);
+  }
+
+  GIVEN("an error type with a niche and an empty success type")
+  {
+    using Status = ezy::compact_result<done, error_code>;
+    static_assert(std::is_same_v<ezy::extract_underlying_type_t<Status>, ezy::basic_niche_result<done, error_code>>);
+    static_assert(sizeof(Status) == sizeof(error_code));
+    static_assert(std::is_trivially_copyable_v<Status>);
+
+    THEN("the niche value of the error means success")
+    {
+      const auto ok = Status::make_success();
+      REQUIRE(ok.is_success());
+      REQUIRE(ok.map([](done) { return 3; }).success() == 3);
+
+      const auto failed = Status::make_error(error_code::overflow);
+      REQUIRE(failed.is_error());
+      REQUIRE(failed.error() == error_code::overflow);
+      REQUIRE(failed.map([](done) { return 3; }).error() == error_code::overflow);
+    }
+  }
+
+  GIVEN("a success type with a niche and an empty error type")
+  {
+    using Lookup = ezy::compact_result<const int*, not_found>;
+    static_assert(sizeof(Lookup) == sizeof(const int*));
+
+    THEN("the niche value of the success means error")
+    {
+      const int i = 5;
+      const auto found = Lookup::make_success(&i);
+      REQUIRE(found.is_success());
+      REQUIRE(*found.success() == 5);
+      REQUIRE(Lookup::make_error(not_found{}).is_error());
+      REQUIRE(Lookup::make_success(nullptr).is_error());
+    }
+
+    THEN("rebinding to a type without a niche gives a variant")
+    {
+      const auto mapped = Lookup::make_error(not_found{}).map([](const int* p) { return *p; });
+      static_assert(std::is_same_v<decltype(mapped), const ezy::compact_result<int, not_found>>);
+      static_assert(std::is_same_v<ezy::extract_underlying_type_t<ezy::compact_result<int, not_found>>, std::variant<int, not_found>>);
+      REQUIRE(mapped.is_error());
+    }
+  }
+
+  GIVEN("non trivially copyable types")
+  {
+    const auto mapped = parse_digit('4').map([](int i) { return std::string(i, 'a'); });
+    THEN("they are stored in a variant")
+    {
+      static_assert(std::is_same_v<ezy::extract_underlying_type_t<std::remove_const_t<decltype(mapped)>>, std::variant<std::string, error_code>>);
+      REQUIRE(mapped.success() == "aaaa");
+      REQUIRE(mapped.map([](const std::string& s) { return static_cast<int>(s.size()); }).success() == 4);
+    }
+  }
+}
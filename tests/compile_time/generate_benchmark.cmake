@@ -0,0 +1,43 @@
+# Generates a translation unit with `types` strong types, each of them having `features` features
+# (rotated, so feature lists are different), instantiated and queried by has_feature.
+# Features depending on the underlying type (eg. multipliable) cannot be queried, they are left out.
+function(ezy_generate_compile_time_benchmark output types features)
+  set(all_features
+    addable
+    subtractable
+    equal_comparable
+    greater
+    greater_equal
+    less
+    less_equal
+    closed_multipliable
+    negatable
+  )
+  list(LENGTH all_features all_features_count)
+
+  if (features GREATER all_features_count)
+    message(FATAL_ERROR "At most ${all_features_count} features are available for the compile time benchmark")
+  endif()
+
+  set(content "// generated by generate_benchmark.cmake\n#include <ezy/strong_type>\n\n")
+
+  math(EXPR last_type "${types} - 1")
+  math(EXPR last_feature "${features} - 1")
+  foreach(i RANGE ${last_type})
+    set(feature_list "")
+    foreach(k RANGE ${last_feature})
+      math(EXPR index "(${i} + ${k}) % ${all_features_count}")
+      list(GET all_features ${index} feature)
+      string(APPEND feature_list ", ezy::features::${feature}")
+    endforeach()
+
+    string(APPEND content
+      "using type_${i} = ezy::strong_type<int, struct tag_${i}${feature_list}>;\n"
+      "static_assert(sizeof(type_${i}) == sizeof(int));\n"
+      "static_assert(ezy::has_feature_v<type_${i}, ezy::features::${feature}>);\n"
+      "static_assert(!ezy::has_feature_v<type_${i}, ezy::features::closed_divisible>);\n\n"
+    )
+  endforeach()
+
+  file(WRITE ${output} "${content}")
+endfunction()
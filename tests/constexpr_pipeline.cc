@@ -0,0 +1,138 @@
+#include <catch.hpp>
+
+#include <ezy/algorithm>
+#include <ezy/result> // bounds::checked
+
+#include <array>
+#include <cstdint>
+#include <stdexcept>
+#include <tuple>
+
+namespace
+{
+  constexpr std::array numbers{1, 2, 3, 4, 5, 6};
+
+  constexpr auto is_even = [](int i) { return i % 2 == 0; };
+  constexpr auto square = [](int i) { return i * i; };
+
+  // operator== of std::array is constexpr only from c++20
+  template <typename T, std::size_t N>
+  constexpr bool equal(const std::array<T, N>& lhs, const std::array<T, N>& rhs)
+  {
+    for (std::size_t i = 0; i < N; ++i)
+    {
+      if (lhs[i] != rhs[i])
+        return false;
+    }
+    return true;
+  }
+
+  template <typename Range>
+  constexpr int sum(const Range& range)
+  {
+    return ezy::accumulate(range, 0);
+  }
+
+  constexpr std::uint32_t crc_entry(std::uint32_t byte)
+  {
+    return ezy::accumulate(ezy::take(ezy::iterate(0), 8), byte,
+        [](std::uint32_t crc, int) { return (crc & 1u) ? (crc >> 1) ^ 0xEDB88320u : (crc >> 1); });
+  }
+}
+
+SCENARIO("adaptors in constant expressions")
+{
+  static_assert(sum(ezy::transform(numbers, square)) == 91);
+  static_assert(sum(ezy::filter(numbers, is_even)) == 12);
+  static_assert(sum(ezy::concatenate(numbers, std::array{10, 20})) == 51);
+  static_assert(sum(ezy::zip_with(std::plus<>{}, numbers, numbers)) == 42);
+  static_assert(sum(ezy::transform(ezy::zip(numbers, numbers), [](auto t) { return std::get<0>(t) * std::get<1>(t); })) == 91);
+  static_assert(sum(ezy::slice(numbers, 1, 3)) == 5);
+  static_assert(sum(ezy::slice(numbers, 3, 1, ezy::bounds::clamping)) == 0);
+  static_assert(sum(ezy::take(numbers, 2)) == 3);
+  static_assert(sum(ezy::take_while(numbers, [](int i) { return i < 4; })) == 6);
+  static_assert(sum(ezy::drop(numbers, 4)) == 11);
+  static_assert(sum(ezy::step_by(numbers, 2)) == 9);
+  static_assert(sum(ezy::flatten(std::array{std::array{1, 2}, std::array{3, 4}})) == 10);
+  static_assert(sum(ezy::take(ezy::cycle(std::array{1, 2}), 5)) == 7);
+  static_assert(sum(ezy::range(5)) == 10);
+  static_assert(sum(ezy::take(ezy::repeat(3), 3)) == 9);
+  static_assert(ezy::accumulate(ezy::chunk(numbers, 4), 0, [](int acc, auto chunk) { return acc * 10 + sum(chunk); }) == 111);
+  static_assert(ezy::accumulate(ezy::enumerate(numbers), std::size_t{0}, [](std::size_t acc, auto e) { return acc + std::get<0>(e); }) == 15);
+}
+
+SCENARIO("terminals in constant expressions")
+{
+  static_assert(ezy::all_of(numbers, [](int i) { return i > 0; }));
+  static_assert(ezy::any_of(numbers, is_even));
+  static_assert(ezy::none_of(numbers, [](int i) { return i > 6; }));
+  static_assert(*ezy::find_element(numbers, 4) == 4);
+  static_assert(*ezy::find_element_if(numbers, [](int i) { return i > 4; }) == 5);
+  static_assert(ezy::contains(numbers, 6));
+  static_assert(!ezy::contains(numbers, 7));
+  static_assert(*ezy::find_any_of(numbers, 7, 5, 3) == 3);
+  static_assert(ezy::size(ezy::filter(numbers, is_even)) == 3);
+  static_assert(!ezy::empty(ezy::filter(numbers, is_even)));
+}
+
+SCENARIO("collect into std::array in constant expressions")
+{
+  GIVEN("a pipeline")
+  {
+    constexpr auto squares = ezy::collect<std::array<int, 3>>(ezy::transform(ezy::filter(numbers, is_even), square));
+    static_assert(equal(squares, std::array{4, 16, 36}));
+  }
+
+  GIVEN("a shorter range")
+  THEN("collect_prefix value initializes the rest")
+  {
+    constexpr auto collected = ezy::collect_prefix<std::array<int, 4>>(ezy::take(numbers, 2));
+    static_assert(equal(collected, std::array{1, 2, 0, 0}));
+  }
+
+  GIVEN("a longer range")
+  THEN("collect_prefix takes the first elements")
+  {
+    constexpr auto collected = ezy::collect_prefix<std::array<int, 2>>(ezy::iterate(7));
+    static_assert(equal(collected, std::array{7, 8}));
+  }
+
+  GIVEN("a lookup table")
+  {
+    constexpr auto crc_table = ezy::collect<std::array<std::uint32_t, 256>>(
+        ezy::transform(ezy::range(std::uint32_t{256}), crc_entry));
+    static_assert(crc_table[0] == 0);
+    static_assert(crc_table[1] == 0x77073096u);
+    static_assert(crc_table[255] == 0x2D02EF8Du);
+  }
+
+  GIVEN("the same at run time")
+  {
+    const auto squares = ezy::collect<std::array<int, 3>>(ezy::transform(ezy::filter(numbers, is_even), square));
+    REQUIRE(squares == std::array{4, 16, 36});
+  }
+
+  GIVEN("a range of a different size")
+  THEN("collect is a bounds error")
+  {
+    REQUIRE_THROWS_AS((ezy::collect<std::array<int, 4>>(ezy::take(numbers, 2))), std::logic_error);
+    REQUIRE_THROWS_AS((ezy::collect<std::array<int, 2>>(ezy::iterate(7))), std::logic_error);
+  }
+
+  GIVEN("a range of a different size and a bounds policy")
+  {
+    THEN("clamping gives the prefix")
+    {
+      REQUIRE((ezy::collect<std::array<int, 4>>(ezy::take(numbers, 2), ezy::bounds::clamping)) == std::array{1, 2, 0, 0});
+      REQUIRE((ezy::collect<std::array<int, 2>>(ezy::iterate(7), ezy::bounds::clamping)) == std::array{7, 8});
+    }
+
+    THEN("checked gives back the error")
+    {
+      REQUIRE((ezy::collect<std::array<int, 4>>(ezy::take(numbers, 2), ezy::bounds::checked)).error()
+          == ezy::bounds_error::size_mismatch);
+      REQUIRE((ezy::collect<std::array<int, 2>>(ezy::take(numbers, 2), ezy::bounds::checked)).success()
+          == std::array{1, 2});
+    }
+  }
+}
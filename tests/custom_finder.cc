@@ -132,3 +132,154 @@ SCENARIO("custom find feature")
     }
   }
 }
+
+#include <ezy/algorithm.h>
+
+#include <list>
+#include <string>
+
+SCENARIO("find in a sorted range")
+{
+  const std::vector v{1, 3, 5, 7, 9, 11};
+  const auto sorted = ezy::assume_sorted(v);
+
+  GIVEN("elements of the range")
+  {
+    for (int i : v)
+    {
+      REQUIRE(ezy::find_element(sorted, i) != sorted.end());
+      REQUIRE(*ezy::find_element(sorted, i) == i);
+      REQUIRE(ezy::contains(sorted, i));
+    }
+  }
+
+  GIVEN("missing elements")
+  {
+    for (int i : {0, 2, 4, 10, 12})
+    {
+      REQUIRE(ezy::find_element(sorted, i) == sorted.end());
+      REQUIRE(!ezy::contains(sorted, i));
+    }
+  }
+
+  GIVEN("ezy::find and custom_find")
+  {
+    REQUIRE(*ezy::find(sorted, 7) == 7);
+    REQUIRE(!ezy::find(sorted, 8).has_value());
+
+    static constexpr auto myfind = ezy::custom_find<fake_result_maker>{};
+    REQUIRE(myfind(sorted, 9).engaged);
+    REQUIRE(!myfind(sorted, 10).engaged);
+  }
+
+  GIVEN("a descending range")
+  {
+    const auto descending = ezy::assume_sorted(std::vector{9, 5, 3}, std::greater<>{});
+    REQUIRE(ezy::contains(descending, 5));
+    REQUIRE(!ezy::contains(descending, 4));
+  }
+
+  GIVEN("a range which is not random access")
+  {
+    const std::list<int> l{2, 4, 6};
+    const auto sorted_list = ezy::assume_sorted(l);
+    REQUIRE(ezy::contains(sorted_list, 4));
+    REQUIRE(!ezy::contains(sorted_list, 5));
+  }
+
+  GIVEN("an empty range")
+  {
+    REQUIRE(!ezy::contains(ezy::assume_sorted(std::vector<int>{}), 1));
+  }
+
+  GIVEN("the same as a linear search")
+  {
+    std::vector<int> numbers;
+    for (int i = 0; i < 2000; ++i)
+      numbers.push_back(i * 3);
+
+    const auto sorted_numbers = ezy::assume_sorted(numbers);
+    int mismatches = 0;
+    for (int needle = -1; needle < 6001; ++needle)
+      mismatches += ezy::contains(sorted_numbers, needle) != ezy::contains(numbers, needle);
+
+    REQUIRE(mismatches == 0);
+  }
+
+  GIVEN("a constant expression")
+  {
+    static constexpr int primes[] = {2, 3, 5, 7, 11, 13};
+    static_assert(ezy::contains(ezy::assume_sorted(primes), 11));
+    static_assert(!ezy::contains(ezy::assume_sorted(primes), 12));
+  }
+}
+
+namespace
+{
+  struct route
+  {
+    std::string prefix;
+    int port;
+  };
+}
+
+SCENARIO("find in an indexed range")
+{
+  GIVEN("a range of numbers")
+  {
+    const std::vector v{5, 3, 8, 3, 1};
+    const auto index = ezy::indexed(v);
+
+    THEN("the elements are found")
+    {
+      for (int i : v)
+        REQUIRE(*ezy::find_element(index, i) == i);
+
+      REQUIRE(ezy::contains(index, 8));
+      REQUIRE(!ezy::contains(index, 4));
+      REQUIRE(*ezy::find(index, 1) == 1);
+    }
+
+    THEN("the first one of the duplicates is found")
+    {
+      REQUIRE(ezy::find_element(index, 3) == v.begin() + 1);
+    }
+  }
+
+  GIVEN("a key function")
+  {
+    const std::vector<route> routes{{"10.0", 80}, {"10.1", 443}, {"192.168", 22}};
+    const auto by_prefix = ezy::indexed(routes, &route::prefix);
+
+    REQUIRE(ezy::find_element(by_prefix, std::string("10.1"))->port == 443);
+    REQUIRE(ezy::contains(by_prefix, "192.168"));
+    REQUIRE(!ezy::contains(by_prefix, "172.16"));
+  }
+
+  GIVEN("an owned range")
+  {
+    auto index = ezy::indexed(std::vector{1, 2, 3});
+    auto moved = std::move(index);
+    REQUIRE(ezy::contains(moved, 2));
+    REQUIRE(!ezy::contains(moved, 4));
+  }
+
+  GIVEN("an empty range")
+  {
+    REQUIRE(!ezy::contains(ezy::indexed(std::vector<int>{}), 1));
+  }
+
+  GIVEN("the same as a linear search")
+  {
+    std::vector<int> numbers;
+    for (int i = 0; i < 2000; ++i)
+      numbers.push_back((i * 7919) % 4001);
+
+    const auto index = ezy::indexed(numbers);
+    int mismatches = 0;
+    for (int needle = 0; needle < 4001; ++needle)
+      mismatches += ezy::find_element(index, needle) != ezy::find_element(numbers, needle);
+
+    REQUIRE(mismatches == 0);
+  }
+}
@@ -654,6 +654,88 @@ SCENARIO("result like interface for std::optional")
 
 }
 
+SCENARIO("continuation chain")
+{
+  using R = ezy::result<int, std::string>;
+  auto twice = [](int i) { return i * 2; };
+  auto half = [](int i) -> R { if (i % 2 == 0) return R{i / 2}; else return R{std::string("odd")}; };
+
+  GIVEN("maps")
+  {
+    auto chain = R{10}.chain().map(twice).map(twice).map([](int i) { return i + 0.5; });
+    static_assert(std::is_same_v<decltype(chain)::result_type, ezy::result<double, std::string>>);
+    REQUIRE(std::move(chain).evaluate().success() == 40.5);
+    REQUIRE(R{std::string("error")}.chain().map(twice).map(twice).evaluate().error() == "error");
+  }
+
+  GIVEN("consecutive maps")
+  THEN("they are composed into one step")
+  {
+    auto chain = R{10}.chain().map(twice).map(twice).and_then(half).map(twice).map(twice);
+    using twice_t = decltype(twice);
+    using expected_chain_type = ezy::features::continuation_chain<
+      ezy::features::result_adapter, R,
+      ezy::features::detail::map_step<twice_t, twice_t>,
+      ezy::features::detail::and_then_step<decltype(half)>,
+      ezy::features::detail::map_step<twice_t, twice_t>
+    >;
+    static_assert(std::is_same_v<decltype(chain), expected_chain_type>);
+    REQUIRE(std::move(chain).evaluate().success() == 80);
+  }
+
+  GIVEN("and_then")
+  {
+    REQUIRE(R{12}.chain().and_then(half).map(twice).and_then(half).evaluate().success() == 6);
+    REQUIRE(R{10}.chain().and_then(half).map(twice).and_then(half).and_then(half).evaluate().error() == "odd");
+    REQUIRE(R{11}.chain().and_then(half).map(twice).evaluate().error() == "odd");
+  }
+
+  GIVEN("lvalue source")
+  {
+    const R r{10};
+    REQUIRE(r.chain().map(twice).evaluate().success() == 20);
+    REQUIRE(r.success() == 10);
+  }
+
+  GIVEN("std::optional")
+  {
+    using O = ezy::optional<int>;
+    REQUIRE(O{3}.chain().map(twice).map(twice).evaluate().value() == 12);
+    REQUIRE(!O{std::nullopt}.chain().map(twice).evaluate().has_value());
+  }
+
+  GIVEN("move only payload")
+  {
+    using Rm = ezy::result<move_only, std::string>;
+    auto increment = [](move_only&& m) { ++m.i; return std::move(m); };
+    auto checked = [](move_only&& m) { return Rm{std::move(m)}; };
+    REQUIRE(Rm{move_only{1}}.chain().map(increment).map(increment).and_then(checked).map(increment).evaluate().success().i == 4);
+    REQUIRE(Rm{move_only{1}}.map(increment).map(increment).success().i == 3);
+  }
+
+  GIVEN("copy counting payload")
+  {
+    struct counted
+    {
+      int* copies;
+      counted(int* copies) : copies(copies) {}
+      counted(const counted& other) : copies(other.copies) { ++*copies; }
+      counted(counted&&) = default;
+      counted& operator=(const counted& other) { copies = other.copies; ++*copies; return *this; }
+      counted& operator=(counted&&) = default;
+    };
+    using Rc = ezy::result<counted, std::string>;
+    auto pass = [](counted&& c) { return std::move(c); };
+
+    int copies = 0;
+    counted c = Rc{counted{&copies}}.map(pass).map(pass).success();
+    REQUIRE(copies == 0);
+
+    c = Rc{counted{&copies}}.chain().map(pass).map(pass).evaluate().success();
+    REQUIRE(copies == 0);
+  }
+}
+
 /**
  * strong type general
  */
@@ -1415,6 +1497,43 @@ SCENARIO("strong type integer arithmetic")
   }
 }
 
+SCENARIO("strong type arithmetic in constant expressions")
+{
+  using Meters = ezy::strong_type<double, struct Tag, ezy::features::additive, ezy::features::multiplicative, ezy::features::less>;
+
+  static_assert((Meters{1.5} + Meters{2.5}).get() == 4.0);
+  static_assert((Meters{2.5} - Meters{1.5}).get() == 1.0);
+  static_assert((Meters{1.5} * 2.0).get() == 3.0);
+  static_assert((Meters{3.0} / 2.0).get() == 1.5);
+  static_assert(Meters{1.0} < Meters{2.0});
+
+  static_assert(noexcept(Meters{1.0} + Meters{2.0}));
+  static_assert(noexcept(Meters{1.0} * 2.0));
+  static_assert(noexcept(Meters{1.0} / Meters{2.0}));
+  static_assert(std::is_trivially_copyable_v<Meters>);
+}
+
+namespace
+{
+  // == cannot throw, but != can
+  struct throwing_not_equal
+  {
+    int i;
+    bool operator==(const throwing_not_equal& other) const noexcept { return i == other.i; }
+    bool operator!=(const throwing_not_equal& other) const { return i != other.i; }
+  };
+}
+
+SCENARIO("noexcept of strong type comparison follows the called operator")
+{
+  using Strong = ezy::strong_type<throwing_not_equal, struct Tag, ezy::features::equal_comparable>;
+  const Strong one{throwing_not_equal{1}};
+  const Strong two{throwing_not_equal{2}};
+  static_assert(noexcept(one == two));
+  static_assert(!noexcept(one != two));
+  REQUIRE(one != two);
+}
+
 SCENARIO("negatable")
 {
   using Neg = ezy::strong_type<int, struct Tag, ezy::features::negatable>;
@@ -1496,6 +1615,7 @@ SCENARIO("strong type comparisons")
     using GE = ezy::strong_type<int, struct Tag, ezy::features::greater_equal, ezy::features::printable>;
     REQUIRE(GE{5} >= GE{4});
     REQUIRE(GE{5} >= GE{5});
+    REQUIRE(!(GE{4} >= GE{5}));
 
     using L = ezy::strong_type<int, struct Tag, ezy::features::less, ezy::features::printable>;
 
@@ -1634,6 +1754,14 @@ SCENARIO("compose")
     REQUIRE(double_length(12345) == 10);
     REQUIRE(ezy::compose(double_length, double_length)(12345) == 4);
   }
+
+  WHEN("composing mutable function objects")
+  {
+    auto numbered = ezy::compose([n = 0](int i) mutable { return i * 10 + n++; }, [](int i) { return i + 1; });
+
+    REQUIRE(numbered(1) == 11);
+    REQUIRE(numbered(1) == 12);
+  }
   // moving etc
 }
 
@@ -0,0 +1,205 @@
+#include <catch.hpp>
+
+#include <ezy/algorithm>
+#include <ezy/generator.h>
+#include <ezy/strong_type>
+#include <ezy/features/algo_iterable.h>
+
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace
+{
+  ezy::generator<int> count_from(int first)
+  {
+    for (int i = first;; ++i)
+      co_yield i;
+  }
+
+  ezy::generator<int> up_to(int last)
+  {
+    for (int i = 0; i < last; ++i)
+      co_yield i;
+  }
+
+  // the state does not fit into iterate: words separated by any number of spaces
+  ezy::generator<std::string> words(std::string_view text)
+  {
+    std::string word;
+    for (const char c : text)
+    {
+      if (c != ' ')
+      {
+        word += c;
+      }
+      else if (!word.empty())
+      {
+        co_yield word;
+        word.clear();
+      }
+    }
+
+    if (!word.empty())
+      co_yield word;
+  }
+
+  // yields the address of one of its locals, which is in the coroutine frame
+  ezy::generator<std::uintptr_t> frame_address()
+  {
+    int local = 0;
+    co_yield reinterpret_cast<std::uintptr_t>(&local);
+  }
+
+  ezy::generator<int> failing_after(int n)
+  {
+    for (int i = 0; i < n; ++i)
+      co_yield i;
+    throw std::runtime_error("failed");
+  }
+}
+
+SCENARIO("generator as a range")
+{
+  GIVEN("a finite generator")
+  {
+    THEN("it can be collected")
+    {
+      REQUIRE(ezy::collect<std::vector<int>>(up_to(4)) == std::vector{0, 1, 2, 3});
+    }
+
+    THEN("it can be iterated through")
+    {
+      int sum = 0;
+      for (int i : up_to(5))
+        sum += i;
+      REQUIRE(sum == 10);
+    }
+
+    THEN("it can be empty")
+    {
+      REQUIRE(ezy::empty(up_to(0)));
+    }
+  }
+
+  GIVEN("a generator with complex state")
+  {
+    THEN("the values are yielded")
+    {
+      const auto result = ezy::collect<std::vector<std::string>>(words("  one two   three "));
+      REQUIRE(result == std::vector<std::string>{"one", "two", "three"});
+    }
+  }
+
+  GIVEN("a generator which throws")
+  {
+    auto g = failing_after(2);
+    auto it = g.begin();
+
+    THEN("the exception is thrown from the increment, and the generator is finished")
+    {
+      REQUIRE(*it == 0);
+      ++it;
+      REQUIRE(*it == 1);
+      REQUIRE_THROWS_AS(++it, std::runtime_error);
+      REQUIRE(it == g.end());
+    }
+  }
+}
+
+SCENARIO("generator in pipelines")
+{
+  GIVEN("an infinite generator")
+  {
+    THEN("it can be transformed, filtered and taken")
+    {
+      const auto result = ezy::collect<std::vector<int>>(
+          ezy::take(ezy::filter(ezy::transform(count_from(1), [](int i) { return i * i; }),
+              [](int i) { return i % 2 == 0; }), 3));
+      REQUIRE(result == std::vector{4, 16, 36});
+    }
+
+    THEN("a take_while finishes it")
+    {
+      REQUIRE(ezy::accumulate(ezy::take_while(count_from(0), [](int i) { return i < 5; }), 0) == 10);
+    }
+  }
+
+  GIVEN("a generator by reference")
+  {
+    auto g = up_to(6);
+
+    THEN("consecutive views continue where the previous one stopped")
+    {
+      REQUIRE(ezy::collect<std::vector<int>>(ezy::take(g, 2)) == std::vector{0, 1});
+      // take stepped to the next element when it took the last one
+      REQUIRE(ezy::collect<std::vector<int>>(g) == std::vector{2, 3, 4, 5});
+    }
+  }
+
+  GIVEN("a chunked generator")
+  {
+    THEN("the chunks are buffered")
+    {
+      std::vector<std::vector<int>> chunks;
+      for (const auto& chunk : ezy::chunk(up_to(7), 3))
+        chunks.push_back(chunk);
+
+      REQUIRE(chunks == std::vector<std::vector<int>>{{0, 1, 2}, {3, 4, 5}, {6}});
+    }
+
+    THEN("the views keep it single pass")
+    {
+      const auto chunked = ezy::chunk(ezy::transform(up_to(4), [](int i) { return i * 10; }), 2);
+      REQUIRE(ezy::collect<std::vector<std::vector<int>>>(chunked) == std::vector<std::vector<int>>{{0, 10}, {20, 30}});
+    }
+  }
+
+  GIVEN("a strong type of a generator")
+  {
+    using Numbers = ezy::strong_type<ezy::generator<int>, struct NumbersTag, ezy::features::algo_iterable>;
+    Numbers numbers{count_from(1)};
+
+    THEN("the algorithms of algo_iterable can be used")
+    {
+      const auto result = std::move(numbers)
+        .map([](int i) { return i + 1; })
+        .filter([](int i) { return i % 3 == 0; })
+        .take(3)
+        .to<std::vector<int>>();
+      REQUIRE(result == std::vector{3, 6, 9});
+    }
+  }
+}
+
+SCENARIO("generator frames")
+{
+  GIVEN("a finished generator")
+  {
+    std::uintptr_t first_frame = 0;
+    {
+      auto g = frame_address();
+      first_frame = *g.begin();
+    }
+
+    THEN("its frame is reused by the next one")
+    {
+      auto g = frame_address();
+      REQUIRE(*g.begin() == first_frame);
+    }
+  }
+
+  GIVEN("a moved generator")
+  {
+    auto g = up_to(3);
+    auto moved = std::move(g);
+
+    THEN("the moved from generator is empty")
+    {
+      REQUIRE(g.begin() == g.end());
+      REQUIRE(ezy::collect<std::vector<int>>(moved) == std::vector{0, 1, 2});
+    }
+  }
+}
@@ -0,0 +1,174 @@
+#include <catch.hpp>
+
+#include <ezy/algorithm>
+#include <ezy/experimental/arena.h>
+#include <ezy/instrument.h>
+#include <ezy/small_vector.h>
+
+#include <memory_resource>
+#include <vector>
+
+#ifndef EZY_INSTRUMENT
+#error "instrumentation tests must be compiled with EZY_INSTRUMENT"
+#endif
+
+using ezy::instrument::counting;
+using ezy::instrument::stats_of;
+
+SCENARIO("predicate invocations")
+{
+  ezy::instrument::reset();
+  const std::vector<int> numbers{1, 2, 3, 4, 5, 6};
+
+  GIVEN("a filter")
+  {
+    const auto evens = ezy::filter(numbers, [](int i) { return i % 2 == 0; });
+    using iterator = decltype(evens.begin());
+
+    WHEN("it is iterated through")
+    {
+      int sum = 0;
+      for (int i : evens)
+        sum += i;
+
+      THEN("the predicate is called once for each element")
+      {
+        REQUIRE(sum == 12);
+        REQUIRE(stats_of<iterator>().invocations == numbers.size());
+        REQUIRE(stats_of<iterator>().constructions == 2); // begin and end
+        REQUIRE(stats_of<iterator>().copies == 0);
+      }
+    }
+  }
+
+  GIVEN("a transform")
+  {
+    const auto squares = ezy::transform(numbers, [](int i) { return i * i; });
+    using iterator = decltype(squares.begin());
+
+    THEN("the function is called once per dereference")
+    {
+      REQUIRE(ezy::accumulate(squares, 0) == 91);
+      REQUIRE(stats_of<iterator>().invocations == numbers.size());
+    }
+  }
+
+  GIVEN("a take_while")
+  {
+    const auto small = ezy::take_while(numbers, [](int i) { return i < 3; });
+    using iterator = decltype(small.begin());
+
+    THEN("the predicate is called until the first rejected element")
+    {
+      REQUIRE(ezy::size(small) == 2);
+      REQUIRE(stats_of<iterator>().invocations == 3);
+    }
+  }
+}
+
+SCENARIO("element copies")
+{
+  ezy::instrument::reset();
+  std::vector<counting<int>> numbers;
+  numbers.reserve(4);
+  for (int i = 0; i < 4; ++i)
+    numbers.emplace_back(i);
+
+  GIVEN("a pipeline of views")
+  {
+    int sum = 0;
+    ezy::for_each(ezy::filter(numbers, [](const auto& c) { return c.value > 0; }),
+        [&sum](const auto& c) { sum += c.value; });
+
+    THEN("no element is copied")
+    {
+      REQUIRE(sum == 6);
+      REQUIRE(stats_of<counting<int>>().copies == 0);
+      REQUIRE(stats_of<counting<int>>().moves == 0);
+    }
+  }
+
+  GIVEN("a collect")
+  {
+    const auto collected = ezy::collect<std::vector<counting<int>>>(numbers);
+
+    THEN("each element is copied once")
+    {
+      REQUIRE(collected == numbers);
+      REQUIRE(stats_of<counting<int>>().copies == numbers.size());
+    }
+  }
+}
+
+SCENARIO("keepers")
+{
+  ezy::instrument::reset();
+
+  GIVEN("a view over a temporary")
+  {
+    const auto view = ezy::filter(std::vector{1, 2, 3}, [](int i) { return i > 1; });
+    using owner = ezy::experimental::owner<std::vector<int>>;
+
+    THEN("the owning keeper is moved, but not copied")
+    {
+      REQUIRE(ezy::size(view) == 2);
+      REQUIRE(stats_of<owner>().copies == 0);
+    }
+  }
+
+  GIVEN("a shared keeper")
+  {
+    const auto shared = ezy::experimental::make_shared_keeper(std::vector{1, 2, 3});
+    const auto copy = shared;
+
+    THEN("it is allocated once, copied once")
+    {
+      using keeper = ezy::remove_cvref_t<decltype(shared)>;
+      REQUIRE(copy.get().size() == 3);
+      REQUIRE(stats_of<keeper>().allocations == 1);
+      REQUIRE(stats_of<keeper>().copies == 1);
+    }
+  }
+
+  GIVEN("an arena keeper")
+  {
+    std::pmr::monotonic_buffer_resource resource;
+    ezy::experimental::arena arena(resource);
+    const auto first = ezy::experimental::make_arena_keeper(arena, std::vector{1, 2, 3});
+    const auto second = ezy::experimental::make_arena_keeper(arena, std::vector{4});
+
+    THEN("its allocations are counted")
+    {
+      using keeper = ezy::remove_cvref_t<decltype(first)>;
+      REQUIRE(first.get().size() + second.get().size() == 4);
+      REQUIRE(stats_of<keeper>().allocations == 2);
+    }
+  }
+}
+
+SCENARIO("allocations of small_vector")
+{
+  ezy::instrument::reset();
+  using V = ezy::small_vector<int, 2>;
+
+  V v{1, 2};
+  REQUIRE(stats_of<V>().allocations == 0);
+
+  v.push_back(3);
+  v.push_back(4);
+  v.push_back(5);
+  REQUIRE(stats_of<V>().allocations == 2);
+}
+
+SCENARIO("registry")
+{
+  ezy::instrument::reset();
+  REQUIRE(ezy::instrument::registry::instance().snapshot().empty());
+
+  const std::vector<int> numbers{1, 2};
+  REQUIRE(ezy::size(ezy::filter(numbers, [](int) { return true; })) == 2);
+  REQUIRE(!ezy::instrument::registry::instance().snapshot().empty());
+
+  ezy::instrument::reset();
+  REQUIRE(ezy::instrument::registry::instance().snapshot().empty());
+}
@@ -1,7 +1,14 @@
 #include <catch.hpp>
 
+#include <ezy/experimental/arena.h>
 #include <ezy/experimental/keeper.h>
 
+#include <array>
+#include <cstddef>
+#include <memory_resource>
+
+#include "common.h"
+
 using ezy::experimental::owner;
 using ezy::experimental::reference_to;
 
@@ -260,3 +267,124 @@ SCENARIO("conversions")
 
   // TODO how to handle/mimic lifetime extension for const&
 }
+
+SCENARIO("shared keeper")
+{
+  using ezy::experimental::make_keeper;
+  using ezy::experimental::shared;
+
+  auto person = ezy::experimental::make_shared_keeper(Person{8});
+  static_assert(std::is_same_v<decltype(person), shared<Person>>);
+  REQUIRE(person.get().age == 8);
+  REQUIRE(person.use_count() == 1);
+
+  GIVEN("a copy")
+  {
+    auto other = person;
+    REQUIRE(person.use_count() == 2);
+
+    WHEN("the object is modified through the copy")
+    {
+      other.get().age = 9;
+      THEN("it is shared")
+      {
+        REQUIRE(person.get().age == 9);
+      }
+    }
+  }
+
+  GIVEN("a keeper made from it")
+  {
+    static_assert(std::is_same_v<decltype(make_keeper(person)), shared<Person>>);
+    static_assert(std::is_same_v<decltype(make_keeper(std::as_const(person))), shared<Person>>);
+    auto other = make_keeper(person);
+    REQUIRE(person.use_count() == 2);
+    REQUIRE(&other.get() == &person.get());
+  }
+
+  GIVEN("a deep copy")
+  {
+    auto copied = person.copy();
+    static_assert(std::is_same_v<decltype(copied), owner<Person>>);
+    REQUIRE(person.use_count() == 1);
+    REQUIRE(&copied.get() != &person.get());
+  }
+
+  GIVEN("a shared const")
+  {
+    shared<const Person> const_person = person;
+    REQUIRE(person.use_count() == 2);
+    REQUIRE(const_person.get().age == 8);
+  }
+}
+
+namespace
+{
+  struct Counted
+  {
+    int& destroyed;
+    ~Counted() { ++destroyed; }
+  };
+}
+
+SCENARIO("arena keeper")
+{
+  using ezy::experimental::make_keeper;
+  using ezy::experimental::in_arena;
+
+  std::array<std::byte, 256> buffer;
+  std::pmr::monotonic_buffer_resource resource(buffer.data(), buffer.size(), std::pmr::null_memory_resource());
+
+  GIVEN("an object moved into the arena")
+  {
+    ezy::experimental::arena arena(resource);
+    auto person = ezy::experimental::make_arena_keeper(arena, Person{10});
+    static_assert(std::is_same_v<decltype(person), in_arena<Person>>);
+    static_assert(std::is_trivially_copyable_v<decltype(person)>);
+    REQUIRE(person.get().age == 10);
+
+    const auto* address = reinterpret_cast<const std::byte*>(&person.get());
+    REQUIRE(address >= buffer.data());
+    REQUIRE(address < buffer.data() + buffer.size());
+
+    WHEN("a keeper made from it")
+    {
+      static_assert(std::is_same_v<decltype(make_keeper(person)), in_arena<Person>>);
+      auto other = make_keeper(person);
+      REQUIRE(&other.get() == &person.get());
+    }
+  }
+
+  GIVEN("an object with destructor")
+  {
+    int destroyed = 0;
+    {
+      ezy::experimental::arena arena(resource);
+      auto first = ezy::experimental::make_arena_keeper(arena, Counted{destroyed});
+      auto second = first;
+      arena.create<Counted>(Counted{destroyed});
+      destroyed = 0; // temporaries
+
+      REQUIRE(&second.get() == &first.get());
+    }
+    THEN("the destructors are called when the arena is destroyed")
+    {
+      REQUIRE(destroyed == 2);
+    }
+  }
+
+  GIVEN("trivially destructible objects in a resource which frees memory")
+  {
+    counting_resource counting;
+    {
+      ezy::experimental::arena arena(counting);
+      arena.create<int>(42);
+      REQUIRE(ezy::experimental::make_arena_keeper(arena, Person{10}).get().age == 10);
+    }
+    THEN("their memory is deallocated when the arena is destroyed")
+    {
+      REQUIRE(counting.allocations == 2);
+      REQUIRE(counting.deallocations == 2);
+    }
+  }
+}
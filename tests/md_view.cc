@@ -0,0 +1,208 @@
+#include <catch.hpp>
+
+#include <ezy/algorithm>
+#include <ezy/md_view.h>
+#include <ezy/parallel.h>
+#include <ezy/strong_type>
+
+#include <array>
+#include <numeric>
+#include <stdexcept>
+#include <tuple>
+#include <vector>
+
+namespace
+{
+  constexpr ezy::par_unseq_dynamic_t four_threads{4, 8};
+
+  template <typename Range>
+  std::vector<int> to_vector(const Range& range)
+  {
+    return ezy::collect<std::vector<int>>(range);
+  }
+
+  std::vector<int> numbers(int size)
+  {
+    std::vector<int> result(static_cast<std::size_t>(size));
+    std::iota(result.begin(), result.end(), 0);
+    return result;
+  }
+}
+
+SCENARIO("multi-dimensional views")
+{
+  // 0  1  2  3
+  // 4  5  6  7
+  // 8  9 10 11
+  auto elements = numbers(12);
+
+  GIVEN("a matrix")
+  {
+    const auto matrix = ezy::md_view(elements, 3, 4);
+
+    THEN("its elements are iterated in row-major order")
+    {
+      REQUIRE(matrix.size() == 12);
+      REQUIRE(matrix.extent(0) == 3);
+      REQUIRE(matrix.stride(0) == 4);
+      REQUIRE(matrix(2, 1) == 9);
+      REQUIRE(to_vector(matrix) == elements);
+    }
+
+    THEN("rows and columns are views")
+    {
+      REQUIRE(to_vector(matrix.row(1)) == std::vector{4, 5, 6, 7});
+      REQUIRE(to_vector(matrix.col(2)) == std::vector{2, 6, 10});
+      REQUIRE(matrix.col(2).stride(0) == 4);
+    }
+
+    THEN("a sub block is a view")
+    {
+      const auto block = matrix.sub_block({1, 1}, {2, 2});
+      REQUIRE(to_vector(block) == std::vector{5, 6, 9, 10});
+      REQUIRE(to_vector(block.transposed()) == std::vector{5, 9, 6, 10});
+      REQUIRE(ezy::size(matrix.sub_block({3, 4}, {0, 0})) == 0);
+    }
+
+    THEN("the transposed view does not copy")
+    {
+      const auto transposed = matrix.transposed();
+      REQUIRE(transposed.extent(0) == 4);
+      REQUIRE(transposed(3, 2) == 11);
+      REQUIRE(to_vector(transposed) == std::vector{0, 4, 8, 1, 5, 9, 2, 6, 10, 3, 7, 11});
+      REQUIRE(to_vector(transposed.row(1)) == to_vector(matrix.col(1)));
+    }
+
+    THEN("the transposed view can be iterated in storage order")
+    {
+      REQUIRE(to_vector(matrix.transposed().in_storage_order()) == elements);
+    }
+
+    THEN("it can be reshaped if it is contiguous")
+    {
+      REQUIRE(to_vector(matrix.reshaped(2, 6).col(5)) == std::vector{5, 11});
+      REQUIRE(to_vector(matrix.row(1).reshaped(2, 2).col(0)) == std::vector{4, 6});
+      REQUIRE_THROWS_AS(matrix.transposed().reshaped(12), std::logic_error);
+      REQUIRE_THROWS_AS(matrix.reshaped(5, 2), std::logic_error);
+    }
+
+    THEN("it can be iterated in blocks")
+    {
+      REQUIRE(to_vector(matrix.blocked(2)) == std::vector{0, 1, 4, 5, 2, 3, 6, 7, 8, 9, 10, 11});
+      REQUIRE(to_vector(matrix.blocked(3)) == std::vector{0, 1, 2, 4, 5, 6, 8, 9, 10, 3, 7, 11});
+      REQUIRE(to_vector(matrix.blocked(8)) == elements);
+      REQUIRE(ezy::size(matrix.blocked(2)) == 12);
+    }
+
+    THEN("its iterators are random access")
+    {
+      const auto transposed = matrix.transposed();
+      auto it = transposed.begin() + 7;
+      REQUIRE(*it == 6);
+      REQUIRE(*--it == 2);
+      REQUIRE(it[4] == 7);
+      REQUIRE(*(transposed.end() - 1) == 11);
+      REQUIRE(*--transposed.end() == 11);
+      REQUIRE(transposed.end() - transposed.begin() == 12);
+    }
+
+    THEN("invalid extents and indices are errors")
+    {
+      REQUIRE_THROWS_AS(ezy::md_view(elements, 5, 5), std::logic_error);
+      REQUIRE_THROWS_AS(matrix.row(3), std::logic_error);
+      REQUIRE_THROWS_AS(matrix.sub_block({2, 0}, {2, 4}), std::logic_error);
+      REQUIRE_THROWS_AS(matrix.blocked(0), std::logic_error);
+    }
+  }
+
+  GIVEN("a mutable matrix")
+  {
+    auto matrix = ezy::md_view(elements, 3, 4);
+
+    THEN("the elements can be written through any view")
+    {
+      for (int& i : matrix.transposed().row(0))
+        i = -1;
+
+      matrix(1, 1) = 100;
+      REQUIRE(elements[0] == -1);
+      REQUIRE(elements[8] == -1);
+      REQUIRE(elements[5] == 100);
+    }
+  }
+
+  GIVEN("more axes")
+  {
+    const auto elements3 = numbers(24);
+    const auto tensor = ezy::md_view(elements3, 2, 3, 4);
+
+    THEN("the axes are sliced and transposed")
+    {
+      REQUIRE(tensor(1, 2, 3) == 23);
+      REQUIRE(to_vector(tensor.slice<1>(2).row(1)) == std::vector{20, 21, 22, 23});
+      REQUIRE(tensor.transposed()(3, 2, 1) == 23);
+      REQUIRE(to_vector(tensor.transposed().in_storage_order()) == elements3);
+    }
+
+    THEN("the blocks are iterated in each slice of the first axis")
+    {
+      const auto blocked = to_vector(tensor.blocked(2));
+      REQUIRE(std::vector(blocked.begin(), blocked.begin() + 4) == std::vector{0, 1, 4, 5});
+      REQUIRE(std::vector(blocked.begin() + 12, blocked.begin() + 16) == std::vector{12, 13, 16, 17});
+      REQUIRE(ezy::accumulate(blocked, 0) == ezy::accumulate(elements3, 0));
+    }
+  }
+
+  GIVEN("an rvalue range")
+  {
+    THEN("the views own it")
+    {
+      auto column = ezy::md_view(numbers(6), 2, 3).transposed().row(1);
+      REQUIRE(to_vector(column) == std::vector{1, 4});
+    }
+  }
+
+  GIVEN("other views")
+  {
+    const auto matrix = ezy::md_view(elements, 3, 4);
+
+    THEN("they can be zipped and transformed")
+    {
+      const auto sums = ezy::transform(ezy::zip(matrix, matrix.transposed()),
+          [](const auto& pair) { return std::get<0>(pair) + std::get<1>(pair); });
+      REQUIRE(to_vector(sums) == std::vector{0, 5, 10, 4, 9, 14, 8, 13, 18, 12, 17, 22});
+
+      const auto squares = ezy::md_view(ezy::collect<std::vector<int>>(ezy::transform(elements, [](int i) { return i * i; })), 3, 4);
+      REQUIRE(to_vector(squares.col(1)) == std::vector{1, 25, 81});
+    }
+
+    THEN("the zipped blocks are in the same positions")
+    {
+      std::vector<int> copy(12);
+      const auto transposed_copy = ezy::md_view(copy, 4, 3).transposed();
+      for (auto&& [from, to] : ezy::zip(matrix.blocked(2), transposed_copy.blocked(2)))
+        to = from;
+
+      REQUIRE(to_vector(ezy::md_view(copy, 4, 3)) == to_vector(matrix.transposed()));
+    }
+
+    THEN("they can be split for the parallel algorithms")
+    {
+      const auto large = numbers(300 * 200);
+      const auto transposed = ezy::md_view(large, 300, 200).transposed();
+      REQUIRE(ezy::accumulate(four_threads, transposed, 0LL) == ezy::accumulate(large, 0LL));
+      REQUIRE(ezy::collect<std::vector<int>>(four_threads, transposed) == ezy::collect<std::vector<int>>(transposed));
+    }
+  }
+
+  GIVEN("a strong type with algo_iterable")
+  {
+    const auto image = ezy::make_strong<struct ImageTag, ezy::features::algo_iterable>(ezy::md_view(elements, 3, 4).col(3));
+
+    THEN("the algorithms are members")
+    {
+      REQUIRE(image.map([](int i) { return i * 2; }).accumulate(0) == 42);
+      REQUIRE(image.get().size() == 3);
+    }
+  }
+}
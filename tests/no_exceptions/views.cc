@@ -0,0 +1,52 @@
+// views must compile (and work) without exceptions, see the bounds policies in ezy/bits/bounds_policy.h
+
+#include <ezy/algorithm>
+#include <ezy/md_view.h>
+#include <ezy/result> // bounds::checked
+
+#include <array>
+#include <vector>
+
+static_assert(std::is_same_v<ezy::bounds::default_t, ezy::bounds::asserting_t>);
+
+int sum_of_slice(const std::vector<int>& v, unsigned from, unsigned until)
+{
+  return ezy::accumulate(ezy::slice(v, from, until), 0);
+}
+
+int sum_of_clamped_slice(const std::vector<int>& v, unsigned from, unsigned until)
+{
+  return ezy::accumulate(ezy::slice(v, from, until, ezy::bounds::clamping), 0);
+}
+
+int sum_of_checked_slice(const std::vector<int>& v, unsigned from, unsigned until)
+{
+  return ezy::slice(v, from, until, ezy::bounds::checked)
+    .map([](const auto& slice) { return ezy::accumulate(slice, 0); })
+    .success_or(-1);
+}
+
+int sum_of_every_nth(const std::vector<int>& v, std::size_t n)
+{
+  return ezy::accumulate(ezy::step_by(v, n, ezy::bounds::clamping), 0);
+}
+
+std::size_t number_of_chunks(const std::vector<int>& v, std::size_t n)
+{
+  return ezy::size(ezy::chunk(v, n, ezy::bounds::clamping));
+}
+
+int sum_of_taken_and_dropped(const std::vector<int>& v, std::size_t n)
+{
+  return ezy::accumulate(ezy::drop(ezy::take(v, n), 1), 0);
+}
+
+std::array<int, 3> first_three(const std::vector<int>& v)
+{
+  return ezy::collect<std::array<int, 3>>(v, ezy::bounds::checked).success_or(std::array<int, 3>{});
+}
+
+int sum_of_column(const std::vector<int>& v, std::size_t rows, std::size_t col)
+{
+  return ezy::accumulate(ezy::md_view(v, rows, v.size() / rows).col(col), 0);
+}
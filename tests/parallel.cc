@@ -0,0 +1,225 @@
+#include <catch.hpp>
+
+#include <ezy/algorithm>
+#include <ezy/parallel.h>
+
+#include <atomic>
+#include <list>
+#include <mutex>
+#include <numeric>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+  constexpr ezy::par_unseq_dynamic_t four_threads{4, 8};
+}
+
+SCENARIO("splittable ranges")
+{
+  std::vector<int> numbers(100);
+  std::iota(numbers.begin(), numbers.end(), 0);
+
+  GIVEN("a random access range")
+  {
+    REQUIRE(ezy::splittable<std::vector<int>>::value);
+    REQUIRE(!ezy::splittable<std::list<int>>::value);
+
+    const auto splitter = ezy::splittable<std::vector<int>>::splitter(numbers);
+    REQUIRE(splitter.size() == 100);
+
+    std::vector<int> part;
+    splitter.for_each_in(10, 13, [&part](int i) { part.push_back(i); });
+    REQUIRE(part == std::vector{10, 11, 12});
+  }
+
+  GIVEN("views")
+  {
+    const auto squares = ezy::transform(numbers, [](int i) { return i * i; });
+    const auto evens = ezy::filter(numbers, [](int i) { return i % 2 == 0; });
+    const auto zipped = ezy::zip(numbers, squares);
+    const auto chunked = ezy::chunk(numbers, 30);
+
+    THEN("they are split by the units of the underlying ranges")
+    {
+      REQUIRE(ezy::detail::make_splitter(squares).size() == 100);
+      REQUIRE(ezy::detail::make_splitter(evens).size() == 100);
+      REQUIRE(ezy::detail::make_splitter(zipped).size() == 100);
+      REQUIRE(ezy::detail::make_splitter(chunked).size() == 4);
+    }
+
+    THEN("views of views are split too")
+    {
+      const auto odd_squares = ezy::filter(squares, [](int i) { return i % 2 == 1; });
+      std::vector<int> part;
+      ezy::detail::make_splitter(odd_squares).for_each_in(0, 6, [&part](int i) { part.push_back(i); });
+      REQUIRE(part == std::vector{1, 9, 25});
+    }
+
+    THEN("drop, take and step_by over random access ranges are random access, so they are split")
+    {
+      const auto first_three = ezy::take(numbers, 3);
+      const auto every_seventh = ezy::step_by(numbers, 7);
+      REQUIRE(ezy::detail::make_splitter(first_three).size() == 3);
+      REQUIRE(ezy::detail::make_splitter(every_seventh).size() == 15);
+    }
+
+    THEN("views over single pass or not random access ranges are not split")
+    {
+      REQUIRE(!ezy::detail::is_splittable<decltype(ezy::take(evens, 3))>::value);
+      REQUIRE(!ezy::detail::is_splittable<decltype(ezy::zip(ezy::iterate(0), numbers))>::value);
+    }
+  }
+
+  GIVEN("a flattened range of random access ranges")
+  {
+    const std::vector<std::vector<int>> nested{{1, 2}, {}, {3}, {4, 5, 6}, {}};
+    const auto flat = ezy::flatten(nested);
+    const auto splitter = ezy::detail::make_splitter(flat);
+
+    THEN("it is split by the elements of the inner ranges")
+    {
+      REQUIRE(splitter.size() == 6);
+
+      std::vector<int> part;
+      splitter.for_each_in(1, 5, [&part](int i) { part.push_back(i); });
+      REQUIRE(part == std::vector{2, 3, 4, 5});
+    }
+  }
+
+  GIVEN("a flattened range of lists")
+  {
+    const std::vector<std::list<int>> nested{{1, 2}, {3}, {4, 5, 6}};
+    const auto flat = ezy::flatten(nested);
+    const auto splitter = ezy::detail::make_splitter(flat);
+
+    THEN("it is split by the inner ranges")
+    {
+      REQUIRE(splitter.size() == 3);
+    }
+  }
+}
+
+SCENARIO("parallel for_each")
+{
+  GIVEN("a range of irregular work")
+  {
+    std::vector<int> numbers(10000);
+    std::iota(numbers.begin(), numbers.end(), 0);
+
+    THEN("every element is visited once")
+    {
+      std::vector<std::atomic<int>> visits(numbers.size());
+      ezy::for_each(four_threads, numbers, [&visits](int i) { ++visits[static_cast<std::size_t>(i)]; });
+      REQUIRE(ezy::all_of(visits, [](const std::atomic<int>& v) { return v == 1; }));
+    }
+
+    THEN("the elements of a container can be modified")
+    {
+      ezy::for_each(four_threads, numbers, [](int& i) { i *= 2; });
+      REQUIRE(numbers[9999] == 19998);
+    }
+
+    THEN("more threads work on it")
+    {
+      std::mutex mutex;
+      std::set<std::thread::id> threads;
+      // the first elements are slow, the others steal the rest of the range
+      ezy::for_each(four_threads, numbers, [&](int i)
+          {
+            if (i < 8)
+              std::this_thread::sleep_for(std::chrono::milliseconds(20));
+
+            std::lock_guard<std::mutex> lock(mutex);
+            threads.insert(std::this_thread::get_id());
+          });
+      REQUIRE(threads.size() > 1);
+    }
+  }
+
+  GIVEN("a range which cannot be split")
+  {
+    const std::list<int> numbers{1, 2, 3};
+    int sum = 0;
+    ezy::for_each(four_threads, numbers, [&sum](int i) { sum += i; });
+    REQUIRE(sum == 6);
+  }
+
+  GIVEN("a function which throws")
+  {
+    const std::vector<int> numbers(1000, 1);
+    REQUIRE_THROWS_AS(
+        ezy::for_each(four_threads, numbers, [](int) { throw std::runtime_error("failed"); }),
+        std::runtime_error);
+  }
+}
+
+SCENARIO("parallel accumulate")
+{
+  std::vector<long long> numbers(100000);
+  std::iota(numbers.begin(), numbers.end(), 1);
+
+  GIVEN("a sum")
+  {
+    REQUIRE(ezy::accumulate(four_threads, numbers, 0LL) == 5000050000LL);
+    REQUIRE(ezy::accumulate(ezy::par_unseq_dynamic, ezy::filter(numbers, [](long long i) { return i % 2 == 0; }), 0LL)
+        == 2500050000LL);
+  }
+
+  GIVEN("an associative, but not commutative operation")
+  {
+    const std::vector<std::string> letters{"a", "b", "c", "d", "e", "f", "g", "h", "i", "j"};
+    const auto concatenated = ezy::accumulate(ezy::par_unseq_dynamic_t{4, 1}, letters, std::string{">"},
+        [](std::string lhs, const std::string& rhs) { return lhs + rhs; });
+    REQUIRE(concatenated == ">abcdefghij");
+  }
+
+  GIVEN("an empty range")
+  {
+    REQUIRE(ezy::accumulate(four_threads, std::vector<int>{}, 42) == 42);
+  }
+
+  GIVEN("a flattened range with heavy tailed inner ranges")
+  {
+    std::vector<std::vector<int>> adjacency(100);
+    adjacency[3].assign(50000, 1);
+    adjacency[50].assign(3, 1);
+    REQUIRE(ezy::accumulate(four_threads, ezy::flatten(adjacency), 0) == 50003);
+  }
+}
+
+SCENARIO("parallel collect")
+{
+  std::vector<int> numbers(10000);
+  std::iota(numbers.begin(), numbers.end(), 0);
+
+  GIVEN("a pipeline")
+  {
+    const auto odd_squares = ezy::transform(ezy::filter(numbers, [](int i) { return i % 2 == 1; }),
+        [](int i) { return i * i; });
+
+    THEN("the elements are collected in order")
+    {
+      REQUIRE(ezy::collect<std::vector<int>>(four_threads, odd_squares) == ezy::collect<std::vector<int>>(odd_squares));
+      REQUIRE(ezy::collect<std::vector>(four_threads, odd_squares).size() == 5000);
+    }
+  }
+
+  GIVEN("chunks")
+  {
+    const auto sizes = ezy::collect<std::vector<std::size_t>>(four_threads,
+        ezy::transform(ezy::chunk(numbers, 3000), [](const auto& chunk) { return ezy::size(chunk); }));
+    REQUIRE(sizes == std::vector<std::size_t>{3000, 3000, 3000, 1000});
+  }
+
+  GIVEN("zipped ranges")
+  {
+    const std::vector<int> other(5, 10);
+    const auto sums = ezy::collect<std::vector<int>>(four_threads,
+        ezy::zip_with([](int a, int b) { return a + b; }, numbers, other));
+    REQUIRE(sums == std::vector{10, 11, 12, 13, 14});
+  }
+}
@@ -0,0 +1,195 @@
+#include <catch.hpp>
+
+#include <ezy/algorithm>
+#include <ezy/parallel.h>
+#include <ezy/strong_type>
+#include <ezy/result> // bounds::checked
+
+#include <array>
+#include <atomic>
+#include <deque>
+#include <list>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "common.h"
+
+namespace
+{
+  constexpr ezy::par_unseq_dynamic_t four_threads{4, 0};
+
+  const auto is_even = [](int i) { return i % 2 == 0; };
+}
+
+SCENARIO("eager partitioning")
+{
+  std::vector<int> numbers(20);
+  std::iota(numbers.begin(), numbers.end(), 0);
+
+  GIVEN("a predicate")
+  {
+    THEN("the elements are partitioned into two containers, in order")
+    {
+      const auto [evens, odds] = ezy::partition_into(numbers, is_even);
+      REQUIRE(evens == std::vector{0, 2, 4, 6, 8, 10, 12, 14, 16, 18});
+      REQUIRE(odds == std::vector{1, 3, 5, 7, 9, 11, 13, 15, 17, 19});
+    }
+
+    THEN("the predicate is called once for each element")
+    {
+      int calls = 0;
+      ezy::partition_into(numbers, [&calls](int i) { ++calls; return i < 5; });
+      REQUIRE(calls == 20);
+    }
+
+    THEN("the container can be given")
+    {
+      const auto [evens, odds] = ezy::partition_into<std::deque<int>>(ezy::take(numbers, 5), is_even);
+      REQUIRE(evens == std::deque{0, 2, 4});
+      REQUIRE(odds == std::deque{1, 3});
+    }
+
+    THEN("a lazy range is iterated through once")
+    {
+      int calls = 0;
+      const auto squares = ezy::transform(numbers, [&calls](int i) { ++calls; return i * i; });
+      const auto [small, large] = ezy::partition_into(squares, [](int i) { return i < 10; });
+      REQUIRE(small == std::vector{0, 1, 4, 9});
+      REQUIRE(large.size() == 16);
+      REQUIRE(calls == 20);
+    }
+  }
+
+  GIVEN("a key function")
+  {
+    THEN("the elements are distributed into the buckets")
+    {
+      const auto buckets = ezy::bucketize(numbers, 3, [](int i) { return i % 3; });
+      REQUIRE(buckets.size() == 3);
+      REQUIRE(buckets[0] == std::vector{0, 3, 6, 9, 12, 15, 18});
+      REQUIRE(buckets[2] == std::vector{2, 5, 8, 11, 14, 17});
+    }
+
+    THEN("a key out of range is an error")
+    {
+      REQUIRE_THROWS_AS(ezy::bucketize(numbers, 3, [](int i) { return i; }), std::logic_error);
+      REQUIRE_THROWS_AS(ezy::bucketize(std::list<int>{1}, 3, [](int) { return -1; }), std::logic_error);
+    }
+
+    THEN("clamping skips the elements of keys out of range")
+    {
+      const auto buckets = ezy::bucketize(numbers, 2, [](int i) { return i / 5; }, ezy::bounds::clamping);
+      REQUIRE(buckets[0] == std::vector{0, 1, 2, 3, 4});
+      REQUIRE(buckets[1] == std::vector{5, 6, 7, 8, 9});
+      REQUIRE(ezy::bucketize(std::list<int>{1, 2}, 2, [](int i) { return i; }, ezy::bounds::clamping)[1] == std::vector{1});
+    }
+
+    THEN("checked gives back the error")
+    {
+      REQUIRE(ezy::bucketize(numbers, 3, [](int i) { return i; }, ezy::bounds::checked).error()
+          == ezy::bounds_error::key_out_of_range);
+      REQUIRE(ezy::bucketize(numbers, 3, [](int i) { return i % 3; }, ezy::bounds::checked).success()[1].size() == 7);
+    }
+
+    THEN("many buckets")
+    {
+      std::vector<int> many(5000);
+      std::iota(many.begin(), many.end(), 0);
+      const auto buckets = ezy::bucketize(many, 1000, [](int i) { return i % 1000; });
+      REQUIRE(buckets[999] == std::vector{999, 1999, 2999, 3999, 4999});
+    }
+  }
+
+  GIVEN("an rvalue container of move only elements")
+  {
+    std::vector<move_only> elements;
+    for (int i = 0; i < 5; ++i)
+      elements.emplace_back(i);
+
+    THEN("the elements are moved")
+    {
+      const auto buckets = ezy::bucketize(std::move(elements), 2, [](const move_only& m) { return m.i % 2; });
+      REQUIRE(buckets[0].size() == 3);
+      REQUIRE(buckets[1][1].i == 3);
+    }
+  }
+
+  GIVEN("an rvalue array of move only elements")
+  {
+    std::array<move_only, 3> elements{move_only{0}, move_only{1}, move_only{2}};
+
+    THEN("the elements are moved")
+    {
+      const auto buckets = ezy::bucketize(std::move(elements), 2, [](const move_only& m) { return m.i % 2; });
+      REQUIRE(buckets[0].size() == 2);
+      REQUIRE(buckets[1][0].i == 1);
+    }
+  }
+
+  GIVEN("a strong type with algo_iterable")
+  {
+    using Lines = ezy::strong_type<std::vector<std::string>, struct LinesTag, ezy::features::algo_iterable>;
+    const Lines lines{std::vector<std::string>{"a", "", "bb", ""}};
+
+    THEN("the eager versions are members")
+    {
+      const auto [empty, nonempty] = lines.partition_into([](const std::string& s) { return s.empty(); });
+      REQUIRE(empty.size() == 2);
+      REQUIRE(nonempty == std::vector<std::string>{"a", "bb"});
+
+      const auto by_size = lines.bucketize<std::list<std::string>>(3, [](const std::string& s) { return s.size(); });
+      REQUIRE(by_size[1] == std::list<std::string>{"a"});
+
+      const auto parallel = Lines{std::vector<std::string>{"a", "bb"}}.bucketize(four_threads, 3, [](const std::string& s) { return s.size(); });
+      REQUIRE(parallel[2] == std::vector<std::string>{"bb"});
+    }
+  }
+}
+
+SCENARIO("parallel partitioning")
+{
+  std::vector<int> numbers(100000);
+  std::iota(numbers.begin(), numbers.end(), 0);
+
+  GIVEN("a predicate")
+  {
+    THEN("the result is the same as the sequential one")
+    {
+      REQUIRE(ezy::partition_into(four_threads, numbers, is_even) == ezy::partition_into(numbers, is_even));
+
+      const auto odd_squares = ezy::transform(ezy::filter(numbers, [](int i) { return i % 2 == 1; }), [](int i) { return i % 1000; });
+      REQUIRE(ezy::partition_into(four_threads, odd_squares, [](int i) { return i < 500; })
+          == ezy::partition_into(odd_squares, [](int i) { return i < 500; }));
+    }
+  }
+
+  GIVEN("shards")
+  {
+    const auto shard = [](int i) { return static_cast<std::size_t>(i * 2654435761u % 64); };
+
+    THEN("every shard keeps the order of the elements")
+    {
+      std::atomic<int> calls{0};
+      const auto shards = ezy::bucketize(four_threads, numbers, 64, [&](int i) { ++calls; return shard(i); });
+      REQUIRE(shards == ezy::bucketize(numbers, 64, shard));
+      REQUIRE(calls == 100000);
+    }
+
+    THEN("a key out of range is an error")
+    {
+      REQUIRE_THROWS_AS(ezy::bucketize(four_threads, numbers, 64, [](int i) { return i; }), std::logic_error);
+      REQUIRE(ezy::bucketize(four_threads, numbers, 64, [](int i) { return i; }, ezy::bounds::checked).error()
+          == ezy::bounds_error::key_out_of_range);
+      REQUIRE(ezy::bucketize(four_threads, numbers, 64, [](int i) { return i; }, ezy::bounds::clamping)[63]
+          == std::vector{63});
+    }
+  }
+
+  GIVEN("a range which cannot be split")
+  {
+    const std::list<int> list{1, 2, 3};
+    REQUIRE(ezy::partition_into(four_threads, list, is_even).first == std::vector{2});
+  }
+}
@@ -0,0 +1,124 @@
+#include <catch.hpp>
+
+#include <ezy/quantity.h>
+#include <ezy/bulk.h>
+
+#include <vector>
+
+namespace
+{
+  using Length = ezy::quantity<double, ezy::si::length>;
+  using Area = ezy::quantity<double, ezy::si::area>;
+  using Time = ezy::quantity<double, ezy::si::time>;
+  using Frequency = ezy::quantity<double, ezy::si::frequency>;
+  using Velocity = ezy::quantity<double, ezy::si::velocity>;
+  using Acceleration = ezy::quantity<double, ezy::si::acceleration>;
+  using Mass = ezy::quantity<double, ezy::si::mass>;
+  using Force = ezy::quantity<double, ezy::si::force>;
+  using Energy = ezy::quantity<double, ezy::si::energy>;
+
+  template <typename L, typename R, typename = void>
+  struct is_addable : std::false_type {};
+
+  template <typename L, typename R>
+  struct is_addable<L, R, std::void_t<decltype(std::declval<L>() + std::declval<R>())>> : std::true_type {};
+}
+
+SCENARIO("dimension algebra")
+{
+  static_assert(std::is_same_v<ezy::dimension_product_t<ezy::dimension<1, 0>, ezy::dimension<1, -1>>, ezy::dimension<2, -1>>);
+  static_assert(std::is_same_v<ezy::dimension_quotient_t<ezy::dimension<1, 0>, ezy::dimension<0, 1>>, ezy::dimension<1, -1>>);
+  static_assert(std::is_same_v<ezy::dimension_inverse_t<ezy::dimension<1, -2>>, ezy::dimension<-1, 2>>);
+  static_assert(ezy::is_dimensionless_v<ezy::dimension<0, 0>>);
+  static_assert(!ezy::is_dimensionless_v<ezy::dimension<0, 1>>);
+  static_assert(std::is_same_v<ezy::si::force, ezy::dimension<1, 1, -2, 0, 0, 0, 0>>);
+}
+
+SCENARIO("quantity")
+{
+  static_assert(sizeof(Velocity) == sizeof(double));
+  static_assert(ezy::has_underlying_layout_v<Velocity>);
+
+  GIVEN("quantities of the same dimension")
+  {
+    constexpr Length a{3.0};
+    constexpr Length b{1.5};
+
+    THEN("they can be added, compared and scaled")
+    {
+      static_assert((a + b).get() == 4.5);
+      static_assert((a - b).get() == 1.5);
+      static_assert((-a).get() == -3.0);
+      static_assert(b < a && a > b && a >= a && b <= a);
+      static_assert(a != b && a == Length{3.0});
+      static_assert((a * 2.0).get() == 6.0);
+      static_assert((2.0 * a).get() == 6.0);
+      static_assert((a / 2.0).get() == 1.5);
+
+      Length c{a};
+      c += b;
+      c *= 2.0;
+      REQUIRE(c.get() == 9.0);
+    }
+
+    THEN("their quotient is dimensionless")
+    {
+      static_assert(std::is_same_v<decltype(a / b), double>);
+      REQUIRE(a / b == 2.0);
+    }
+  }
+
+  GIVEN("quantities of different dimensions")
+  {
+    constexpr Length distance{100.0};
+    constexpr Time time{20.0};
+    constexpr Mass mass{2.0};
+
+    static_assert(!is_addable<Length, Time>::value);
+    static_assert(!is_addable<Length, double>::value);
+
+    THEN("products and quotients have the resulting dimension")
+    {
+      constexpr auto velocity = distance / time;
+      static_assert(std::is_same_v<decltype(velocity), const Velocity>);
+      static_assert(velocity.get() == 5.0);
+
+      constexpr auto acceleration = velocity / time;
+      static_assert(std::is_same_v<decltype(acceleration), const Acceleration>);
+
+      constexpr auto force = mass * acceleration;
+      static_assert(std::is_same_v<decltype(force), const Force>);
+      static_assert(std::is_same_v<decltype(force * distance), Energy>);
+      static_assert(std::is_same_v<decltype(distance * distance), Area>);
+      static_assert(std::is_same_v<decltype(1.0 / time), Frequency>);
+      static_assert(std::is_same_v<decltype(velocity * time), Length>);
+
+      REQUIRE(force.get() == 0.5);
+      REQUIRE((1.0 / time).get() == 0.05);
+    }
+  }
+
+  GIVEN("a range of quantities")
+  {
+    const std::vector<Length> distances{Length{1.0}, Length{2.0}, Length{3.0}};
+    const std::vector<Time> times{Time{1.0}, Time{2.0}, Time{4.0}};
+
+    THEN("bulk operations apply")
+    {
+      REQUIRE(ezy::bulk::sum(distances) == Length{6.0});
+
+      std::vector<Length> doubled(3, Length{0.0});
+      ezy::bulk::axpy(2.0, distances, doubled);
+      REQUIRE(doubled[2] == Length{6.0});
+    }
+
+    THEN("velocities can be computed elementwise")
+    {
+      std::vector<Velocity> velocities;
+      for (size_t i = 0; i < distances.size(); ++i)
+        velocities.push_back(distances[i] / times[i]);
+
+      REQUIRE(velocities[2] == Velocity{0.75});
+    }
+  }
+}
@@ -0,0 +1,227 @@
+#include <catch.hpp>
+
+#include <ezy/algorithm>
+#include <ezy/static_vector.h>
+#include <ezy/small_vector.h>
+#include <ezy/strong_type>
+#include <ezy/result>
+
+#include <string>
+#include <vector>
+
+#include "common.h"
+
+SCENARIO("static_vector")
+{
+  using V = ezy::static_vector<std::string, 3>;
+
+  GIVEN("a static vector")
+  {
+    V v{"a", "b"};
+    REQUIRE(v.size() == 2);
+    REQUIRE(V::capacity() == 3);
+
+    WHEN("filled")
+    {
+      v.push_back("c");
+      THEN("it is full")
+      {
+        REQUIRE(v.full());
+        REQUIRE(v.back() == "c");
+        REQUIRE(!v.try_push_back("d"));
+        REQUIRE_THROWS_AS(v.push_back("d"), std::logic_error);
+        REQUIRE(v.size() == 3);
+      }
+    }
+
+    WHEN("inserted")
+    {
+      v.insert(v.begin(), "z");
+      THEN("the elements are shifted")
+      {
+        REQUIRE(v == V{"z", "a", "b"});
+      }
+    }
+
+    WHEN("copied and moved")
+    {
+      V copied = v;
+      V moved = std::move(copied);
+      copied = moved;
+      THEN("the elements are the same")
+      {
+        REQUIRE(moved == v);
+        REQUIRE(copied == v);
+      }
+    }
+
+    WHEN("an element is removed")
+    {
+      v.pop_back();
+      THEN("it is not there")
+      {
+        REQUIRE(v == V{"a"});
+      }
+    }
+  }
+
+  GIVEN("move only elements")
+  {
+    ezy::static_vector<move_only, 2> v;
+    v.emplace_back(1);
+    v.push_back(move_only{2});
+    auto moved = std::move(v);
+    REQUIRE(moved[1].i == 2);
+  }
+}
+
+SCENARIO("static_vector as a collect target")
+{
+  const std::vector<int> numbers{1, 2, 3, 4, 5, 6};
+  auto is_even = [](int i) { return i % 2 == 0; };
+
+  GIVEN("a range which fits")
+  {
+    const auto evens = ezy::collect<ezy::static_vector<int, 4>>(ezy::filter(numbers, is_even));
+    REQUIRE(evens == ezy::static_vector<int, 4>{2, 4, 6});
+
+    const auto tried = ezy::try_collect<ezy::static_vector<int, 3>>(ezy::filter(numbers, is_even));
+    REQUIRE(tried.has_value());
+    REQUIRE(tried.value().size() == 3);
+  }
+
+  GIVEN("a range which does not fit")
+  {
+    REQUIRE(!ezy::try_collect<ezy::static_vector<int, 2>>(ezy::filter(numbers, is_even)).has_value());
+    using Small = ezy::static_vector<int, 2>;
+    REQUIRE_THROWS_AS(ezy::collect<Small>(numbers), std::logic_error);
+  }
+
+  GIVEN("an iterable strong type")
+  {
+    using Numbers = ezy::strong_type<std::vector<int>, struct NumbersTag, ezy::features::iterable>;
+    const Numbers strong_numbers{1, 2, 3};
+    const auto collected = strong_numbers.map([](int i) { return i * 10; }).to<ezy::static_vector<int, 3>>();
+    REQUIRE(collected == ezy::static_vector<int, 3>{10, 20, 30});
+  }
+
+  GIVEN("a strong type of static_vector")
+  {
+    using Numbers = ezy::strong_type<ezy::static_vector<int, 4>, struct NumbersTag, ezy::features::iterable>;
+    const Numbers strong_numbers{ezy::static_vector<int, 4>{1, 2, 3}};
+    REQUIRE(strong_numbers.map([](int i) { return i + 1; }).to<std::vector<int>>() == std::vector{2, 3, 4});
+  }
+
+  GIVEN("results")
+  {
+    using R = ezy::result<int, std::string>;
+    const std::vector<R> results{R{1}, R{2}};
+    REQUIRE(ezy::collect_results<ezy::static_vector<int, 2>>(results).success() == ezy::static_vector<int, 2>{1, 2});
+  }
+}
+
+SCENARIO("small_vector")
+{
+  counting_resource resource;
+  using V = ezy::small_vector<int, 4, std::pmr::polymorphic_allocator<int>>;
+
+  GIVEN("a small vector within its inline capacity")
+  {
+    V v{{1, 2, 3}, &resource};
+    v.push_back(4);
+    THEN("nothing is allocated")
+    {
+      REQUIRE(v.is_inline());
+      REQUIRE(v.capacity() == 4);
+      REQUIRE(resource.allocations == 0);
+    }
+
+    WHEN("it grows over it")
+    {
+      v.push_back(5);
+      THEN("the elements are moved to the heap")
+      {
+        REQUIRE(!v.is_inline());
+        REQUIRE(resource.allocations == 1);
+        REQUIRE(v == V{{1, 2, 3, 4, 5}, &resource});
+      }
+
+      WHEN("moved")
+      {
+        V moved = std::move(v);
+        THEN("the heap buffer is moved")
+        {
+          REQUIRE(resource.allocations == 1);
+          REQUIRE(moved.size() == 5);
+          REQUIRE(v.empty());
+          REQUIRE(v.is_inline());
+        }
+      }
+    }
+  }
+
+  GIVEN("move only elements")
+  {
+    ezy::small_vector<move_only, 1> v;
+    v.emplace_back(1);
+    v.emplace_back(2);
+    v.insert(v.begin(), move_only{0});
+    REQUIRE(v.size() == 3);
+    REQUIRE(v[0].i == 0);
+    REQUIRE(v[2].i == 2);
+
+    auto moved = std::move(v);
+    REQUIRE(moved[1].i == 1);
+  }
+
+  GIVEN("copies")
+  {
+    ezy::small_vector<std::string, 2> v{"a", "b", "c"};
+    auto copied = v;
+    REQUIRE(copied == v);
+
+    ezy::small_vector<std::string, 2> assigned{"x"};
+    assigned = v;
+    REQUIRE(assigned == v);
+
+    ezy::small_vector<std::string, 2> small{"y"};
+    assigned = std::move(small);
+    REQUIRE(assigned == ezy::small_vector<std::string, 2>{"y"});
+  }
+
+  GIVEN("a full small vector")
+  {
+    const std::string first(40, 'a');
+    const std::string second(40, 'b');
+
+    THEN("an element of it can be pushed back")
+    {
+      ezy::small_vector<std::string, 2> v{first, second};
+      v.push_back(v[0]);
+      REQUIRE(v == ezy::small_vector<std::string, 2>{first, second, first});
+    }
+
+    THEN("an element of it can be emplaced")
+    {
+      ezy::small_vector<std::string, 2> v{first, second};
+      v.emplace(v.begin(), v[1]);
+      REQUIRE(v == ezy::small_vector<std::string, 2>{second, first, second});
+    }
+  }
+}
+
+SCENARIO("small_vector as a collect target")
+{
+  counting_resource resource;
+  std::pmr::set_default_resource(&resource);
+
+  const std::vector<int> numbers{1, 2, 3, 4, 5, 6};
+  const auto collected = ezy::collect<ezy::small_vector<int, 8, std::pmr::polymorphic_allocator<int>>>(
+      ezy::transform(numbers, [](int i) { return i * i; }));
+
+  std::pmr::set_default_resource(nullptr);
+
+  REQUIRE(collected.size() == 6);
+  REQUIRE(collected.is_inline());
+  REQUIRE(resource.allocations == 0);
+}
@@ -0,0 +1,226 @@
+#include <catch.hpp>
+
+#include <ezy/algorithm>
+#include <ezy/parallel.h>
+#include <ezy/strong_type>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "common.h"
+
+namespace
+{
+  constexpr ezy::par_unseq_dynamic_t four_threads{4, 0};
+
+  std::vector<int> random_numbers(std::size_t size, int min, int max)
+  {
+    std::mt19937 engine(42);
+    std::uniform_int_distribution<int> distribution(min, max);
+    std::vector<int> numbers(size);
+    for (int& n : numbers)
+      n = distribution(engine);
+    return numbers;
+  }
+
+  template <typename T>
+  std::vector<T> std_sorted(std::vector<T> elements)
+  {
+    std::sort(elements.begin(), elements.end());
+    return elements;
+  }
+
+  enum class priority : std::int8_t { low = -1, normal = 0, high = 1 };
+
+  using Id = ezy::strong_type<std::int64_t, struct IdTag>;
+
+  struct record
+  {
+    Id id;
+    int position;
+  };
+}
+
+SCENARIO("sorting terminals")
+{
+  GIVEN("integers")
+  {
+    const auto small = random_numbers(100, -1000, 1000);
+    const auto large = random_numbers(5000, -1000000, 1000000);
+
+    THEN("they are sorted (by std::sort or radix sort)")
+    {
+      REQUIRE(ezy::sorted(small) == std_sorted(small));
+      REQUIRE(ezy::sorted(large) == std_sorted(large));
+      REQUIRE(ezy::stable_sorted(large) == std_sorted(large));
+    }
+
+    THEN("the order can be given")
+    {
+      auto descending = std_sorted(large);
+      std::reverse(descending.begin(), descending.end());
+      REQUIRE(ezy::sorted(large, std::greater<>{}) == descending);
+    }
+
+    THEN("the extremes are sorted too")
+    {
+      const std::vector<std::int64_t> extremes{INT64_MAX, 0, INT64_MIN, -1, 1};
+      REQUIRE(ezy::sorted(extremes) == std::vector<std::int64_t>{INT64_MIN, -1, 0, 1, INT64_MAX});
+    }
+  }
+
+  GIVEN("a pipeline")
+  {
+    const std::vector<int> numbers{5, -3, 8, 1};
+    REQUIRE(ezy::sorted(ezy::transform(numbers, [](int i) { return i * 2; })) == std::vector{-6, 2, 10, 16});
+    REQUIRE(ezy::sorted(ezy::filter(numbers, [](int i) { return i > 0; })) == std::vector{1, 5, 8});
+  }
+
+  GIVEN("an rvalue vector of move only elements")
+  {
+    std::vector<move_only> elements;
+    for (int i : {3, 1, 2})
+      elements.emplace_back(i);
+
+    THEN("it is sorted in place")
+    {
+      const auto result = ezy::sorted(std::move(elements), [](const move_only& lhs, const move_only& rhs) { return lhs.i < rhs.i; });
+      REQUIRE(result.size() == 3);
+      REQUIRE(result[0].i == 1);
+      REQUIRE(result[2].i == 3);
+    }
+  }
+
+  GIVEN("elements with equal keys")
+  {
+    std::vector<std::pair<int, char>> pairs;
+    for (std::size_t i = 0; i < 1000; ++i)
+      pairs.emplace_back(static_cast<int>(i % 7), static_cast<char>('a' + i % 26));
+
+    THEN("stable_sorted keeps their order")
+    {
+      auto expected = pairs;
+      std::stable_sort(expected.begin(), expected.end(), [](const auto& lhs, const auto& rhs) { return lhs.first < rhs.first; });
+      REQUIRE(ezy::stable_sorted(pairs, [](const auto& lhs, const auto& rhs) { return lhs.first < rhs.first; }) == expected);
+    }
+
+    THEN("sorted_by keeps their order, and computes every key once")
+    {
+      int calls = 0;
+      const auto by_first = ezy::sorted_by(pairs, [&calls](const auto& p) { ++calls; return p.first; });
+
+      auto expected = pairs;
+      std::stable_sort(expected.begin(), expected.end(), [](const auto& lhs, const auto& rhs) { return lhs.first < rhs.first; });
+      REQUIRE(by_first == expected);
+      REQUIRE(calls == 1000);
+    }
+  }
+
+  GIVEN("keys which are not integral")
+  {
+    const std::vector<std::string> words{"ccc", "a", "bb", "dd"};
+    REQUIRE(ezy::sorted_by(words, [](const std::string& s) { return s.size(); }) == std::vector<std::string>{"a", "bb", "dd", "ccc"});
+    REQUIRE(ezy::sorted_by(words, [](const std::string& s) { return s; }, std::greater<>{}) == std::vector<std::string>{"dd", "ccc", "bb", "a"});
+  }
+
+  GIVEN("strong typed and enum keys")
+  {
+    std::vector<record> records;
+    for (int i = 0; i < 1000; ++i)
+      records.push_back({Id{(i * 7919) % 1000 - 500}, i});
+
+    THEN("they are sorted by the underlying value")
+    {
+      const auto by_id = ezy::sorted_by(records, [](const record& r) { return r.id; });
+      REQUIRE(by_id.front().id.get() == -500);
+      REQUIRE(std::is_sorted(by_id.begin(), by_id.end(), [](const record& lhs, const record& rhs) { return lhs.id.get() < rhs.id.get(); }));
+    }
+
+    THEN("enums are sorted by the underlying value")
+    {
+      const std::vector<priority> priorities{priority::high, priority::low, priority::normal};
+      REQUIRE(ezy::sorted(priorities) == std::vector{priority::low, priority::normal, priority::high});
+    }
+  }
+
+  GIVEN("a strong type with algo_iterable")
+  {
+    using Numbers = ezy::strong_type<std::vector<int>, struct NumbersTag, ezy::features::algo_iterable>;
+    const Numbers numbers{std::vector{3, -1, 2}};
+
+    THEN("the terminals are members")
+    {
+      REQUIRE(numbers.sorted() == std::vector{-1, 2, 3});
+      REQUIRE(numbers.stable_sorted(std::greater<>{}) == std::vector{3, 2, -1});
+      REQUIRE(numbers.map([](int i) { return i * i; }).sorted() == std::vector{1, 4, 9});
+      REQUIRE(numbers.sorted_by([](int i) { return -i; }) == std::vector{3, 2, -1});
+      REQUIRE(Numbers{std::vector{2, 1}}.sorted() == std::vector{1, 2});
+    }
+
+    THEN("they can sort in parallel")
+    {
+      REQUIRE(numbers.sorted(four_threads) == std::vector{-1, 2, 3});
+      REQUIRE(numbers.sorted_by(four_threads, [](int i) { return -i; }) == std::vector{3, 2, -1});
+    }
+  }
+}
+
+SCENARIO("parallel sorting")
+{
+  const auto numbers = random_numbers(200000, -1000000000, 1000000000);
+
+  GIVEN("integers")
+  {
+    THEN("they are sorted by parallel radix sort")
+    {
+      REQUIRE(ezy::sorted(four_threads, numbers) == std_sorted(numbers));
+      REQUIRE(ezy::sorted(four_threads, ezy::transform(numbers, [](int i) { return i / 3; }))
+          == ezy::sorted(ezy::transform(numbers, [](int i) { return i / 3; })));
+    }
+
+    THEN("they are sorted by parallel merge sort with a comparator")
+    {
+      auto descending = std_sorted(numbers);
+      std::reverse(descending.begin(), descending.end());
+      REQUIRE(ezy::sorted(four_threads, numbers, std::greater<>{}) == descending);
+    }
+  }
+
+  GIVEN("elements with equal keys")
+  {
+    std::vector<std::pair<int, int>> pairs;
+    for (std::size_t i = 0; i < numbers.size(); ++i)
+      pairs.emplace_back(numbers[i] % 100, static_cast<int>(i));
+
+    const auto by_first = [](const auto& lhs, const auto& rhs) { return lhs.first < rhs.first; };
+    auto expected = pairs;
+    std::stable_sort(expected.begin(), expected.end(), by_first);
+
+    THEN("the merge sort is stable")
+    {
+      REQUIRE(ezy::stable_sorted(four_threads, pairs, by_first) == expected);
+    }
+
+    THEN("sorted_by is stable, with radix sort and merge sort")
+    {
+      std::atomic<int> calls{0};
+      REQUIRE(ezy::sorted_by(four_threads, pairs, [&calls](const auto& p) { ++calls; return p.first; }) == expected);
+      REQUIRE(calls == static_cast<int>(pairs.size()));
+
+      REQUIRE(ezy::sorted_by(four_threads, pairs, [](const auto& p) { return std::to_string(p.first).size(); })
+          == ezy::sorted_by(pairs, [](const auto& p) { return std::to_string(p.first).size(); }));
+    }
+  }
+
+  GIVEN("a small range")
+  {
+    REQUIRE(ezy::sorted(four_threads, std::vector{3, 1, 2}) == std::vector{1, 2, 3});
+    REQUIRE(ezy::sorted(four_threads, std::vector<int>{}).empty());
+  }
+}
@@ -65,6 +65,8 @@ SCENARIO("compilation tests")
   static_assert(ezy::has_feature_v<ComposedFeature, ezy::features::equal_comparable> == false);
   static_assert(ezy::has_feature_v<ComposedFeature, ezy::features::addable> == true);
   static_assert(ezy::has_feature_v<ComposedFeature, ezy::features::additive> == true);
+  // listed features are found without impersonalizing them
+  static_assert(ezy::has_feature_v<ezy::strong_type<int, struct Tag, ezy::features::multipliable>, ezy::features::multipliable> == true);
 
   static_assert(std::is_same_v<ezy::rebind_features_t<Simple>, Simple>);
   static_assert(std::is_same_v<ezy::rebind_features_t<OneFeature>, Simple>);
@@ -140,6 +140,7 @@ SCENARIO("tuple_traits")
     static_assert(std::is_same_v<ett::subtract_t<types<int>, types<>>, types<int>>);
     static_assert(std::is_same_v<ett::subtract_t<types<int>, types<int>>, types<>>);
     static_assert(std::is_same_v<ett::subtract_t<types<>, types<int>>, types<>>);
+    static_assert(std::is_same_v<ett::subtract_t<types<int, bool, int, char>, types<char, int>>, types<bool>>);
   }
 
   GIVEN("map")
@@ -0,0 +1,61 @@
+#include <catch.hpp>
+
+#include <ezy/algorithm>
+#include <ezy/view_layout.h>
+
+#include <vector>
+
+namespace
+{
+  constexpr std::size_t word = sizeof(void*);
+
+  struct is_even
+  {
+    bool operator()(int i) const { return i % 2 == 0; }
+  };
+
+  struct add
+  {
+    int operator()(int i) const { return i + n; }
+    int n;
+  };
+}
+
+SCENARIO("view layout")
+{
+  const std::vector<int> v{1, 2, 3, 4, 5, 6};
+
+  GIVEN("a range")
+  {
+    using layouts = ezy::view_layouts_t<decltype(v)>;
+    static_assert(std::is_same_v<layouts, ezy::typelist<ezy::view_layout<std::vector<int>>>>);
+    static_assert(ezy::max_iterator_size_v<decltype(v)> == word);
+  }
+
+  GIVEN("a pipeline")
+  {
+    const auto pipeline = ezy::filter(ezy::transform(ezy::filter(v, is_even{}), add{2}), is_even{});
+    using layouts = ezy::view_layouts_t<decltype(pipeline)>;
+
+    static_assert(std::is_same_v<ezy::tuple_traits::head_t<layouts>::view_type, std::remove_const_t<decltype(pipeline)>>);
+    static_assert(std::is_same_v<ezy::tuple_traits::rebind_t<layouts, std::tuple>, std::tuple<
+        ezy::view_layout<std::remove_const_t<decltype(pipeline)>>,
+        ezy::view_layout<ezy::detail::range_view<
+          ezy::experimental::owner<ezy::detail::range_view_filter<ezy::experimental::reference_to<const std::vector<int>>, is_even>>,
+          add
+        >>,
+        ezy::view_layout<ezy::detail::range_view_filter<ezy::experimental::reference_to<const std::vector<int>>, is_even>>,
+        ezy::view_layout<std::vector<int>>
+      >>);
+
+    THEN("iterators refer to the function objects and the ranges of their views")
+    {
+      // filter: underlying iterator and range reference
+      static_assert(ezy::view_layout<decltype(ezy::filter(v, is_even{}))>::iterator_size == 2 * word);
+      // transform: underlying iterator and function object reference
+      static_assert(ezy::view_layout<decltype(ezy::transform(v, add{3}))>::iterator_size == 2 * word);
+      static_assert(ezy::max_iterator_size_v<decltype(pipeline)> == 4 * word);
+      REQUIRE(ezy::collect<std::vector<int>>(pipeline) == std::vector{4, 6, 8});
+    }
+  }
+}